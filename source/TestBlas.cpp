@@ -12,6 +12,15 @@
 #include "swap.h"
 #include "matrix.h"
 #include "gemv.h"
+#include "rot.h"
+#include "lasr.h"
+#include "dot.h"
+#include "nrm2.h"
+#include "iamax.h"
+#include "simd.h"
+#include "random.h"
+#include "gemm.h"
+#include <random>
 
 using namespace NUMCPP;
 using namespace LCPP;
@@ -91,4 +100,404 @@ void TestBlas::test2(int m, int n, int q) {
     std::cout << int_ms.count() << std::endl <<Z<<std::endl<< A << std::endl << X << std::endl << y << std::endl;
 
 
-}
\ No newline at end of file
+}
+
+void TestBlas::testLASR(int m, int n, int k) {
+    // k sequences of random rotations
+    Matrix<double> A(m, n), R(std::max(m, n), k);
+    A.rand();
+    R.rand();
+    Matrix<double> C(std::max(m, n), k, [&](int r, int c) {return std::cos(6.28 * R(r, c)); });
+    Matrix<double> S(std::max(m, n), k, [&](int r, int c) {return std::sin(6.28 * R(r, c)); });
+    LASR<double> lasr;
+    ROT<double> rot;
+    for (Side side : { Side::Right, Side::Left }) {
+        for (Direction direct : { Direction::Forward, Direction::Backward }) {
+            Matrix<double> B = A, B2 = A;
+            int nr = (side == Side::Right ? n : m) - 1;
+            const auto start = std::chrono::steady_clock::now();
+            lasr(side, direct, C.all(), S.all(), B.all());
+            const auto end = std::chrono::steady_clock::now();
+            // one rotation at a time (Sequence overload of ROT: columns, or rows with stride m)
+            for (int l = 0; l < k; ++l) {
+                for (int i = 0; i < nr; ++i) {
+                    int j = direct == Direction::Forward ? i : nr - 1 - i;
+                    if (side == Side::Right)
+                        rot(B2.column(j), B2.column(j + 1), C(j, l), S(j, l));
+                    else
+                        rot(B2.row(j), B2.row(j + 1), C(j, l), S(j, l));
+                }
+            }
+            const auto end2 = std::chrono::steady_clock::now();
+            double d = 0;
+            for (int c = 0; c < n; ++c)
+                for (int r = 0; r < m; ++r)
+                    d = std::max(d, std::abs(B(r, c) - B2(r, c)));
+            std::cout << "LASR(" << (side == Side::Right ? "right" : "left") << ", " << (direct == Direction::Forward ? "forward" : "backward")
+                << "): time=" << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()
+                << " (ROT: " << std::chrono::duration_cast<std::chrono::milliseconds>(end2 - end).count() << ") max diff = " << d << std::endl;
+        }
+    }
+}
+
+void TestBlas::testSIMD(int n, int q) {
+    DataBlock<double> X(n), Y(n);
+    X.rand();
+    Y.rand();
+    Sequence<double> x = X.all(), y = Y.all();
+    x.add(-0.5);
+    DataBlock<double> Z = Y;
+    Sequence<double> z = Z.all();
+    AXPY<double> axpy;
+    DOT<double, double> ddot;
+    const char* names[] = { "scalar", "AVX2", "AVX-512" };
+    for (SIMD::ISA isa : { SIMD::ISA::Scalar, SIMD::ISA::AVX2, SIMD::ISA::AVX512 }) {
+        if (SIMD::select(isa) != isa)
+            break;
+        // ragged lengths check the tails, against plain loops
+        double err = 0;
+        for (int k = n - 33; k <= n; ++k) {
+            Sequence<double> xk = x.left(k), yk = y.left(k);
+            double d = 0, s = 0, ss = 0, as = 0;
+            for (int i = 0; i < k; ++i) {
+                d += xk(i) * yk(i);
+                s += xk(i);
+                ss += xk(i) * xk(i);
+                as += std::abs(xk(i));
+            }
+            err = std::max(err, std::abs(xk.dot(yk) - d) + std::abs(ddot(xk, yk) - d) + std::abs(xk.sum() - s)
+                + std::abs(xk.ssq() - ss) + std::abs(xk.asum() - as));
+        }
+        z.copy(y);
+        z.addAY(1.5, x);
+        axpy(-1.5, x, z);
+        z.mul(3);
+        z.div(3);
+        for (int i = 0; i < n; ++i)
+            err = std::max(err, std::abs(z(i) - y(i)));
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < q; ++i) {
+            x.dot(y);
+            x.sum();
+            x.ssq();
+        }
+        const auto end = std::chrono::steady_clock::now();
+        for (int i = 0; i < q; ++i) {
+            z.addAY(1e-3, x);
+            z.mul(0.999);
+        }
+        const auto end2 = std::chrono::steady_clock::now();
+        std::cout << names[(int)isa] << ": reductions=" << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()
+            << " ms, updates=" << std::chrono::duration_cast<std::chrono::milliseconds>(end2 - end).count()
+            << " ms, error=" << err << std::endl;
+    }
+    SIMD::select(SIMD::supported());
+}
+
+void TestBlas::testNRM2(int n, int q) {
+    DataBlock<double> X(n);
+    X.rand();
+    Sequence<double> x = X.all();
+    x.add(-0.5);
+    NRM2<double, double> nrm2;
+    // scaled copies of x: medium, tiny (underflow of the squares), huge (overflow of the squares), mixed
+    double scales[] = { 1, 1e-160, 1e-300, 1e160, 1e300 };
+    double err = 0;
+    for (double scale : scales) {
+        for (int inc : { 1, 3 }) {
+            int m = n / inc;
+            std::vector<double> tmp(n);
+            Sequence<double> y(tmp.data(), m, inc);
+            long double ref = 0;
+            for (int i = 0; i < m; ++i) {
+                y(i) = x(i) * scale;
+                ref += (long double)x(i) * x(i);
+            }
+            if (scale != 1)
+                y(0) = 1;
+            double r = nrm2(y), e = std::sqrt((double)ref) * scale;
+            if (scale != 1)
+                e = std::sqrt(1 + (double)(ref - (long double)x(0) * x(0)) * scale * scale);
+            err = std::max(err, std::abs(r - e) / e);
+            if (scale != 1) {
+                y(0) = x(0) * scale;
+                r = nrm2(y);
+                e = std::sqrt((double)ref) * scale;
+                err = std::max(err, std::abs(r - e) / e);
+            }
+        }
+    }
+    const auto start = std::chrono::steady_clock::now();
+    double s = 0;
+    for (int i = 0; i < q; ++i)
+        s += nrm2(x);
+    const auto end = std::chrono::steady_clock::now();
+    std::cout << "NRM2: time=" << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()
+        << " max rel error = " << err << " (" << s / q << ")" << std::endl;
+}
+
+void TestBlas::testExpressions(int n, int q) {
+    DataBlock<double> X(n), Y(n), Z(n);
+    X.rand();
+    Y.rand();
+    Z.rand();
+    Sequence<double> x = X.all(), y = Y.all(), z = Z.all();
+    double a = 1.5, b = 0.75;
+    // reference, with one loop per operation
+    DataBlock<double> R = Y;
+    Sequence<double> r = R.all();
+    r.mul(b);
+    r.addAY(a, x);
+    r.addAY(-1, z);
+    double err = 0;
+    DataBlock<double> W = Y;
+    Sequence<double> w = W.all();
+    w = a * x + b * w - z;
+    for (int i = 0; i < n; ++i)
+        err = std::max(err, std::abs(w(i) - r(i)));
+    // strided operands (every other item of x and z, reversed)
+    Sequence<double> x2(X.all().start(), n / 2, 2), z2(Z.all().start() + 2 * (n / 2) - 2, n / 2, -2);
+    Sequence<double> w2 = w.left(n / 2);
+    w2 = x2 * z2 / 2.0 - (-x2);
+    for (int i = 0; i < n / 2; ++i)
+        err = std::max(err, std::abs(w2(i) - (x2(i) * z2(i) / 2 + x2(i))));
+    w2 += 1.0 + x2;
+    w2 -= 1.0 + x2;
+    for (int i = 0; i < n / 2; ++i)
+        err = std::max(err, std::abs(w2(i) - (x2(i) * z2(i) / 2 + x2(i))));
+    double ssq = 0;
+    for (int i = 0; i < n; ++i)
+        ssq += (x(i) - y(i)) * (x(i) - y(i));
+    err = std::max(err, std::abs((x - y).ssq() - ssq) / ssq);
+    err = std::max(err, std::abs((x * y).sum() - x.dot(y)) / std::abs(x.dot(y)));
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < q; ++i) {
+        w.mul(b);
+        w.addAY(a, x);
+        w.addAY(-1, z);
+        w.addAY(-1, x);
+    }
+    const auto end = std::chrono::steady_clock::now();
+    for (int i = 0; i < q; ++i)
+        w = b * w + a * x - z - x;
+    const auto end2 = std::chrono::steady_clock::now();
+    std::cout << "expressions: fused=" << std::chrono::duration_cast<std::chrono::milliseconds>(end2 - end).count()
+        << " ms (separate passes: " << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()
+        << " ms) max error = " << err << std::endl;
+}
+
+void TestBlas::testParallelReductions(int n) {
+    DataBlock<double> X(n), Y(n);
+    X.rand();
+    Y.rand();
+    Sequence<double> x = X.all(), y = Y.all();
+    x.add(-0.5);
+    const auto start = std::chrono::steady_clock::now();
+    double s = x.sum(), as = x.asum(), ss = x.ssq(), d = x.dot(y);
+    const auto end = std::chrono::steady_clock::now();
+    std::cout << "serial: time=" << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()
+        << " sum=" << s << " asum=" << as << " ssq=" << ss << " dot=" << d << std::endl;
+    double ref[5];
+    for (int nthreads : { 1, 2, 3, 4, 8, 0 }) {
+        const auto pstart = std::chrono::steady_clock::now();
+        double cur[5] = { x.parallelSum(nthreads), x.parallelAsum(nthreads), x.parallelSsq(nthreads), x.parallelDot(y, nthreads),
+            x.parallelAccumulate([](double s, double c) {return std::max(s, c); }, [](double a, double b) {return std::max(a, b); }, nthreads) };
+        const auto pend = std::chrono::steady_clock::now();
+        if (nthreads == 1)
+            std::copy(cur, cur + 5, ref);
+        // bit-identical results are expected
+        bool same = std::equal(cur, cur + 5, ref);
+        std::cout << "parallel (" << nthreads << " threads): time=" << std::chrono::duration_cast<std::chrono::milliseconds>(pend - pstart).count()
+            << (same ? " identical" : " DIFFERENT") << " rel. error (sum) = " << std::abs(cur[0] - s) / as << " max = " << cur[4] << std::endl;
+    }
+}
+
+void TestBlas::testIAMAX(int n, int q) {
+    DataBlock<double> X(n);
+    X.rand();
+    Sequence<double> x = X.all();
+    x.add(-0.5);
+    // ties (first index expected) and a NaN
+    x(n / 3) = 2;
+    x(n / 2) = -2;
+    x(2 * n / 3) = -2;
+    x(n / 4) = std::nan("");
+    IAMAX<double> iamax;
+    const char* names[] = { "scalar", "AVX2", "AVX-512" };
+    for (SIMD::ISA isa : { SIMD::ISA::Scalar, SIMD::ISA::AVX2, SIMD::ISA::AVX512 }) {
+        if (SIMD::select(isa) != isa)
+            break;
+        int nerr = 0;
+        for (int inc : { 1, 2 }) {
+            for (int k = 1; k <= n / inc; k += 1 + k / 8) {
+                Sequence<double> xk(x.start(), k, inc);
+                int ia = 0, imax = 0, imin = 0;
+                for (int i = 1; i < k; ++i) {
+                    if (std::abs(xk(i)) > std::abs(xk(ia)))
+                        ia = i;
+                    if (xk(i) > xk(imax))
+                        imax = i;
+                    if (xk(i) < xk(imin))
+                        imin = i;
+                }
+                if (xk.iamax() != ia || iamax(xk) != ia || iamax(k, xk.start(), inc) != ia || xk.imax() != imax || xk.imin() != imin)
+                    ++nerr;
+            }
+        }
+        const auto start = std::chrono::steady_clock::now();
+        int s = 0;
+        for (int i = 0; i < q; ++i)
+            s += iamax(x.drop(i % 8, 0));
+        const auto end = std::chrono::steady_clock::now();
+        std::cout << names[(int)isa] << ": IAMAX time=" << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()
+            << " ms, errors=" << nerr << " (" << s / q << ")" << std::endl;
+    }
+    SIMD::select(SIMD::supported());
+}
+
+void TestBlas::testContiguous(int n, int q) {
+    // short vectors (below SIMD::MIN_LENGTH): the gain comes only from the static increment
+    std::vector<double> x(n), y(n), z(n);
+    for (int i = 0; i < n; ++i) {
+        x[i] = (double)(i % 7) - 3;
+        y[i] = (double)(i % 5) + 1;
+    }
+    ContiguousSequence<double> cx(x.data(), n);
+    Sequence<double> sx(x.data(), n), sy(y.data(), n);
+    std::copy(y.begin(), y.end(), z.begin());
+    ContiguousSequence<double> cz(z.data(), n);
+    double d = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < q; ++i) {
+        sy.addAY(1e-3, sx);
+        sy.mul(0.999);
+        d += sy.dot(sx);
+    }
+    const auto end = std::chrono::steady_clock::now();
+    double dc = 0;
+    for (int i = 0; i < q; ++i) {
+        cz.addAY(1e-3, cx);
+        cz.mul(0.999);
+        dc += cz.dot(cx);
+    }
+    const auto end2 = std::chrono::steady_clock::now();
+    double err = 0;
+    for (int i = 0; i < n; ++i)
+        err = std::max(err, std::abs(z[i] - y[i]));
+    std::cout << "contiguous: time=" << std::chrono::duration_cast<std::chrono::milliseconds>(end2 - end).count()
+        << " ms (strided: " << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()
+        << " ms) max diff = " << err << " dot diff = " << std::abs(d - dc) << std::endl;
+    // views of a contiguous sequence
+    Matrix<double> A(n, 3);
+    A.rand();
+    ContiguousSequence<double> c = A.column(1);
+    Sequence<double> s = A.column(1);
+    bool ok = c.drop(1, 2).sum() == s.drop(1, 2).sum() && c.extract(2, n / 2).ssq() == s.extract(2, n / 2).ssq()
+        && c.left(3).increment() == 1 && c(n - 1) == s(n - 1);
+    c = c + 2.0 * A.column(0);
+    std::cout << "contiguous views: " << (ok ? "OK" : "FAILED") << std::endl;
+}
+
+void TestBlas::testRandom(int n) {
+    // known answers of Philox4x32-10 (Random123)
+    uint32_t c0[4] = { 0, 0, 0, 0 }, c1[4] = { 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff }, r0[4], r1[4];
+    Random::block(c0, 0, r0);
+    Random::block(c1, 0xffffffffffffffffull, r1);
+    bool kat = r0[0] == 0x6627e8d5 && r0[1] == 0xe169c58d && r0[2] == 0xbc57ac4c && r0[3] == 0x9b00dbd8
+        && r1[0] == 0x408f276d && r1[1] == 0x41c83b0e && r1[2] == 0xa20bc7c6 && r1[3] == 0x6d5451fd;
+    std::cout << "Philox4x32-10 known answers: " << (kat ? "OK" : "FAILED") << std::endl;
+
+    DataBlock<double> X(n), Y(n);
+    Sequence<double> x = X.all(), y = Y.all();
+    Random rng(12345, 7);
+    for (int normal = 0; normal < 2; ++normal) {
+        const auto start = std::chrono::steady_clock::now();
+        if (normal)
+            rng.normal(x, 0, 1, 1);
+        else
+            rng.uniform(x, 0, 1, 1);
+        const auto end = std::chrono::steady_clock::now();
+        // same output for any number of threads, and for a strided target
+        bool same = true;
+        for (int nthreads : { 2, 3, 8, 0 }) {
+            if (normal)
+                rng.normal(y, 0, 1, nthreads);
+            else
+                rng.uniform(y, 0, 1, nthreads);
+            for (int i = 0; i < n; ++i)
+                same = same && x(i) == y(i);
+        }
+        Sequence<double> ys(Y.all().start(), n / 2, 2);
+        if (normal)
+            rng.normal(ys);
+        else
+            rng.uniform(ys);
+        for (int i = 0; i < n / 2; ++i)
+            same = same && x(i) == ys(i);
+        double mean = x.sum() / n, var = x.ssq() / n - mean * mean;
+        std::cout << (normal ? "normal" : "uniform") << ": time=" << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()
+            << " ms (1 thread) " << (same ? "identical" : "DIFFERENT") << " mean=" << mean << " var=" << var << std::endl;
+    }
+    std::mt19937 mt(12345);
+    std::uniform_real_distribution<double> dist(0, 1);
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; ++i)
+        x(i) = dist(mt);
+    const auto end = std::chrono::steady_clock::now();
+    std::cout << "mt19937: time=" << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << " ms" << std::endl;
+}
+
+void TestBlas::testBlockedGEMM(int m, int n, int k) {
+    // leading dimensions larger than the matrices; the last row of C must not be modified
+    int da = std::max(m, k) + 3, db = std::max(k, n) + 2;
+    Matrix<double> A(da, da), B(db, db), C(m + 1, n), R(m, n);
+    A.rand();
+    B.rand();
+    GEMM<double> gemm;
+    const char* names[] = { "scalar", "AVX2", "AVX-512" };
+    for (SIMD::ISA isa : { SIMD::ISA::Scalar, SIMD::ISA::AVX2, SIMD::ISA::AVX512 }) {
+        if (SIMD::select(isa) != isa)
+            break;
+        double err = 0;
+        for (int t = 0; t < 4; ++t) {
+            bool ta = (t & 1) != 0, tb = (t & 2) != 0;
+            FastMatrix<double> a = ta ? A.extract(0, k, 0, m) : A.extract(0, m, 0, k);
+            FastMatrix<double> b = tb ? B.extract(0, n, 0, k) : B.extract(0, k, 0, n);
+            FastMatrix<double> c = C.extract(0, m, 0, n);
+            // beta = 0: C is not read (NaN)
+            C.all().set(std::nan(""));
+            double beta = t == 3 ? 0 : -0.5;
+            for (int j = 0; j < n; ++j) {
+                for (int i = 0; i < m; ++i) {
+                    double s = 0;
+                    for (int l = 0; l < k; ++l)
+                        s += (ta ? a(l, i) : a(i, l)) * (tb ? b(j, l) : b(l, j));
+                    R(i, j) = 1.5 * s;
+                    if (beta != 0) {
+                        c(i, j) = i - j;
+                        R(i, j) += beta * (i - j);
+                    }
+                }
+            }
+            gemm(ta, tb, 1.5, a, b, beta, c);
+            for (int j = 0; j < n; ++j) {
+                for (int i = 0; i < m; ++i) {
+                    double d = std::abs(c(i, j) - R(i, j));
+                    err = d == d ? std::max(err, d) : 1e300;
+                }
+                if (!std::isnan(C(m, j)))
+                    err = 1e300;
+            }
+        }
+        Matrix<double> P(m, k), Q(k, n), S(m, n);
+        P.rand();
+        Q.rand();
+        const auto start = std::chrono::steady_clock::now();
+        gemm(false, false, 1, P, Q, 0, S);
+        const auto end = std::chrono::steady_clock::now();
+        double t = std::chrono::duration<double>(end - start).count();
+        std::cout << names[(int)isa] << ": GFlop/s=" << 2.0 * m * n * k / t * 1e-9 << " error=" << err << std::endl;
+    }
+    SIMD::select(SIMD::supported());
+}
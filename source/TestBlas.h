@@ -10,6 +10,24 @@ public:
 	void test1(int m, int q);
 
 	void test2(int m, int n, int q);
+
+	void testLASR(int m, int n, int k);
+
+	void testSIMD(int n, int q);
+
+	void testNRM2(int n, int q);
+
+	void testExpressions(int n, int q);
+
+	void testParallelReductions(int n);
+
+	void testIAMAX(int n, int q);
+
+	void testContiguous(int n, int q);
+
+	void testRandom(int n);
+
+	void testBlockedGEMM(int m, int n, int k);
 };
 
 #endif
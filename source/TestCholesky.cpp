@@ -0,0 +1,224 @@
+#include "TestCholesky.h"
+#include <iostream>
+#include <chrono>
+#include <ratio>
+#include <ctime>
+#include <numeric>
+#include <cmath>
+
+#include "gemm.h"
+#include "potf2.h"
+#include "potrf2.h"
+#include "potrf.h"
+#include "tpotrf.h"
+#include "chud.h"
+#include "chdd.h"
+#include "windowedls.h"
+#include "packedmatrix.h"
+#include "rfpmatrix.h"
+#include "pptrf.h"
+#include "pftrf.h"
+
+using namespace NUMCPP;
+using namespace LCPP;
+
+namespace {
+
+	// A = B * B' + n * I
+	Matrix<double> spd(int n) {
+		Matrix<double> B(n, n);
+		B.rand();
+		Matrix<double> A(n, n);
+		GEMM<double> gemm;
+		gemm(false, true, 1, B, B, 0, A);
+		A.all().diagonal().add(n);
+		return A;
+	}
+
+	// max |A - L * L'| (lower) or max |A - U' * U| (upper)
+	double residual(Triangular uplo, const Matrix<double>& A, const Matrix<double>& F) {
+		int n = A.getNrows();
+		Matrix<double> T(n, n, [&](int r, int c) {
+			if (uplo == Triangular::Lower)
+				return r >= c ? F(r, c) : 0.0;
+			else
+				return r <= c ? F(r, c) : 0.0;
+			});
+		Matrix<double> R = A;
+		GEMM<double> gemm;
+		if (uplo == Triangular::Lower)
+			gemm(false, true, -1, T, T, 1, R);
+		else
+			gemm(true, false, -1, T, T, 1, R);
+		double e = 0;
+		for (int c = 0; c < n; ++c)
+			e = std::max(e, R.column(c).accumulate([](double s, double x) {return std::max(s, std::abs(x)); }));
+		return e;
+	}
+}
+
+void
+TestCholesky::testPOTF2(int n) {
+	Matrix<double> A = spd(n);
+	POTF2<double> potf2;
+	Matrix<double> L = A;
+	potf2(Triangular::Lower, L);
+	std::cout << "POTF2 lower: info=" << potf2.info() << " residual=" << residual(Triangular::Lower, A, L) << std::endl;
+	Matrix<double> U = A;
+	potf2(Triangular::Upper, U);
+	std::cout << "POTF2 upper: info=" << potf2.info() << " residual=" << residual(Triangular::Upper, A, U) << std::endl;
+	// not positive definite
+	Matrix<double> B = A;
+	B(n / 2, n / 2) = -1;
+	potf2(Triangular::Lower, B);
+	std::cout << "POTF2 not pd: info=" << potf2.info() << std::endl;
+}
+
+void
+TestCholesky::testPOTRF2(int n) {
+	Matrix<double> A = spd(n);
+	POTRF2<double> potrf2;
+	POTF2<double> potf2;
+	Matrix<double> L = A, L2 = A;
+	const auto start = std::chrono::steady_clock::now();
+	potrf2(Triangular::Lower, L);
+	const auto end = std::chrono::steady_clock::now();
+	potf2(Triangular::Lower, L2);
+	const auto end2 = std::chrono::steady_clock::now();
+	std::cout << "POTRF2 lower: info=" << potrf2.info() << " residual=" << residual(Triangular::Lower, A, L)
+		<< " time=" << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()
+		<< " (POTF2: " << std::chrono::duration_cast<std::chrono::milliseconds>(end2 - end).count() << ")" << std::endl;
+	Matrix<double> U = A;
+	potrf2(Triangular::Upper, U);
+	std::cout << "POTRF2 upper: info=" << potrf2.info() << " residual=" << residual(Triangular::Upper, A, U) << std::endl;
+	Matrix<double> B = A;
+	B(n - 2, n - 2) = -1;
+	potrf2(Triangular::Upper, B);
+	std::cout << "POTRF2 not pd: info=" << potrf2.info() << std::endl;
+}
+
+void
+TestCholesky::testPOTRF(int n, int nthreads) {
+	Matrix<double> A = spd(n);
+	POTRF<double>::Algorithm algs[] = { POTRF<double>::LeftLooking, POTRF<double>::RightLooking };
+	Triangular uplos[] = { Triangular::Lower, Triangular::Upper };
+	for (POTRF<double>::Algorithm alg : algs) {
+		for (Triangular uplo : uplos) {
+			POTRF<double> potrf(alg, nthreads);
+			Matrix<double> F = A;
+			const auto start = std::chrono::steady_clock::now();
+			potrf(uplo, F);
+			const auto end = std::chrono::steady_clock::now();
+			std::cout << "POTRF " << (alg == POTRF<double>::LeftLooking ? "left-looking " : "right-looking ")
+				<< (uplo == Triangular::Lower ? "lower" : "upper") << ": info=" << potrf.info()
+				<< " residual=" << residual(uplo, A, F)
+				<< " time=" << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << std::endl;
+		}
+	}
+	Matrix<double> B = A;
+	B(n - 3, n - 3) = -1;
+	POTRF<double> potrf;
+	potrf(Triangular::Lower, B);
+	std::cout << "POTRF not pd: info=" << potrf.info() << std::endl;
+}
+
+void
+TestCholesky::testTPOTRF(int n, int nb, int nthreads) {
+	Matrix<double> A = spd(n);
+	Triangular uplos[] = { Triangular::Lower, Triangular::Upper };
+	for (Triangular uplo : uplos) {
+		TPOTRF<double> tpotrf(nb, nthreads);
+		Matrix<double> F = A;
+		const auto start = std::chrono::steady_clock::now();
+		tpotrf(uplo, F);
+		const auto end = std::chrono::steady_clock::now();
+		std::cout << "TPOTRF " << (uplo == Triangular::Lower ? "lower" : "upper") << ": info=" << tpotrf.info()
+			<< " residual=" << residual(uplo, A, F)
+			<< " time=" << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << std::endl;
+	}
+	Matrix<double> B = A;
+	B(n / 3, n / 3) = -1;
+	TPOTRF<double> tpotrf(nb, nthreads);
+	tpotrf(Triangular::Upper, B);
+	std::cout << "TPOTRF not pd: info=" << tpotrf.info() << std::endl;
+}
+
+void
+TestCholesky::testCHUD(int n) {
+	Matrix<double> A = spd(n);
+	DataBlock<double> x(n);
+	x.rand();
+	Sequence<double> xs = x.all();
+	Matrix<double> Ax(n, n, [&](int r, int c) {return A(r, c) + xs(r) * xs(c); });
+	Triangular uplos[] = { Triangular::Lower, Triangular::Upper };
+	for (Triangular uplo : uplos) {
+		Matrix<double> F = A;
+		POTRF2<double> potrf2;
+		potrf2(uplo, F);
+		CHUD<double> chud;
+		chud(uplo, F.all(), xs);
+		std::cout << "CHUD " << (uplo == Triangular::Lower ? "lower" : "upper") << ": residual=" << residual(uplo, Ax, F) << std::endl;
+		CHDD<double> chdd;
+		chdd(uplo, F.all(), xs);
+		std::cout << "CHDD " << (uplo == Triangular::Lower ? "lower" : "upper") << ": info=" << chdd.info() << " residual=" << residual(uplo, A, F) << std::endl;
+		// A - 100 x x' is not positive definite
+		DataBlock<double> y(n, [&](int i) {return 10 * xs(i); });
+		chdd(uplo, F.all(), y.all());
+		std::cout << "CHDD not pd: info=" << chdd.info() << " residual=" << residual(uplo, A, F) << std::endl;
+	}
+}
+
+void
+TestCholesky::testWindowedLeastSquares(int k, int window, int nobs) {
+	Matrix<double> X(k, nobs);
+	X.rand();
+	DataBlock<double> y(nobs, [&](int t) {return X.column(t).sum() + std::sin(t); });
+	WindowedLeastSquares<double> wls(k, window);
+	DataBlock<double> b(k);
+	const auto start = std::chrono::steady_clock::now();
+	for (int t = 0; t < nobs; ++t) {
+		wls.add(X.column(t), y.all()(t));
+		if (t >= window)
+			wls.coefficients(b.all());
+	}
+	const auto end = std::chrono::steady_clock::now();
+	std::cout << "WindowedLeastSquares: " << b << " time=" << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << std::endl;
+}
+
+void
+TestCholesky::testPackedCholesky(int n) {
+	Matrix<double> A = spd(n);
+	Triangular uplos[] = { Triangular::Lower, Triangular::Upper };
+	// odd and even orders (different RFP layouts)
+	for (int m = n; m <= n + 1; ++m) {
+		Matrix<double> Am = spd(m);
+		for (Triangular uplo : uplos) {
+			const char* name = uplo == Triangular::Lower ? "lower" : "upper";
+			PackedMatrix<double> P(Am.all(), uplo);
+			RFPMatrix<double> R(P);
+			PackedMatrix<double> Q = R.toPacked();
+			Matrix<double> D = Q.toMatrix();
+			double e = 0;
+			for (int c = 0; c < m; ++c)
+				for (int r = 0; r < m; ++r)
+					e = std::max(e, std::abs(D(r, c) - Am(r, c)));
+			std::cout << "Packed/RFP " << name << " n=" << m << ": conversion error=" << e << std::endl;
+
+			PPTRF<double> pptrf;
+			pptrf(P);
+			std::cout << "PPTRF " << name << ": info=" << pptrf.info() << " residual=" << residual(uplo, Am, P.toMatrix(false)) << std::endl;
+			PFTRF<double> pftrf;
+			const auto start = std::chrono::steady_clock::now();
+			pftrf(R);
+			const auto end = std::chrono::steady_clock::now();
+			std::cout << "PFTRF " << name << ": info=" << pftrf.info() << " residual=" << residual(uplo, Am, R.toMatrix(false))
+				<< " time=" << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << std::endl;
+		}
+	}
+	Matrix<double> B = A;
+	B(n - 1, n - 1) = -1;
+	RFPMatrix<double> R(B.all(), Triangular::Lower);
+	PFTRF<double> pftrf;
+	pftrf(R);
+	std::cout << "PFTRF not pd: info=" << pftrf.info() << std::endl;
+}
@@ -0,0 +1,26 @@
+#ifndef __lcpp_testcholesky_h
+#define __lcpp_testcholesky_h
+
+class TestCholesky {
+
+public:
+
+	TestCholesky() {}
+
+	void testPOTF2(int n);
+
+	void testPOTRF2(int n);
+
+	void testPOTRF(int n, int nthreads);
+
+	void testTPOTRF(int n, int nb, int nthreads);
+
+	void testCHUD(int n);
+
+	void testWindowedLeastSquares(int k, int window, int nobs);
+
+	void testPackedCholesky(int n);
+
+};
+
+#endif
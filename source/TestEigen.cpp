@@ -0,0 +1,349 @@
+#include "TestEigen.h"
+#include <iostream>
+#include <chrono>
+#include <ratio>
+#include <ctime>
+#include <numeric>
+#include <cmath>
+#include <vector>
+#include <complex>
+#include <algorithm>
+
+#include "gemm.h"
+#include "gehd2.h"
+#include "gehrd.h"
+#include "orghr.h"
+#include "gebal.h"
+#include "gebak.h"
+#include "lahqr.h"
+#include "hseqr.h"
+#include "sytd2.h"
+#include "sytrd.h"
+#include "steqr.h"
+#include "stedc.h"
+#include "syevd.h"
+#include "gesvj.h"
+#include "TestUtils.h"
+
+using namespace NUMCPP;
+using namespace LCPP;
+
+namespace {
+
+	// max |Q * H * Q' - A| and max |Q'Q - I|
+	void check(const char* name, const Matrix<double>& A, const Matrix<double>& H, const Matrix<double>& Q) {
+		int n = A.getNrows();
+		GEMM<double> gemm;
+		Matrix<double> QH(n, n), QHQ(n, n), QQ(n, n), I(n, n, [](int r, int c) {return r == c ? 1.0 : 0.0; });
+		gemm(false, false, 1, Q.all(), H.all(), 0, QH.all());
+		gemm(false, true, 1, QH.all(), Q.all(), 0, QHQ.all());
+		gemm(true, false, 1, Q.all(), Q.all(), 0, QQ.all());
+		std::cout << name << ": max |QHQ' - A| = " << maxdiff(QHQ, A) << " max |Q'Q - I| = " << maxdiff(QQ, I) << std::endl;
+	}
+}
+
+void
+TestEigen::testGEHRD(int n) {
+	Matrix<double> A(n, n);
+	A.rand();
+	Matrix<double> F = A, F2 = A;
+	DataBlock<double> tau(n - 1), tau2(n - 1);
+	GEHRD<double> gehrd;
+	GEHD2<double> gehd2;
+	const auto start = std::chrono::steady_clock::now();
+	gehrd(F, tau.all());
+	const auto end = std::chrono::steady_clock::now();
+	gehd2(F2.all(), tau2.all());
+	const auto end2 = std::chrono::steady_clock::now();
+	std::cout << "GEHRD: time=" << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()
+		<< " (GEHD2: " << std::chrono::duration_cast<std::chrono::milliseconds>(end2 - end).count() << ")"
+		<< " max |F - F2| = " << maxdiff(F, F2) << std::endl;
+	Matrix<double> H(n, n, [&](int r, int c) {return r <= c + 1 ? F(r, c) : 0.0; });
+	Matrix<double> Q = F;
+	ORGHR<double> orghr;
+	orghr(Q, tau.all());
+	check("GEHRD", A, H, Q);
+
+	// partial reduction (rows/columns 0:ilo-1 and ihi+1:n-1 already triangular)
+	int ilo = n / 5, ihi = n - 1 - n / 7;
+	Matrix<double> B(n, n, [&](int r, int c) {return (r > c && (c < ilo || r > ihi)) ? 0.0 : A(r, c); });
+	Matrix<double> G = B;
+	gehrd(ilo, ihi, G.all(), tau.all());
+	Matrix<double> HG(n, n, [&](int r, int c) {return r <= c + 1 ? G(r, c) : 0.0; });
+	orghr(ilo, ihi, G.all(), tau.all());
+	check("GEHRD (ilo, ihi)", B, HG, G);
+}
+
+void
+TestEigen::testGEBAL(int n) {
+	// badly scaled matrix, with some isolated eigenvalues
+	std::vector<int> e(n);
+	for (int i = 0; i < n; ++i)
+		e[i] = (i * 7) % 41 - 20;
+	Matrix<double> R(n, n);
+	R.rand();
+	Matrix<double> A(n, n, [&](int r, int c) {
+		if (r != c && (r % 11 == 3 || c % 13 == 5))
+			return 0.0;
+		return std::ldexp(R(r, c), e[r] - e[c]);
+		});
+	Matrix<double> B = A;
+	DataBlock<double> scale(n);
+	GEBAL<double> gebal;
+	const auto start = std::chrono::steady_clock::now();
+	gebal(B, scale.all());
+	const auto end = std::chrono::steady_clock::now();
+	int ilo = gebal.ilo(), ihi = gebal.ihi();
+	double nA = 0, nB = 0, z = 0;
+	for (int c = 0; c < n; ++c) {
+		for (int r = 0; r < n; ++r) {
+			nA += std::abs(A(r, c));
+			nB += std::abs(B(r, c));
+			if (r > c && (c < ilo || r > ihi))
+				z = std::max(z, std::abs(B(r, c)));
+		}
+	}
+	std::cout << "GEBAL: time=" << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()
+		<< " ilo=" << ilo << " ihi=" << ihi << " sum |A| = " << nA << " sum |B| = " << nB << " max |B(isolated)| = " << z << std::endl;
+
+	// X = P * D (right), Y = P * inv(D) (left): A * X = X * B and Y' * A = B * Y'
+	GEBAK<double> gebak;
+	Matrix<double> X(n, n, [](int r, int c) {return r == c ? 1.0 : 0.0; }), Y = X;
+	gebak(BalanceBoth, Side::Right, ilo, ihi, scale.all(), X);
+	gebak(BalanceBoth, Side::Left, ilo, ihi, scale.all(), Y);
+	GEMM<double> gemm;
+	Matrix<double> AX(n, n), XB(n, n), YA(n, n), BY(n, n);
+	gemm(false, false, 1, A.all(), X.all(), 0, AX.all());
+	gemm(false, false, 1, X.all(), B.all(), 0, XB.all());
+	gemm(true, false, 1, Y.all(), A.all(), 0, YA.all());
+	gemm(false, true, 1, B.all(), Y.all(), 0, BY.all());
+	double ex = 0, ey = 0;
+	for (int c = 0; c < n; ++c) {
+		for (int r = 0; r < n; ++r) {
+			ex = std::max(ex, std::abs(AX(r, c) - XB(r, c)) / (std::abs(AX(r, c)) + 1e-300));
+			ey = std::max(ey, std::abs(YA(r, c) - BY(r, c)) / (std::abs(YA(r, c)) + 1e-300));
+		}
+	}
+	std::cout << "GEBAK: max rel |AX - XB| = " << ex << " max rel |Y'A - BY'| = " << ey << std::endl;
+}
+
+void
+TestEigen::testHSEQR(int n) {
+	Matrix<double> A(n, n);
+	A.rand();
+	Matrix<double> F = A;
+	DataBlock<double> tau(std::max(1, n - 1)), wr(n), wi(n), wr2(n), wi2(n);
+	GEHRD<double> gehrd;
+	gehrd(F, tau.all());
+	Matrix<double> H(n, n, [&](int r, int c) {return r <= c + 1 ? F(r, c) : 0.0; }), H2 = H;
+	Matrix<double> Z = F;
+	ORGHR<double> orghr;
+	orghr(Z, tau.all());
+	Matrix<double> Z2 = Z;
+	HSEQR<double> hseqr;
+	const auto start = std::chrono::steady_clock::now();
+	hseqr(true, true, H.all(), wr.all(), wi.all(), Z.all());
+	const auto end = std::chrono::steady_clock::now();
+	LAHQR<double> lahqr;
+	lahqr(true, true, 0, n - 1, H2.all(), wr2.all(), wi2.all(), 0, n - 1, Z2.all());
+	const auto end2 = std::chrono::steady_clock::now();
+	std::cout << "HSEQR: time=" << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()
+		<< " (LAHQR: " << std::chrono::duration_cast<std::chrono::milliseconds>(end2 - end).count() << ")"
+		<< " info=" << hseqr.info() << " (" << lahqr.info() << ")" << std::endl;
+	// quasi-triangular form, and standardized 2 x 2 blocks
+	double q = 0;
+	for (int c = 0; c < n; ++c) {
+		for (int r = c + 1; r < n; ++r) {
+			bool block = r == c + 1 && wi.all()(c) > 0;
+			if (!block)
+				q = std::max(q, std::abs(H(r, c)));
+			else
+				q = std::max(q, std::abs(H(c, c) - H(r, r)));
+		}
+	}
+	check("HSEQR", A, H, Z);
+	// same eigenvalues as LAHQR
+	std::vector<std::complex<double>> e1(n), e2(n);
+	for (int i = 0; i < n; ++i) {
+		e1[i] = std::complex<double>(wr.all()(i), wi.all()(i));
+		e2[i] = std::complex<double>(wr2.all()(i), wi2.all()(i));
+	}
+	auto cmp = [](const std::complex<double>& l, const std::complex<double>& r) {return l.real() < r.real() || (l.real() == r.real() && l.imag() < r.imag()); };
+	std::sort(e1.begin(), e1.end(), cmp);
+	std::sort(e2.begin(), e2.end(), cmp);
+	double d = 0;
+	for (int i = 0; i < n; ++i)
+		d = std::max(d, std::abs(e1[i] - e2[i]));
+	std::cout << "HSEQR: max |T(quasi-lower)| = " << q << " max |eig - eig(LAHQR)| = " << d << std::endl;
+}
+
+void
+TestEigen::testCompanion(int n, int count) {
+	// polynomials with known roots (complex conjugate pairs and a real root, in the unit disk)
+	std::vector<Matrix<double>> C;
+	std::vector<std::vector<double>> coefs;
+	Matrix<double> R(n, count);
+	R.rand();
+	for (int p = 0; p < count; ++p) {
+		std::vector<std::complex<double>> z;
+		for (int i = 0; i + 1 < n; i += 2) {
+			std::complex<double> c = std::polar(0.5 + 0.5 * R(i, p), 3.14159 * (i + 1) / n);
+			z.push_back(c);
+			z.push_back(std::conj(c));
+		}
+		if (n % 2 == 1)
+			z.push_back(2 * R(n - 1, p) - 1);
+		// coefficients of prod (x - z)
+		std::vector<std::complex<double>> coef(1, 1.0);
+		for (const auto& r : z) {
+			coef.push_back(0.0);
+			for (int k = (int)coef.size() - 1; k > 0; --k)
+				coef[k] -= r * coef[k - 1];
+		}
+		std::vector<double> a;
+		for (const auto& c : coef)
+			a.push_back(c.real());
+		C.emplace_back(n, n, [&](int r, int c) {return r == 0 ? -a[c + 1] : (r == c + 1 ? 1.0 : 0.0); });
+		coefs.push_back(a);
+	}
+	DataBlock<double> wr(n), wi(n), scale(n);
+	// balancing
+	GEBAL<double> gebal;
+	for (int p = 0; p < count; ++p)
+		gebal(C[p], scale.all());
+	HSEQR<double> hseqr;
+	LAHQR<double> lahqr;
+	double e = 0, e2 = 0;
+	// (normwise) backward error of the roots: |p(l)| / sum |a(k)| |l|^k
+	auto error = [&](int p) {
+		double err = 0;
+		for (int i = 0; i < n; ++i) {
+			std::complex<double> l(wr.all()(i), wi.all()(i)), v = 0;
+			double d = 0;
+			for (double a : coefs[p]) {
+				v = v * l + a;
+				d = d * std::abs(l) + std::abs(a);
+			}
+			err = std::max(err, std::abs(v) / d);
+		}
+		return err;
+	};
+	std::vector<Matrix<double>> C2 = C;
+	const auto start = std::chrono::steady_clock::now();
+	for (int p = 0; p < count; ++p) {
+		hseqr(false, false, C[p].all(), wr.all(), wi.all(), C[p].all());
+		e = std::max(e, error(p));
+	}
+	const auto end = std::chrono::steady_clock::now();
+	for (int p = 0; p < count; ++p) {
+		lahqr(false, false, 0, n - 1, C2[p].all(), wr.all(), wi.all(), 0, -1, C2[p].all());
+		e2 = std::max(e2, error(p));
+	}
+	const auto end2 = std::chrono::steady_clock::now();
+	std::cout << "Companion (n=" << n << ", " << count << " polynomials): HSEQR time=" << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()
+		<< " max backward error=" << e << " (LAHQR time=" << std::chrono::duration_cast<std::chrono::milliseconds>(end2 - end).count() << " max backward error=" << e2 << ")" << std::endl;
+}
+
+void
+TestEigen::testSYEVD(int n) {
+	// random symmetric matrix, and a matrix with a multiple eigenvalue (I + R * R', R of rank 5)
+	Matrix<double> R(n, n), L(n, 5);
+	R.rand();
+	L.rand();
+	Matrix<double> A(n, n, [&](int r, int c) {return r >= c ? R(r, c) : R(c, r); });
+	Matrix<double> B(n, n, [&](int r, int c) {
+		double s = r == c ? 1.0 : 0.0;
+		for (int k = 0; k < 5; ++k)
+			s += L(r, k) * L(c, k);
+		return s;
+		});
+	GEMM<double> gemm;
+	for (Matrix<double>* M : { &A, &B }) {
+		Matrix<double> Z = *M;
+		DataBlock<double> w(n);
+		SYEVD<double> syevd;
+		const auto start = std::chrono::steady_clock::now();
+		syevd(true, Z, w.all());
+		const auto end = std::chrono::steady_clock::now();
+		// max |A * Z - Z * diag(w)| and max |Z'Z - I|
+		Matrix<double> AZ(n, n), ZZ(n, n), I(n, n, [](int r, int c) {return r == c ? 1.0 : 0.0; });
+		gemm(false, false, 1, *M, Z, 0, AZ);
+		Matrix<double> ZW(n, n, [&](int r, int c) {return Z(r, c) * w.all()(c); });
+		gemm(true, false, 1, Z, Z, 0, ZZ);
+		std::cout << "SYEVD: time=" << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()
+			<< " info=" << syevd.info() << " max |AZ - ZW| = " << maxdiff(AZ, ZW) << " max |Z'Z - I| = " << maxdiff(ZZ, I) << std::endl;
+
+		// tridiagonal reduction: blocked and unblocked
+		Matrix<double> F = *M, F2 = *M;
+		DataBlock<double> d(n), e(std::max(1, n - 1)), tau(std::max(1, n - 1)), d2(n), e2(std::max(1, n - 1)), tau2(std::max(1, n - 1));
+		SYTRD<double> sytrd;
+		SYTD2<double> sytd2;
+		const auto start2 = std::chrono::steady_clock::now();
+		sytrd(F, d.all(), e.all(), tau.all());
+		const auto end2 = std::chrono::steady_clock::now();
+		sytd2(F2.all(), d2.all(), e2.all(), tau2.all());
+		const auto end3 = std::chrono::steady_clock::now();
+		double dt = 0;
+		for (int i = 0; i < n; ++i)
+			dt = std::max(dt, std::abs(d.all()(i) - d2.all()(i)));
+		std::cout << "SYTRD: time=" << std::chrono::duration_cast<std::chrono::milliseconds>(end2 - start2).count()
+			<< " (SYTD2: " << std::chrono::duration_cast<std::chrono::milliseconds>(end3 - end2).count() << ") max |d - d2| = " << dt << std::endl;
+
+		// tridiagonal eigenproblem: divide-and-conquer and QL/QR
+		DataBlock<double> e3 = e;
+		Matrix<double> Zt(n, n), Zq(n, n, [](int r, int c) {return r == c ? 1.0 : 0.0; });
+		STEDC<double> stedc;
+		STEQR<double> steqr;
+		const auto start4 = std::chrono::steady_clock::now();
+		stedc(true, d.all(), e.all(), Zt.all());
+		const auto end4 = std::chrono::steady_clock::now();
+		steqr(true, d2.all(), e3.all(), Zq.all());
+		const auto end5 = std::chrono::steady_clock::now();
+		double dw = 0;
+		for (int i = 0; i < n; ++i)
+			dw = std::max(dw, std::abs(d.all()(i) - d2.all()(i)) + std::abs(d.all()(i) - w.all()(i)));
+		std::cout << "STEDC: time=" << std::chrono::duration_cast<std::chrono::milliseconds>(end4 - start4).count()
+			<< " (STEQR: " << std::chrono::duration_cast<std::chrono::milliseconds>(end5 - end4).count() << ") info=" << stedc.info() << " (" << steqr.info() << ")"
+			<< " max |eig - eig(STEQR)| = " << dw << std::endl;
+	}
+}
+
+void
+TestEigen::testGESVJ(int m, int n) {
+	// random matrix, and graded matrix A = B * D (columns scaled from 1 to 1e-12)
+	Matrix<double> R(m, n);
+	R.rand();
+	Matrix<double> G(m, n, [&](int r, int c) {return R(r, c) * std::pow(10.0, -12.0 * c / std::max(1, n - 1)); });
+	GEMM<double> gemm;
+	for (Matrix<double>* M : { &R, &G }) {
+		Matrix<double> U = *M, U1 = *M, V(n, n), V1(n, n);
+		DataBlock<double> sv(n), sv1(n);
+		GESVJ<double> gesvj, gesvj1(1);
+		const auto start = std::chrono::steady_clock::now();
+		gesvj(true, true, U, sv.all(), V);
+		const auto end = std::chrono::steady_clock::now();
+		gesvj1(true, true, U1, sv1.all(), V1);
+		const auto end2 = std::chrono::steady_clock::now();
+		// column-wise relative error of U * S * V', and orthogonality
+		Matrix<double> US(m, n, [&](int r, int c) {return U(r, c) * sv.all()(c); }), USV(m, n), UU(n, n), VV(n, n);
+		gemm(false, true, 1, US, V, 0, USV);
+		gemm(true, false, 1, U, U, 0, UU);
+		gemm(true, false, 1, V, V, 0, VV);
+		Matrix<double> I(n, n, [](int r, int c) {return r == c ? 1.0 : 0.0; });
+		double e = 0, ds = 0;
+		for (int c = 0; c < n; ++c) {
+			double nc = 0, ec = 0;
+			for (int r = 0; r < m; ++r) {
+				nc += (*M)(r, c) * (*M)(r, c);
+				ec += (USV(r, c) - (*M)(r, c)) * (USV(r, c) - (*M)(r, c));
+			}
+			e = std::max(e, std::sqrt(ec / nc));
+			ds = std::max(ds, std::abs(sv.all()(c) - sv1.all()(c)) / sv.all()(c));
+		}
+		std::cout << "GESVJ: time=" << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()
+			<< " (1 thread: " << std::chrono::duration_cast<std::chrono::milliseconds>(end2 - end).count() << ") sweeps=" << gesvj.sweeps()
+			<< " info=" << gesvj.info() << " smax=" << sv.all()(0) << " smin=" << sv.all()(n - 1) << std::endl;
+		std::cout << "GESVJ: max rel |USV' - A|(columns) = " << e << " max |U'U - I| = " << maxdiff(UU, I) << " max |V'V - I| = " << maxdiff(VV, I)
+			<< " max rel |s - s(1 thread)| = " << ds << std::endl;
+	}
+}
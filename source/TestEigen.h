@@ -0,0 +1,24 @@
+#ifndef __lcpp_testeigen_h
+#define __lcpp_testeigen_h
+
+class TestEigen {
+
+public:
+
+	TestEigen() {}
+
+	void testGEHRD(int n);
+
+	void testGEBAL(int n);
+
+	void testHSEQR(int n);
+
+	void testCompanion(int n, int count);
+
+	void testSYEVD(int n);
+
+	void testGESVJ(int m, int n);
+
+};
+
+#endif
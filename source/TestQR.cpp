@@ -0,0 +1,247 @@
+#include "TestQR.h"
+#include <iostream>
+#include <chrono>
+#include <ratio>
+#include <ctime>
+#include <numeric>
+#include <cmath>
+
+#include "gemm.h"
+#include "larfg.h"
+#include "larf.h"
+#include "larft.h"
+#include "larfb.h"
+#include "geqr2.h"
+#include "geqrf.h"
+#include "orgqr.h"
+#include "ormqr.h"
+#include "tsqr.h"
+#include "gels.h"
+#include "posv.h"
+#include "TestUtils.h"
+
+using namespace NUMCPP;
+using namespace LCPP;
+
+namespace {
+
+	// H = product of the elementary reflectors (I - tau(i) v(i) v(i)'), in the order given by direct.
+	// The columns of V are complete (unit elements and zeros included)
+	Matrix<double> reflector(Direction direct, const Matrix<double>& V, Sequence<double> tau) {
+		int n = V.getNrows(), k = V.getNcols();
+		Matrix<double> H(n, n, [](int r, int c) {return r == c ? 1.0 : 0.0; });
+		GEMM<double> gemm;
+		for (int j = 0; j < k; ++j) {
+			int i = direct == Direction::Forward ? j : k - 1 - j;
+			Matrix<double> Hi(n, n, [&](int r, int c) {return (r == c ? 1.0 : 0.0) - tau(i) * V(r, i) * V(c, i); });
+			Matrix<double> P(n, n);
+			gemm(false, false, 1, H, Hi, 0, P);
+			H = P;
+		}
+		return H;
+	}
+}
+
+void
+TestQR::testLARFG(int m, int n) {
+	// unblocked QR: A = H(1) ... H(n) R
+	Matrix<double> A(m, n);
+	A.rand();
+	Matrix<double> F = A;
+	DataBlock<double> tau(n);
+	LARFG<double> larfg;
+	LARF<double> larf;
+	for (int i = 0; i < n; ++i) {
+		tau.all()(i) = larfg(F.column(i).drop(i, 0));
+		if (i < n - 1)
+			larf(Side::Left, F.column(i).drop(i, 0), tau.all()(i), F.extract(i, m - i, i + 1, n - i - 1));
+	}
+	// Q' A should be R
+	Matrix<double> R = A;
+	for (int i = 0; i < n; ++i)
+		larf(Side::Left, F.column(i).drop(i, 0), tau.all()(i), R.extract(i, m - i, 0, n));
+	Matrix<double> Rf(m, n, [&](int r, int c) {return r <= c ? F(r, c) : 0.0; });
+	std::cout << "LARFG/LARF: max |Q'A - R| = " << maxdiff(R, Rf) << std::endl;
+}
+
+void
+TestQR::testLARFB(int m, int n, int k) {
+	Direction dirs[] = { Direction::Forward, Direction::Backward };
+	GEMM<double> gemm;
+	for (Direction direct : dirs) {
+		// unit lower (forward) or unit upper (backward) trapezoidal vectors
+		Matrix<double> V(m, k);
+		V.rand();
+		for (int j = 0; j < k; ++j) {
+			int p = direct == Direction::Forward ? j : m - k + j;
+			V(p, j) = 1;
+			for (int r = 0; r < m; ++r)
+				if (direct == Direction::Forward ? r < p : r > p)
+					V(r, j) = 0;
+		}
+		DataBlock<double> tau(k, [&](int j) {return 2 / V.column(j).ssq(); });
+		Matrix<double> Tf(k, k);
+		LARFT<double> larft;
+		larft(direct, V.all(), tau.all(), Tf.all());
+		Matrix<double> H = reflector(direct, V, tau.all());
+		Matrix<double> C(m, n), Ct(n, m);
+		C.rand();
+		Ct.rand();
+		LARFB<double> larfb;
+		bool trans[] = { false, true };
+		for (bool t : trans) {
+			Matrix<double> L = C, R = Ct, L0(m, n), R0(n, m);
+			gemm(t, false, 1, H, C, 0, L0);
+			gemm(false, t, 1, Ct, H, 0, R0);
+			const auto start = std::chrono::steady_clock::now();
+			larfb(Side::Left, t, direct, V.all(), Tf.all(), L.all());
+			const auto end = std::chrono::steady_clock::now();
+			larfb(Side::Right, t, direct, V.all(), Tf.all(), R.all());
+			std::cout << "LARFB " << (direct == Direction::Forward ? "forward" : "backward") << (t ? " H'" : " H")
+				<< ": left error=" << maxdiff(L, L0) << " right error=" << maxdiff(R, R0)
+				<< " time=" << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << std::endl;
+		}
+	}
+}
+
+void
+TestQR::testGEQRF(int m, int n) {
+	Matrix<double> A(m, n);
+	A.rand();
+	int k = std::min(m, n);
+	Matrix<double> F = A, F2 = A;
+	DataBlock<double> tau(k), tau2(k);
+	GEQRF<double> geqrf;
+	GEQR2<double> geqr2;
+	const auto start = std::chrono::steady_clock::now();
+	geqrf(F, tau.all());
+	const auto end = std::chrono::steady_clock::now();
+	geqr2(F2.all(), tau2.all());
+	const auto end2 = std::chrono::steady_clock::now();
+	std::cout << "GEQRF: time=" << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()
+		<< " (GEQR2: " << std::chrono::duration_cast<std::chrono::milliseconds>(end2 - end).count() << ")"
+		<< " max |F - F2| = " << maxdiff(F, F2) << std::endl;
+	// Q (m x k) and A = Q * R
+	Matrix<double> Q(m, k, [&](int r, int c) {return F(r, c); });
+	ORGQR<double> orgqr;
+	orgqr(k, Q, tau.all());
+	Matrix<double> R(k, n, [&](int r, int c) {return r <= c ? F(r, c) : 0.0; });
+	Matrix<double> QR(m, n), QQ(k, k), I(k, k, [](int r, int c) {return r == c ? 1.0 : 0.0; });
+	GEMM<double> gemm;
+	gemm(false, false, 1, Q, R, 0, QR);
+	gemm(true, false, 1, Q, Q, 0, QQ);
+	std::cout << "ORGQR: max |QR - A| = " << maxdiff(QR, A) << " max |Q'Q - I| = " << maxdiff(QQ, I) << std::endl;
+	// ORMQR against the explicit Q (m x m)
+	if (m >= n) {
+		Matrix<double> Qf(m, m, [&](int r, int c) {return c < k ? F(r, c) : 0.0; });
+		orgqr(k, Qf, tau.all());
+		Matrix<double> C(m, 7), Ct(7, m);
+		C.rand();
+		Ct.rand();
+		ORMQR<double> ormqr;
+		bool trans[] = { false, true };
+		for (bool t : trans) {
+			Matrix<double> L = C, L0(m, 7), Rc = Ct, R0(7, m);
+			ormqr(Side::Left, t, F.all(), tau.all(), L.all());
+			gemm(t, false, 1, Qf, C, 0, L0);
+			ormqr(Side::Right, t, F.all(), tau.all(), Rc.all());
+			gemm(false, t, 1, Ct, Qf, 0, R0);
+			std::cout << "ORMQR" << (t ? " Q'" : " Q") << ": left error=" << maxdiff(L, L0) << " right error=" << maxdiff(Rc, R0) << std::endl;
+		}
+	}
+}
+
+void
+TestQR::testTSQR(int m, int n, int nthreads) {
+	Matrix<double> A(m, n);
+	A.rand();
+	Matrix<double> F = A, F2 = A;
+	TSQR<double> tsqr(0, nthreads);
+	const auto start = std::chrono::steady_clock::now();
+	tsqr(F.all());
+	const auto end = std::chrono::steady_clock::now();
+	DataBlock<double> tau(n);
+	GEQRF<double> geqrf;
+	geqrf(F2, tau.all());
+	const auto end2 = std::chrono::steady_clock::now();
+	// R is unique up to the signs of its rows
+	Matrix<double> R = tsqr.r();
+	double e = 0;
+	for (int r = 0; r < n; ++r)
+		for (int c = r; c < n; ++c)
+			e = std::max(e, std::abs(std::abs(R(r, c)) - std::abs(F2(r, c))));
+	std::cout << "TSQR: blocks=" << tsqr.getBlocksCount() << " time=" << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()
+		<< " (GEQRF: " << std::chrono::duration_cast<std::chrono::milliseconds>(end2 - end).count() << ")"
+		<< " max ||R| - |R(GEQRF)|| = " << e << std::endl;
+	Matrix<double> Q(m, n), QR(m, n);
+	tsqr.q(Q.all());
+	GEMM<double> gemm;
+	gemm(false, false, 1, Q, R, 0, QR);
+	Matrix<double> QQ(n, n), I(n, n, [](int r, int c) {return r == c ? 1.0 : 0.0; });
+	gemm(true, false, 1, Q, Q, 0, QQ);
+	std::cout << "TSQR: max |QR - A| = " << maxdiff(QR, A) << " max |Q'Q - I| = " << maxdiff(QQ, I) << std::endl;
+	// Q' applied to A gives R (first n rows) and 0
+	Matrix<double> B = A;
+	tsqr.applyQ(true, B.all());
+	Matrix<double> R0(m, n, [&](int r, int c) {return r <= c && r < n ? R(r, c) : 0.0; });
+	std::cout << "TSQR: max |Q'A - R| = " << maxdiff(B, R0) << std::endl;
+	// the object only refers to the factorized matrix: a copy outlives the original
+	Matrix<double> G = A;
+	TSQR<double> copy;
+	{
+		TSQR<double> other(0, nthreads);
+		other(G.all());
+		copy = other;
+	}
+	std::cout << "TSQR: copy max |R - R(copy)| = " << maxdiff(copy.r(), R) << std::endl;
+}
+
+void
+TestQR::testGELS(int m, int n, int k) {
+	Matrix<double> A(m, n), B(std::max(m, n), k);
+	A.rand();
+	B.rand();
+	Matrix<double> F = A, X = B;
+	GELS<double> gels;
+	const auto start = std::chrono::steady_clock::now();
+	gels(F, X);
+	const auto end = std::chrono::steady_clock::now();
+	Matrix<double> Xs(n, k, [&](int r, int c) {return X(r, c); });
+	Matrix<double> E(m, k, [&](int r, int c) {return B(r, c); });
+	GEMM<double> gemm;
+	// E = A * X - B
+	gemm(false, false, 1, A, Xs, -1, E);
+	if (m >= n) {
+		// normal equations: A' * (A * X - B) = 0
+		Matrix<double> G(n, k), Z(n, k, [](int, int) {return 0.0; });
+		gemm(true, false, 1, A, E, 0, G);
+		std::cout << "GELS (least squares): info=" << gels.info() << " max |A'(AX - B)| = " << maxdiff(G, Z);
+	}
+	else {
+		// A * X = B and X = A' * inv(A * A') * B
+		Matrix<double> AA(m, m), Y(m, k, [&](int r, int c) {return B(r, c); }), X2(n, k), Z(m, k, [](int, int) {return 0.0; });
+		gemm(false, true, 1, A, A, 0, AA);
+		POSV<double> posv;
+		posv(Triangular::Lower, AA.all(), Y.all());
+		gemm(true, false, 1, A, Y, 0, X2);
+		std::cout << "GELS (minimum norm): info=" << gels.info() << " max |AX - B| = " << maxdiff(E, Z) << " max |X - X(normal)| = " << maxdiff(Xs, X2);
+	}
+	std::cout << " time=" << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << std::endl;
+}
+
+void
+TestQR::testManyGELS(int nseries, int m, int n) {
+	// the same GELS object (and its workspace) is used for all the series
+	GELS<double> gels;
+	Matrix<double> A(m, n), B(m, 1);
+	const auto start = std::chrono::steady_clock::now();
+	double s = 0;
+	for (int i = 0; i < nseries; ++i) {
+		A.rand();
+		B.rand();
+		gels(A, B);
+		s += B(0, 0);
+	}
+	const auto end = std::chrono::steady_clock::now();
+	std::cout << "GELS " << nseries << " series: time=" << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << " (" << s << ")" << std::endl;
+}
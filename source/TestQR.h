@@ -0,0 +1,24 @@
+#ifndef __lcpp_testqr_h
+#define __lcpp_testqr_h
+
+class TestQR {
+
+public:
+
+	TestQR() {}
+
+	void testLARFG(int m, int n);
+
+	void testLARFB(int m, int n, int k);
+
+	void testGEQRF(int m, int n);
+
+	void testTSQR(int m, int n, int nthreads);
+
+	void testGELS(int m, int n, int k);
+
+	void testManyGELS(int nseries, int m, int n);
+
+};
+
+#endif
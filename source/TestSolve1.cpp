@@ -1,6 +1,17 @@
 #include "TestSolve1.h"
 #include "gesv.h"
 #include "getrf.h"
+#include "gemm.h"
+#include "posv.h"
+#include "bandmatrix.h"
+#include "gbtrf.h"
+#include "gbtrs.h"
+#include "pbtrf.h"
+#include "pbtrs.h"
+#include <vector>
+#include <stdexcept>
+#include <iostream>
+#include <chrono>
 
 using namespace NUMCPP;
 using namespace LCPP;
@@ -21,3 +32,93 @@ TestSolve1::testGESVXX(int n, int k) {
 	GESV<double> gesv;
 }
 
+
+
+void
+TestSolve1::testPOSV(int n, int k) {
+	Matrix<double> C(n, n);
+	C.rand();
+	Matrix<double> A(n, n);
+	GEMM<double> gemm;
+	gemm(false, true, 1, C, C, 0, A);
+	A.all().diagonal().add(n);
+	Matrix<double> B(n, k);
+	B.rand();
+	Triangular uplos[] = { Triangular::Lower, Triangular::Upper };
+	for (Triangular uplo : uplos) {
+		Matrix<double> F = A, X = B;
+		POSV<double> posv;
+		const auto start = std::chrono::steady_clock::now();
+		posv(uplo, F, X);
+		const auto end = std::chrono::steady_clock::now();
+		// R = A * X - B
+		Matrix<double> R = B;
+		gemm(false, false, 1, A, X, -1, R);
+		double e = 0;
+		for (int c = 0; c < k; ++c)
+			e = std::max(e, R.column(c).accumulate([](double s, double x) {return std::max(s, std::abs(x)); }));
+		std::cout << "POSV " << (uplo == Triangular::Lower ? "lower" : "upper") << ": info=" << posv.info() << " residual=" << e
+			<< " time=" << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << std::endl;
+	}
+}
+
+void
+TestSolve1::testBand(int n, int kl, int ku) {
+	// general band matrix, with room for the fill-in of the LU factorization
+	BandMatrix<double> A(n, kl, ku, kl);
+	for (int c = 0; c < n; ++c) {
+		A.all().column(c).rand();
+		A(c, c) += 2;
+	}
+	BandMatrix<double> LU = A;
+	DataBlock<double> b(n);
+	b.rand();
+	DataBlock<double> x = b;
+	Matrix<double> X(n, 1);
+	X.column(0).copy(b.all());
+	std::vector<int> pivots(n);
+	const auto start = std::chrono::steady_clock::now();
+	GBTRF<double> gbtrf;
+	gbtrf(LU, Sequence<int>(pivots.data(), n));
+	GBTRS<double> gbtrs;
+	gbtrs(false, LU.all(), Sequence<int>(pivots.data(), n), X.all());
+	const auto end = std::chrono::steady_clock::now();
+	// r = A * x - b
+	A.all().mul(1, X.column(0), -1, x.all());
+	std::cout << "GBTRF/GBTRS: info=" << gbtrf.info() << " residual=" << x.all().accumulate([](double s, double v) {return std::max(s, std::abs(v)); })
+		<< " time=" << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << std::endl;
+
+	// symmetric positive definite band matrix (lower storage)
+	int kd = kl;
+	BandMatrix<double> S(n, kd, 0);
+	for (int c = 0; c < n; ++c) {
+		Sequence<double> col = S.all().column(c);
+		col.rand();
+		col(0) = 2 * kd + 1;
+	}
+	BandMatrix<double> Ssym(n, kd, kd);
+	for (int c = 0; c < n; ++c) {
+		for (int r = c; r <= std::min(n - 1, c + kd); ++r)
+			Ssym(r, c) = Ssym(c, r) = S(r, c);
+	}
+	X.column(0).copy(b.all());
+	x.all().copy(b.all());
+	PBTRF<double> pbtrf;
+	pbtrf(Triangular::Lower, S);
+	PBTRS<double> pbtrs;
+	pbtrs(Triangular::Lower, S.all(), X.all());
+	Ssym.all().mul(1, X.column(0), -1, x.all());
+	std::cout << "PBTRF/PBTRS: info=" << pbtrf.info() << " residual=" << x.all().accumulate([](double s, double v) {return std::max(s, std::abs(v)); }) << std::endl;
+
+	// invalid dimensions are rejected before the allocation; the diagonals outside of the matrix are empty
+	bool rejected = false;
+	try {
+		BandMatrix<double> bad(n, -kl - 2, ku);
+	}
+	catch (const std::invalid_argument&) {
+		rejected = true;
+	}
+	BandMatrix<double> W(3, 5, 5);
+	std::cout << "BandMatrix: rejected=" << rejected << " diagonal(-4) of 3 x 3 with kl=5: " << W.all().subDiagonal(-4).length()
+		<< " diagonal(3): " << W.all().subDiagonal(3).length() << std::endl;
+}
\ No newline at end of file
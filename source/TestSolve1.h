@@ -13,6 +13,10 @@ public:
 
 	void testGESVXX(int n, int k);
 
+	void testPOSV(int n, int k);
+
+	void testBand(int n, int kl, int ku);
+
 };
 
 #endif
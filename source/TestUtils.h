@@ -0,0 +1,19 @@
+#ifndef __lcpp_testutils_h
+#define __lcpp_testutils_h
+
+#include <cmath>
+#include <algorithm>
+#include "matrix.h"
+
+/// <summary>
+/// max |A(r, c) - B(r, c)| (A and B have the same dimensions)
+/// </summary>
+inline double maxdiff(const NUMCPP::Matrix<double>& A, const NUMCPP::Matrix<double>& B) {
+	double e = 0;
+	for (int c = 0; c < A.getNcols(); ++c)
+		for (int r = 0; r < A.getNrows(); ++r)
+			e = std::max(e, std::abs(A(r, c) - B(r, c)));
+	return e;
+}
+
+#endif
@@ -66,6 +66,39 @@ TestMatrix1::testGEMM(int m, int n, int k, int q) {
 
 void
 TestMatrix1::testTRMM() {
+	int m = 7, n = 5;
 	TRMM<double> trmm;
+	GEMM<double> gemm;
+	Side sides[] = { Side::Left, Side::Right };
+	Triangular uplos[] = { Triangular::Lower, Triangular::Upper };
+	for (Side side : sides) {
+		int na = side == Side::Left ? m : n;
+		Matrix<double> A(na, na, [](int r, int c) { return (double)((r + 1) + 100 * (c + 1)); });
+		Matrix<double> B(m, n, [](int r, int c) { return (double)(25 * (r + 1) - 25 * (c + 1)); });
+		for (Triangular uplo : uplos) {
+			for (int t = 0; t < 2; ++t) {
+				for (int u = 0; u < 2; ++u) {
+					// explicit triangular matrix
+					Matrix<double> Ta(na, na, [&](int r, int c) {
+						if (r == c)
+							return u ? 1.0 : A(r, c);
+						return (uplo == Triangular::Lower ? r > c : r < c) ? A(r, c) : 0.0;
+						});
+					Matrix<double> Bc = B, R(m, n);
+					trmm(side, uplo, t == 1, u == 1, 2, A.all(), Bc.all());
+					if (side == Side::Left)
+						gemm(t == 1, false, 2, Ta, B, 0, R);
+					else
+						gemm(false, t == 1, 2, B, Ta, 0, R);
+					double e = 0;
+					for (int c = 0; c < n; ++c)
+						for (int r = 0; r < m; ++r)
+							e = std::max(e, std::abs(R(r, c) - Bc(r, c)));
+					std::cout << (side == Side::Left ? "left " : "right ") << (uplo == Triangular::Lower ? "lower " : "upper ")
+						<< (t ? "trans " : "") << (u ? "unit " : "") << e << std::endl;
+				}
+			}
+		}
+	}
 }
 
@@ -21,7 +21,7 @@ namespace LCPP {
 
         T operator()(NUMCPP::Sequence<T> X) {
             int incx = X.increment(), n = X.length();
-            return apply(n, X.begin(), incx);
+            return apply(n, X.cstart(), incx);
         }
 
     private:
@@ -32,7 +32,10 @@ namespace LCPP {
 
     template <typename T>
     T ASUM<T>::apply(int n, const T* X, int incx) {
-        // Quick return if possible
+        if constexpr (std::is_same<T, double>::value) {
+            if (incx == 1 && n >= NUMCPP::SIMD::MIN_LENGTH)
+                return NUMCPP::SIMD::asum(n, X);
+        }
         T asum = 0;
         int imax=incx * n;
         for (int i=0; i != imax; i+=incx){
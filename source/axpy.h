@@ -19,7 +19,7 @@ namespace LCPP {
 
 
         void operator()(T a, NUMCPP::Sequence<T> X, NUMCPP::Sequence<T> Y) {
-            apply(Y.length(), a, X.begin(), X.increment(), Y.begin(), Y.increment());
+            apply(Y.length(), a, X.start(), X.increment(), Y.start(), Y.increment());
         }
 
     private:
@@ -32,6 +32,12 @@ namespace LCPP {
     void AXPY<T>::apply(int n, T a, const T* x, int incx, T* y, int incy) {
         if (a == 0)
             return;
+        if constexpr (std::is_same<T, double>::value) {
+            if (incx == 1 && incy == 1 && n >= NUMCPP::SIMD::MIN_LENGTH) {
+                NUMCPP::SIMD::axpy(n, a, x, y);
+                return;
+            }
+        }
         int imax = incx * n;
         if (incx == incy) {
             for (int i = 0; i != imax; i += incx)
@@ -0,0 +1,244 @@
+#ifndef __numcpp_bandmatrix_h
+#define __numcpp_bandmatrix_h
+
+#include <iostream>
+#include <cstdlib>
+#include <algorithm>
+#include <stdexcept>
+#include "sequence.h"
+#include "matrix.h"
+
+namespace NUMCPP {
+
+	template<typename T>
+	class BandMatrix;
+
+	/// <summary>
+	/// View on a square n x n band matrix with kl sub-diagonals and ku super-diagonals,
+	/// stored by columns as in LAPACK: the element (r, c) (max(0, c-ku) <= r <= min(n-1, c+kl))
+	/// is stored at the row ku + r - c of the column c of the band storage (ldab x n).
+	/// The storage may contain "extra" additional super-diagonals (above the band), used by
+	/// the LU factorization (GBTRF) for the fill-in.
+	/// </summary>
+	/// <typeparam name="T"></typeparam>
+	template <typename T>
+	struct FastBandMatrix
+	{
+
+		T& operator()(int r, int c)const {
+			return m_data[m_ku + r - c + m_ldab * c];
+		}
+
+		~FastBandMatrix() {}
+
+		int getNrows() const {
+			return m_n;
+		}
+
+		int getNcols() const {
+			return m_n;
+		}
+
+		int getKl() const {
+			return m_kl;
+		}
+
+		int getKu() const {
+			return m_ku;
+		}
+
+		int getExtra() const {
+			return m_extra;
+		}
+
+		int getColumnIncrement() const {
+			return m_ldab;
+		}
+
+		bool isEmpty() const {
+			return m_n == 0;
+		}
+
+		bool inBand(int r, int c) const {
+			return r - c <= m_kl && c - r <= m_ku;
+		}
+
+		/// <summary>
+		/// Elements of the band in the column col (rows max(0, col-ku) to min(n-1, col+kl)). Contiguous
+		/// </summary>
+		Sequence<T> column(int col) const {
+			int r0 = std::max(0, col - m_ku), r1 = std::min(m_n - 1, col + m_kl);
+			return Sequence<T>(&(*this)(r0, col), r1 - r0 + 1);
+		}
+
+		/// <summary>
+		/// Elements of the band in the row row (columns max(0, row-kl) to min(n-1, row+ku))
+		/// </summary>
+		Sequence<T> row(int row) const {
+			int c0 = std::max(0, row - m_kl), c1 = std::min(m_n - 1, row + m_ku);
+			return Sequence<T>(&(*this)(row, c0), c1 - c0 + 1, m_ldab - 1);
+		}
+
+		Sequence<T> diagonal() const {
+			return subDiagonal(0);
+		}
+
+		/// <summary>
+		/// Elements (i, i+pos). Empty if pos is not in [-kl, ku] or if |pos| >= n
+		/// </summary>
+		Sequence<T> subDiagonal(int pos) const {
+			if (pos > m_ku || -pos > m_kl || std::abs(pos) >= m_n)
+				return Sequence<T>();
+			int r0 = std::max(0, -pos), n = m_n - std::abs(pos);
+			return Sequence<T>(&(*this)(r0, r0 + pos), n, m_ldab);
+		}
+
+		/// <summary>
+		/// Principal sub-matrix of order n, starting at (i0, i0) (same band structure)
+		/// </summary>
+		FastBandMatrix<T> extract(int i0, int n) const {
+			return FastBandMatrix(m_data + m_ldab * i0, m_ldab, n, m_kl, m_ku, m_extra);
+		}
+
+		void set(T value) const;
+
+		/// <summary>
+		/// Computes y = alpha * A * x + beta * y
+		/// </summary>
+		void mul(T alpha, Sequence<T> x, T beta, Sequence<T> y) const;
+
+		template<typename S>
+		friend std::ostream& operator<< (std::ostream& stream, const FastBandMatrix<S>& matrix);
+
+	private:
+
+		FastBandMatrix(T* data, int ldab, int n, int kl, int ku, int extra) :
+			m_data(data), m_ldab(ldab), m_n(n), m_kl(kl), m_ku(ku), m_extra(extra)
+		{ }
+
+		// m_data points to the first element of the band (after the extra rows)
+		T* m_data;
+		int m_ldab, m_n, m_kl, m_ku, m_extra;
+
+		friend BandMatrix<T>;
+	};
+
+	/// <summary>
+	/// Square band matrix (see FastBandMatrix for the storage). The memory used is (extra + kl + ku + 1) * n
+	/// </summary>
+	/// <typeparam name="T"></typeparam>
+	template<typename T>
+	class BandMatrix
+	{
+	public:
+
+		BandMatrix(int n, int kl, int ku, int extra = 0);
+
+		/// <summary>
+		/// Band part of a dense square matrix
+		/// </summary>
+		BandMatrix(const FastMatrix<T>& M, int kl, int ku, int extra = 0);
+
+		FastBandMatrix<T> all() const {
+			return FastBandMatrix<T>(m_storage.all().ptr() + m_extra, m_storage.getNrows(), m_n, m_kl, m_ku, m_extra);
+		}
+
+		/// <summary>
+		/// The band storage (including the extra rows)
+		/// </summary>
+		FastMatrix<T> storage() const {
+			return m_storage.all();
+		}
+
+		int getNrows() const {
+			return m_n;
+		}
+
+		int getNcols() const {
+			return m_n;
+		}
+
+		T& operator()(int r, int c) const {
+			return all()(r, c);
+		}
+
+		Matrix<T> toMatrix() const;
+
+	private:
+
+		// checks the dimensions (before the allocation of the storage) and returns the number of rows of the storage
+		static int storageRows(int n, int kl, int ku, int extra);
+
+		Matrix<T> m_storage;
+		int m_n, m_kl, m_ku, m_extra;
+	};
+
+	template<typename T>
+	int BandMatrix<T>::storageRows(int n, int kl, int ku, int extra) {
+		if (n < 0 || kl < 0 || ku < 0 || extra < 0)
+			throw std::invalid_argument("invalid dimensions in BandMatrix");
+		return extra + kl + ku + 1;
+	}
+
+	template<typename T>
+	BandMatrix<T>::BandMatrix(int n, int kl, int ku, int extra)
+		:m_storage(storageRows(n, kl, ku, extra), n), m_n(n), m_kl(kl), m_ku(ku), m_extra(extra) {
+		m_storage = NUMCPP::CONSTANTS<T>::zero;
+	}
+
+	template<typename T>
+	BandMatrix<T>::BandMatrix(const FastMatrix<T>& M, int kl, int ku, int extra)
+		:BandMatrix(M.getNrows(), kl, ku, extra) {
+		if (!M.isSquare())
+			throw std::invalid_argument("invalid dimensions in BandMatrix");
+		FastBandMatrix<T> B = all();
+		for (int c = 0; c < m_n; ++c) {
+			int r0 = std::max(0, c - ku), r1 = std::min(m_n - 1, c + kl);
+			for (int r = r0; r <= r1; ++r)
+				B(r, c) = M(r, c);
+		}
+	}
+
+	template<typename T>
+	Matrix<T> BandMatrix<T>::toMatrix() const {
+		FastBandMatrix<T> B = all();
+		return Matrix<T>(m_n, m_n, [&](int r, int c) {return B.inBand(r, c) ? B(r, c) : NUMCPP::CONSTANTS<T>::zero; });
+	}
+
+	template<typename T>
+	void FastBandMatrix<T>::set(T value) const {
+		for (int c = 0; c < m_n; ++c)
+			column(c).set(value);
+	}
+
+	template<typename T>
+	void FastBandMatrix<T>::mul(T alpha, Sequence<T> x, T beta, Sequence<T> y) const {
+		T zero = NUMCPP::CONSTANTS<T>::zero;
+		if (beta == zero)
+			y.set(zero);
+		else
+			y.mul(beta);
+		if (alpha == zero)
+			return;
+		for (int c = 0; c < m_n; ++c) {
+			int r0 = std::max(0, c - m_ku);
+			Sequence<T> col = column(c);
+			y.extract(r0, col.length()).addAY(alpha * x(c), col);
+		}
+	}
+
+	template<typename T>
+	std::ostream& operator<< (std::ostream& stream, const FastBandMatrix<T>& matrix) {
+		for (int i = 0; i < matrix.m_n; ++i) {
+			for (int j = 0; j < matrix.m_n; ++j) {
+				if (j > 0)
+					stream << '\t';
+				stream << (matrix.inBand(i, j) ? matrix(i, j) : NUMCPP::CONSTANTS<T>::zero);
+			}
+			stream << "\n\r";
+		}
+		return stream;
+	}
+}
+
+#endif
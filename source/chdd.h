@@ -0,0 +1,100 @@
+#ifndef __lcpp_chdd_h
+#define __lcpp_chdd_h
+
+#include <vector>
+#include <stdexcept>
+#include "matrix.h"
+#include "matrix_0.h"
+#include "dot.h"
+#include "rot.h"
+
+namespace LCPP {
+    /// <summary>
+    /// Downdates a Cholesky factorization A = L * L' or A = U' * U after a rank one modification
+    /// A~ = A - x * x'.
+    /// The method of LINPACK (dchdd) is used: p is the solution of L * p = x (U' * p = x),
+    /// rho = sqrt(1 - p'p); the plane rotations that annihilate p against rho are then applied (ROT)
+    /// to the columns of L (the rows of U), in O(n^2) operations.
+    /// info() = 0 on success, or 1 if A~ is not positive definite. In that case, A is unchanged.
+    /// </summary>
+    /// <typeparam name="T"></typeparam>
+    template <typename T>
+    class CHDD {
+    public:
+
+        CHDD() :m_info(0) {}
+
+        void operator()(Triangular uplo, NUMCPP::FastMatrix<T> A, NUMCPP::Sequence<T> x);
+
+        int info() const {
+            return m_info;
+        }
+
+    private:
+
+        std::vector<T> m_p, m_c, m_s, m_w;
+        int m_info;
+    };
+
+    template <typename T>
+    void CHDD<T>::operator()(Triangular uplo, NUMCPP::FastMatrix<T> A, NUMCPP::Sequence<T> x) {
+        if (!A.isSquare() || A.getNrows() != x.length())
+            throw std::invalid_argument("invalid dimensions in CHDD");
+        m_info = 0;
+        int n = A.getNrows();
+        if (n == 0)
+            return;
+        T zero = NUMCPP::CONSTANTS<T>::zero, one = NUMCPP::CONSTANTS<T>::one;
+        m_p.resize(n);
+        m_c.resize(n);
+        m_s.resize(n);
+        m_w.assign(n, zero);
+        x.copyTo(m_p.data());
+        T* p = m_p.data();
+        int lda = A.getColumnIncrement();
+        T* a = A.ptr();
+        bool lower = uplo == Triangular::Lower;
+        // Solve L * p = x (or U' * p = x)
+        for (int k = 0; k < n; ++k) {
+            const T* ak = a + k * lda;
+            if (lower) {
+                T pk = p[k] / ak[k];
+                p[k] = pk;
+                for (int i = k + 1; i < n; ++i)
+                    p[i] -= pk * ak[i];
+            }
+            else {
+                DOT<T, T> dot;
+                p[k] = (p[k] - dot(k, ak, p)) / ak[k];
+            }
+        }
+        T pp = zero;
+        for (int k = 0; k < n; ++k)
+            pp += p[k] * p[k];
+        T rho2 = one - pp;
+        if (!(rho2 > zero)) {
+            m_info = 1;
+            return;
+        }
+        T rho = std::sqrt(rho2);
+        // rotations annihilating p(n-1), ..., p(0) against rho
+        for (int i = n - 1; i >= 0; --i) {
+            T r = std::hypot(rho, p[i]);
+            m_c[i] = rho / r;
+            m_s[i] = p[i] / r;
+            rho = r;
+        }
+        // [w ; L(i:n, i)] <- G(i) * [w ; L(i:n, i)], i = n-1, ..., 0 (rows of U in the upper case)
+        ROT<T> rot;
+        T* w = m_w.data();
+        for (int i = n - 1; i >= 0; --i) {
+            T* aii = a + i * (lda + 1);
+            if (lower)
+                rot(n - i, w + i, aii, m_c[i], m_s[i]);
+            else
+                rot(n - i, w + i, 1, aii, lda, m_c[i], m_s[i]);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,61 @@
+#ifndef __lcpp_chud_h
+#define __lcpp_chud_h
+
+#include <vector>
+#include <stdexcept>
+#include "matrix.h"
+#include "matrix_0.h"
+#include "rot.h"
+
+namespace LCPP {
+    /// <summary>
+    /// Updates a Cholesky factorization A = L * L' or A = U' * U after a rank one modification
+    /// A~ = A + x * x'.
+    /// The factor is modified in O(n^2) operations by a sequence of plane rotations (ROT) that
+    /// annihilate x against the columns of L (the rows of U).
+    /// </summary>
+    /// <typeparam name="T"></typeparam>
+    template <typename T>
+    class CHUD {
+    public:
+
+        CHUD() {}
+
+        void operator()(Triangular uplo, NUMCPP::FastMatrix<T> A, NUMCPP::Sequence<T> x);
+
+    private:
+
+        std::vector<T> m_x;
+    };
+
+    template <typename T>
+    void CHUD<T>::operator()(Triangular uplo, NUMCPP::FastMatrix<T> A, NUMCPP::Sequence<T> x) {
+        if (!A.isSquare() || A.getNrows() != x.length())
+            throw std::invalid_argument("invalid dimensions in CHUD");
+        int n = A.getNrows();
+        if (n == 0)
+            return;
+        T zero = NUMCPP::CONSTANTS<T>::zero;
+        m_x.resize(n);
+        x.copyTo(m_x.data());
+        T* px = m_x.data();
+        int lda = A.getColumnIncrement();
+        T* a = A.ptr();
+        ROT<T> rot;
+        for (int k = 0; k < n; ++k) {
+            T* akk = a + k * (lda + 1);
+            T xk = px[k];
+            if (xk == zero)
+                continue;
+            T r = std::hypot(*akk, xk);
+            T c = *akk / r, s = xk / r;
+            // [A(k:n, k) ; x(k:n)] (or [A(k, k:n) ; x(k:n)]) <- G * [A ; x]
+            if (uplo == Triangular::Lower)
+                rot(n - k, akk, px + k, c, s);
+            else
+                rot(n - k, akk, lda, px + k, 1, c, s);
+        }
+    }
+}
+
+#endif
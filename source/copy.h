@@ -30,6 +30,10 @@ namespace LCPP {
 
     template <typename T>
     void COPY<T>::apply(int n, const T* X, int incx, T* Y, int incy) {
+        if (incx == 1 && incy == 1) {
+            apply(n, X, Y);
+            return;
+        }
         int imax = incx * n;
         for (int i = 0, j = 0; i != imax; i += incx, j += incy) {
             Y[j] = X[i];
@@ -38,6 +42,12 @@ namespace LCPP {
 
     template <typename T>
     void COPY<T>::apply(int n, const T* X, T* Y) {
+        if constexpr (std::is_same<T, double>::value) {
+            if (n >= NUMCPP::SIMD::MIN_LENGTH) {
+                NUMCPP::SIMD::copy(n, X, Y);
+                return;
+            }
+        }
          for (int i = 0; i != n; ++i)
             Y[i] = X[i];
     }
@@ -36,6 +36,10 @@ namespace LCPP {
 
     template <typename T, typename S>
     S DOT<T, S>::apply(int n, const T* X, const T* Y) {
+        if constexpr (std::is_same<T, double>::value && std::is_same<S, double>::value) {
+            if (n >= NUMCPP::SIMD::MIN_LENGTH)
+                return NUMCPP::SIMD::dot(n, X, Y);
+        }
         S dot = NUMCPP::CONSTANTS<S>::zero;
         for (int i = 0; i < n; ++i)
             dot += X[i] * Y[i];
@@ -45,6 +49,8 @@ namespace LCPP {
     template <typename T, typename S>
     S DOT<T, S>::apply(int n, const T* X, int incx, const T* Y, int incy) {
         S dot = NUMCPP::CONSTANTS<S>::zero;
+        if (incx == 1 && incy == 1)
+            return apply(n, X, Y);
         int imax = incx * n;
         if (incx == incy)
             for (int i = 0; i != imax; i += incx)
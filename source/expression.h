@@ -0,0 +1,364 @@
+#ifndef __numcpp_expression_h
+#define __numcpp_expression_h
+
+#include <type_traits>
+#include <stdexcept>
+#include <cmath>
+#include "sequence.h"
+
+namespace NUMCPP {
+
+    /// <summary>
+    /// Lazy arithmetic on sequences. x + y, a * x, x - y / b... build a light expression object
+    /// (pointers and scalars) instead of a temporary sequence. The expression is evaluated element
+    /// by element, in one loop, when it is assigned to a sequence (y = a * x + b * y - z) or reduced
+    /// ((x - y).ssq()). When all the sequences of the expression have a unit stride, the loop uses
+    /// plain indices, so that it can be vectorized.
+    /// An element of the target may appear in the expression only at the same position (y = 2 * y is
+    /// fine, y = y.reverse() is not).
+    /// </summary>
+    /// <typeparam name="E">Actual expression type (CRTP)</typeparam>
+    template <class E>
+    struct Expr {
+
+        const E& self() const {
+            return static_cast<const E&>(*this);
+        }
+
+        auto sum() const {
+            return reduce([](auto x) {return x; });
+        }
+
+        auto asum() const {
+            return reduce([](auto x) {return std::abs(x); });
+        }
+
+        auto ssq() const {
+            return reduce([](auto x) {return x * x; });
+        }
+
+        template <class Fn>
+        auto reduce(Fn fn) const;
+    };
+
+    /// <summary>
+    /// Leaf of an expression: a sequence
+    /// </summary>
+    template <typename T>
+    struct SequenceExpr : public Expr<SequenceExpr<T>> {
+
+        typedef T value_type;
+
+        SequenceExpr(const Sequence<T>& s) :m_data(s.cstart()), m_inc(s.increment()), m_n(s.length()) {}
+
+        int length() const {
+            return m_n;
+        }
+
+        bool unit() const {
+            return m_inc == 1;
+        }
+
+        T at(int i) const {
+            return m_data[i * m_inc];
+        }
+
+        T at1(int i) const {
+            return m_data[i];
+        }
+
+    private:
+
+        const T* m_data;
+        int m_inc, m_n;
+    };
+
+    /// <summary>
+    /// Leaf of an expression: a contiguous sequence (unit stride known at compile time)
+    /// </summary>
+    template <typename T>
+    struct ContiguousExpr : public Expr<ContiguousExpr<T>> {
+
+        typedef T value_type;
+
+        ContiguousExpr(const ContiguousSequence<T>& s) :m_data(s.cstart()), m_n(s.length()) {}
+
+        int length() const {
+            return m_n;
+        }
+
+        bool unit() const {
+            return true;
+        }
+
+        T at(int i) const {
+            return m_data[i];
+        }
+
+        T at1(int i) const {
+            return m_data[i];
+        }
+
+    private:
+
+        const T* m_data;
+        int m_n;
+    };
+
+    /// <summary>
+    /// Leaf of an expression: a scalar (no length)
+    /// </summary>
+    template <typename T>
+    struct ScalarExpr : public Expr<ScalarExpr<T>> {
+
+        typedef T value_type;
+
+        ScalarExpr(T value) :m_value(value) {}
+
+        int length() const {
+            return -1;
+        }
+
+        bool unit() const {
+            return true;
+        }
+
+        T at(int) const {
+            return m_value;
+        }
+
+        T at1(int) const {
+            return m_value;
+        }
+
+    private:
+
+        T m_value;
+    };
+
+    struct ExprPlus {
+        template <typename T>
+        static T apply(T l, T r) { return l + r; }
+    };
+
+    struct ExprMinus {
+        template <typename T>
+        static T apply(T l, T r) { return l - r; }
+    };
+
+    struct ExprMul {
+        template <typename T>
+        static T apply(T l, T r) { return l * r; }
+    };
+
+    struct ExprDiv {
+        template <typename T>
+        static T apply(T l, T r) { return l / r; }
+    };
+
+    template <class L, class R, class Op>
+    struct BinaryExpr : public Expr<BinaryExpr<L, R, Op>> {
+
+        typedef typename L::value_type value_type;
+
+        BinaryExpr(const L& l, const R& r) :m_l(l), m_r(r) {
+            int nl = l.length(), nr = r.length();
+            if (nl >= 0 && nr >= 0 && nl != nr)
+                throw std::invalid_argument("Sequences of different lengths");
+        }
+
+        int length() const {
+            int nl = m_l.length();
+            return nl >= 0 ? nl : m_r.length();
+        }
+
+        bool unit() const {
+            return m_l.unit() && m_r.unit();
+        }
+
+        value_type at(int i) const {
+            return Op::apply(m_l.at(i), m_r.at(i));
+        }
+
+        value_type at1(int i) const {
+            return Op::apply(m_l.at1(i), m_r.at1(i));
+        }
+
+    private:
+
+        L m_l;
+        R m_r;
+    };
+
+    template <class E>
+    struct NegateExpr : public Expr<NegateExpr<E>> {
+
+        typedef typename E::value_type value_type;
+
+        NegateExpr(const E& e) :m_e(e) {}
+
+        int length() const {
+            return m_e.length();
+        }
+
+        bool unit() const {
+            return m_e.unit();
+        }
+
+        value_type at(int i) const {
+            return -m_e.at(i);
+        }
+
+        value_type at1(int i) const {
+            return -m_e.at1(i);
+        }
+
+    private:
+
+        E m_e;
+    };
+
+    template <class X, class = void>
+    struct ExprTraits {
+        static const bool is_expr = false;
+    };
+
+    template <typename T>
+    struct ExprTraits<Sequence<T>> {
+        static const bool is_expr = true;
+        typedef T value_type;
+    };
+
+    template <typename T>
+    struct ExprTraits<ContiguousSequence<T>> {
+        static const bool is_expr = true;
+        typedef T value_type;
+    };
+
+    template <class E>
+    struct ExprTraits<E, typename std::enable_if<std::is_base_of<Expr<E>, E>::value>::type> {
+        static const bool is_expr = true;
+        typedef typename E::value_type value_type;
+    };
+
+    template <typename T>
+    SequenceExpr<T> toExpr(const Sequence<T>& s) {
+        return SequenceExpr<T>(s);
+    }
+
+    template <typename T>
+    ContiguousExpr<T> toExpr(const ContiguousSequence<T>& s) {
+        return ContiguousExpr<T>(s);
+    }
+
+    template <typename T, class E>
+    const E& toExpr(const Expr<E>& e) {
+        return e.self();
+    }
+
+    template <typename T>
+    ScalarExpr<T> toExpr(T value) {
+        return ScalarExpr<T>(value);
+    }
+
+    template <class Op, class L, class R>
+    auto binaryExpr(const L& l, const R& r) {
+        typedef typename std::conditional<ExprTraits<L>::is_expr, ExprTraits<L>, ExprTraits<R>>::type::value_type T;
+        auto el = toExpr<T>(l);
+        auto er = toExpr<T>(r);
+        return BinaryExpr<decltype(el), decltype(er), Op>(el, er);
+    }
+
+    template <class L, class R>
+    using enable_expr = typename std::enable_if<ExprTraits<L>::is_expr || ExprTraits<R>::is_expr, int>::type;
+
+    template <class L, class R, enable_expr<L, R> = 0>
+    auto operator+(const L& l, const R& r) {
+        return binaryExpr<ExprPlus>(l, r);
+    }
+
+    template <class L, class R, enable_expr<L, R> = 0>
+    auto operator-(const L& l, const R& r) {
+        return binaryExpr<ExprMinus>(l, r);
+    }
+
+    template <class L, class R, enable_expr<L, R> = 0>
+    auto operator*(const L& l, const R& r) {
+        return binaryExpr<ExprMul>(l, r);
+    }
+
+    template <class L, class R, enable_expr<L, R> = 0>
+    auto operator/(const L& l, const R& r) {
+        return binaryExpr<ExprDiv>(l, r);
+    }
+
+    template <class X, enable_expr<X, X> = 0>
+    auto operator-(const X& x) {
+        auto e = toExpr<typename ExprTraits<X>::value_type>(x);
+        return NegateExpr<decltype(e)>(e);
+    }
+
+    template <class E>
+    template <class Fn>
+    auto Expr<E>::reduce(Fn fn) const {
+        typedef typename E::value_type T;
+        const E& e = self();
+        int n = e.length();
+        // independent partial sums, in lanes that the compiler can map on vector registers
+        const int LANES = 8;
+        T acc[LANES] = {};
+        int i = 0;
+        if (e.unit()) {
+            for (; i + LANES <= n; i += LANES)
+                for (int j = 0; j < LANES; ++j)
+                    acc[j] += fn(e.at1(i + j));
+        }
+        for (; i < n; ++i)
+            acc[0] += fn(e.at(i));
+        return ((acc[0] + acc[1]) + (acc[2] + acc[3])) + ((acc[4] + acc[5]) + (acc[6] + acc[7]));
+    }
+
+    struct ExprAssign {
+        template <typename T>
+        static T apply(T, T r) { return r; }
+    };
+
+    template <typename T>
+    template <class Op, class E>
+    void Sequence<T>::evaluate(const E& e)const {
+        if (e.length() != m_n)
+            throw std::invalid_argument("Sequences of different lengths");
+        T* y = m_data;
+        if (m_inc == 1 && e.unit()) {
+            for (int i = 0; i < m_n; ++i)
+                y[i] = Op::apply(y[i], e.at1(i));
+        }
+        else {
+            for (int i = 0, j = 0; i < m_n; ++i, j += m_inc)
+                y[j] = Op::apply(y[j], e.at(i));
+        }
+    }
+
+    template <typename T>
+    template <class E>
+    const Sequence<T>& Sequence<T>::operator=(const Expr<E>& expr)const {
+        evaluate<ExprAssign>(expr.self());
+        return *this;
+    }
+
+    template <typename T>
+    template <class E>
+    const Sequence<T>& Sequence<T>::operator+=(const Expr<E>& expr)const {
+        evaluate<ExprPlus>(expr.self());
+        return *this;
+    }
+
+    template <typename T>
+    template <class E>
+    const Sequence<T>& Sequence<T>::operator-=(const Expr<E>& expr)const {
+        evaluate<ExprMinus>(expr.self());
+        return *this;
+    }
+}
+
+#endif
@@ -0,0 +1,96 @@
+#ifndef __lcpp_gbtrf_h
+#define __lcpp_gbtrf_h
+
+#include <stdexcept>
+#include "bandmatrix.h"
+#include "iamax.h"
+
+namespace LCPP {
+	/// <summary>
+	/// Computes an LU factorization of a real n x n band matrix A (kl sub-diagonals, ku super-diagonals)
+	/// using partial pivoting with row interchanges.
+	/// The factorization has the form A = P * L * U, where P is a permutation matrix,
+	/// L is unit lower triangular with at most kl sub-diagonals (stored in place of the sub-diagonals of A,
+	/// without the permutations) and U is upper triangular with kl + ku super-diagonals.
+	/// A must provide at least kl extra super-diagonals for the fill-in (BandMatrix(n, kl, ku, kl)).
+	/// pivots(j) (0-based) is the row interchanged with the row j.
+	/// The work is O(n * kl * (kl + ku)).
+	/// info() = 0 on success, or k > 0 if U(k-1, k-1) is exactly zero (the factorization is completed,
+	/// but U is singular).
+	/// </summary>
+	/// <typeparam name="T"></typeparam>
+	template<typename T>
+	class GBTRF {
+	public:
+
+		GBTRF() :m_info(0) {}
+
+		void operator()(NUMCPP::FastBandMatrix<T> A, NUMCPP::Sequence<int> pivots);
+		void operator()(NUMCPP::BandMatrix<T>& A, NUMCPP::Sequence<int> pivots) {
+			(*this)(A.all(), pivots);
+		}
+
+		int info() const {
+			return m_info;
+		}
+
+	private:
+
+		int m_info;
+	};
+
+	template<typename T>
+	void GBTRF<T>::operator()(NUMCPP::FastBandMatrix<T> A, NUMCPP::Sequence<int> pivots) {
+		int n = A.getNrows(), kl = A.getKl(), ku = A.getKu();
+		if (A.getExtra() < kl)
+			throw std::invalid_argument("missing storage for the fill-in in GBTRF");
+		if (pivots.length() < n)
+			throw std::invalid_argument("invalid pivots in GBTRF");
+		m_info = 0;
+		T zero = NUMCPP::CONSTANTS<T>::zero, one = NUMCPP::CONSTANTS<T>::one;
+		IAMAX<T> iamax;
+		// clear the fill-in (super-diagonals ku+1, ..., ku+kl)
+		for (int j = ku + 1; j < n; ++j) {
+			int i0 = std::max(0, j - ku - kl);
+			for (int i = i0; i < j - ku; ++i)
+				A(i, j) = zero;
+		}
+		int ldab = A.getColumnIncrement();
+		// last column affected by the current row interchanges
+		int ju = 0;
+		for (int j = 0; j < n; ++j) {
+			int km = std::min(kl, n - 1 - j);
+			// pivot: max |A(j:j+km, j)| (contiguous)
+			T* col = &A(j, j);
+			int jp = iamax(km + 1, col);
+			pivots(j) = j + jp;
+			if (col[jp] == zero) {
+				if (m_info == 0)
+					m_info = j + 1;
+				continue;
+			}
+			ju = std::max(ju, std::min(j + ku + jp, n - 1));
+			if (jp != 0) {
+				// interchange the rows j and j+jp on the columns j:ju
+				NUMCPP::Sequence<T>(&A(j, j), ju - j + 1, ldab - 1).swap(NUMCPP::Sequence<T>(&A(j + jp, j), ju - j + 1, ldab - 1));
+			}
+			if (km == 0)
+				continue;
+			// L(j+1:j+km, j) = A(j+1:j+km, j) / U(j,j)
+			T r = one / col[0];
+			for (int i = 1; i <= km; ++i)
+				col[i] *= r;
+			// A(j+1:j+km, j+1:ju) -= L(j+1:j+km, j) * U(j, j+1:ju), by columns
+			for (int c = j + 1; c <= ju; ++c) {
+				T ujc = -A(j, c);
+				if (ujc == zero)
+					continue;
+				T* ac = &A(j + 1, c);
+				for (int i = 1; i <= km; ++i)
+					ac[i - 1] += ujc * col[i];
+			}
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,88 @@
+#ifndef __lcpp_gbtrs_h
+#define __lcpp_gbtrs_h
+
+#include <stdexcept>
+#include "bandmatrix.h"
+#include "dot.h"
+
+namespace LCPP {
+	/// <summary>
+	/// Solves a system of linear equations A * X = B or A' * X = B with a general n x n band matrix A
+	/// using the LU factorization computed by GBTRF.
+	/// B is overwritten by the solution. The work is O(n * (2 * kl + ku)) for each right-hand side.
+	/// </summary>
+	/// <typeparam name="T"></typeparam>
+	template<typename T>
+	class GBTRS {
+	public:
+
+		GBTRS() {}
+
+		void operator()(bool tA, NUMCPP::FastBandMatrix<T> A, NUMCPP::Sequence<int> pivots, NUMCPP::FastMatrix<T> B);
+
+	private:
+
+		void solve(NUMCPP::FastBandMatrix<T>& A, NUMCPP::Sequence<int>& pivots, T* b);
+		void tsolve(NUMCPP::FastBandMatrix<T>& A, NUMCPP::Sequence<int>& pivots, T* b);
+	};
+
+	template<typename T>
+	void GBTRS<T>::operator()(bool tA, NUMCPP::FastBandMatrix<T> A, NUMCPP::Sequence<int> pivots, NUMCPP::FastMatrix<T> B) {
+		if (A.getNrows() != B.getNrows() || A.getExtra() < A.getKl())
+			throw std::invalid_argument("invalid dimensions in GBTRS");
+		NUMCPP::SequenceIterator<T> cols = B.columnsIterator();
+		while (cols.hasNext()) {
+			T* b = cols.next().start();
+			if (tA)
+				tsolve(A, pivots, b);
+			else
+				solve(A, pivots, b);
+		}
+	}
+
+	template<typename T>
+	void GBTRS<T>::solve(NUMCPP::FastBandMatrix<T>& A, NUMCPP::Sequence<int>& pivots, T* b) {
+		int n = A.getNrows(), kl = A.getKl(), kv = A.getKl() + A.getKu();
+		// L * y = P' * b
+		for (int j = 0; j < n - 1; ++j) {
+			int lm = std::min(kl, n - 1 - j);
+			int l = pivots(j);
+			if (l != j)
+				std::swap(b[l], b[j]);
+			T bj = b[j];
+			const T* lj = &A(j + 1, j);
+			for (int i = 0; i < lm; ++i)
+				b[j + 1 + i] -= bj * lj[i];
+		}
+		// U * x = y
+		for (int j = n - 1; j >= 0; --j) {
+			T bj = b[j] / A(j, j);
+			b[j] = bj;
+			int km = std::min(kv, j);
+			const T* u = &A(j - km, j);
+			for (int i = 0; i < km; ++i)
+				b[j - km + i] -= bj * u[i];
+		}
+	}
+
+	template<typename T>
+	void GBTRS<T>::tsolve(NUMCPP::FastBandMatrix<T>& A, NUMCPP::Sequence<int>& pivots, T* b) {
+		int n = A.getNrows(), kl = A.getKl(), kv = A.getKl() + A.getKu();
+		DOT<T, T> dot;
+		// U' * y = b
+		for (int j = 0; j < n; ++j) {
+			int km = std::min(kv, j);
+			b[j] = (b[j] - dot(km, &A(j - km, j), b + j - km)) / A(j, j);
+		}
+		// L' * P' * x = y
+		for (int j = n - 2; j >= 0; --j) {
+			int lm = std::min(kl, n - 1 - j);
+			b[j] -= dot(lm, &A(j + 1, j), b + j + 1);
+			int l = pivots(j);
+			if (l != j)
+				std::swap(b[l], b[j]);
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef __lcpp_gebak_h
+#define __lcpp_gebak_h
+
+#include <algorithm>
+#include <stdexcept>
+#include "matrix.h"
+#include "matrix_0.h"
+#include "gebal.h"
+
+namespace LCPP {
+	/// <summary>
+	/// Forms the right or left eigenvectors of a real general matrix by backward transformation on the
+	/// computed eigenvectors V (n x m) of the balanced matrix output by GEBAL:
+	///     Right: V = P * D * V
+	///     Left:  V = P * inv(D) * V
+	/// job, ilo, ihi and scale must be the ones used/returned by GEBAL.
+	/// V is updated column by column: the scaling is an element-wise product with scale(ilo:ihi) and
+	/// the interchanges of rows are applied to each column in turn.
+	/// </summary>
+	/// <typeparam name="T"></typeparam>
+	template<typename T>
+	class GEBAK {
+	public:
+
+		GEBAK() {}
+
+		void operator()(Balancing job, Side side, int ilo, int ihi, NUMCPP::Sequence<T> scale, NUMCPP::FastMatrix<T> V);
+		void operator()(Balancing job, Side side, int ilo, int ihi, NUMCPP::Sequence<T> scale, NUMCPP::Matrix<T>& V) {
+			(*this)(job, side, ilo, ihi, scale, V.all());
+		}
+	};
+
+	template<typename T>
+	void GEBAK<T>::operator()(Balancing job, Side side, int ilo, int ihi, NUMCPP::Sequence<T> scale, NUMCPP::FastMatrix<T> V) {
+		int n = V.getNrows(), m = V.getNcols();
+		if (ilo < 0 || ilo > std::max(0, n - 1) || ihi < std::min(ilo, n - 1) || ihi >= n || scale.length() < n)
+			throw std::invalid_argument("Invalid arguments in gebak");
+		if (n == 0 || m == 0 || job == BalanceNone)
+			return;
+		if (ilo != ihi && (job == BalanceScale || job == BalanceBoth)) {
+			for (int c = 0; c < m; ++c) {
+				T* col = &V(0, c);
+				if (side == Side::Right) {
+					for (int r = ilo; r <= ihi; ++r)
+						col[r] *= scale(r);
+				}
+				else {
+					for (int r = ilo; r <= ihi; ++r)
+						col[r] /= scale(r);
+				}
+			}
+		}
+		if (job == BalancePermute || job == BalanceBoth) {
+			for (int c = 0; c < m; ++c) {
+				T* col = &V(0, c);
+				for (int i = ilo - 1; i >= 0; --i) {
+					int k = (int)scale(i);
+					if (k != i)
+						std::swap(col[i], col[k]);
+				}
+				for (int i = ihi + 1; i < n; ++i) {
+					int k = (int)scale(i);
+					if (k != i)
+						std::swap(col[i], col[k]);
+				}
+			}
+		}
+	}
+}
+
+#endif
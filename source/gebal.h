@@ -1 +1,303 @@
-#pragma once
+#ifndef __lcpp_gebal_h
+#define __lcpp_gebal_h
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <stdexcept>
+#include "matrix.h"
+#include "matrix_0.h"
+
+namespace LCPP {
+
+	/// <summary>
+	/// Operations done by GEBAL (and undone by GEBAK)
+	/// </summary>
+	enum Balancing {
+		BalanceNone, BalancePermute, BalanceScale, BalanceBoth
+	};
+
+	/// <summary>
+	/// Balances a general real matrix A (n x n). Balancing may reduce the 1-norm of the matrix and
+	/// improve the accuracy and the convergence of the computed eigenvalues.
+	/// 1. Permutation: rows and columns are permuted to isolate eigenvalues, so that A becomes
+	///         ( T1   X   Y  )
+	///         (  0   B   Z  )       T1, T2 upper triangular; B = A(ilo:ihi, ilo:ihi)
+	///         (  0   0   T2 )
+	/// 2. Scaling: a diagonal similarity D is applied to B, to make its rows and columns as close
+	///    in norm as possible (by powers of the radix, so that no rounding error is introduced).
+	/// On exit, A is overwritten by the balanced matrix, ilo and ihi (0-based, inclusive) are available
+	/// through ilo() and ihi(), and scale (n elements) contains the details of the transformation:
+	///     scale(j) = P(j)  for j < ilo or j > ihi, P(j) being the index of the row and column interchanged with j
+	///     scale(j) = D(j)  for ilo <= j <= ihi
+	/// The isolation tests use counts of the off-diagonal non-zero elements of the rows and of the columns,
+	/// which are updated when a row or a column leaves the active block. The row norms of the scaling are
+	/// computed for all the rows at the beginning of each sweep, by a pass on the (contiguous) columns,
+	/// and are updated when a column is scaled; the row scalings are applied column by column.
+	/// Thus, the norms never require a scan of A along its rows.
+	/// </summary>
+	/// <typeparam name="T"></typeparam>
+	template<typename T>
+	class GEBAL {
+	public:
+
+		GEBAL() :m_ilo(0), m_ihi(-1) {}
+
+		void operator()(Balancing job, NUMCPP::FastMatrix<T> A, NUMCPP::Sequence<T> scale);
+		void operator()(NUMCPP::FastMatrix<T> A, NUMCPP::Sequence<T> scale) {
+			(*this)(BalanceBoth, A, scale);
+		}
+		void operator()(NUMCPP::Matrix<T>& A, NUMCPP::Sequence<T> scale) {
+			(*this)(BalanceBoth, A.all(), scale);
+		}
+
+		int ilo() const {
+			return m_ilo;
+		}
+
+		int ihi() const {
+			return m_ihi;
+		}
+
+	private:
+
+		void permute(NUMCPP::FastMatrix<T> A, NUMCPP::Sequence<T> scale);
+		void scale(NUMCPP::FastMatrix<T> A, NUMCPP::Sequence<T> scale);
+		static void swap(NUMCPP::FastMatrix<T> A, int j, int m, int ilo, int ihi);
+
+		int m_ilo, m_ihi;
+		// number of non-zero off-diagonal elements of the rows/columns of the active block
+		std::vector<int> m_count;
+		// row norms (max and scaled sum of squares)
+		std::vector<T> m_rmax, m_rssq;
+	};
+
+	template<typename T>
+	void GEBAL<T>::operator()(Balancing job, NUMCPP::FastMatrix<T> A, NUMCPP::Sequence<T> scale) {
+		int n = A.getNrows();
+		if (!A.isSquare())
+			throw std::invalid_argument("Not square matrix in gebal");
+		if (scale.length() < n)
+			throw std::invalid_argument("Invalid arguments in gebal");
+		m_ilo = 0;
+		m_ihi = n - 1;
+		if (n == 0)
+			return;
+		T one = NUMCPP::CONSTANTS<T>::one;
+		if (job == BalanceNone) {
+			scale.left(n).set(one);
+			return;
+		}
+		if (job == BalancePermute || job == BalanceBoth)
+			permute(A, scale);
+		scale.extract(m_ilo, m_ihi - m_ilo + 1).set(one);
+		if (job == BalanceScale || job == BalanceBoth)
+			this->scale(A, scale);
+	}
+
+	template<typename T>
+	void GEBAL<T>::swap(NUMCPP::FastMatrix<T> A, int j, int m, int ilo, int ihi) {
+		if (j == m)
+			return;
+		int n = A.getNrows();
+		// columns j and m (rows 0 to ihi)
+		T* cj = &A(0, j), * cm = &A(0, m);
+		for (int r = 0; r <= ihi; ++r)
+			std::swap(cj[r], cm[r]);
+		// rows j and m (columns ilo to n-1)
+		for (int c = ilo; c < n; ++c) {
+			T* col = &A(0, c);
+			std::swap(col[j], col[m]);
+		}
+	}
+
+	template<typename T>
+	void GEBAL<T>::permute(NUMCPP::FastMatrix<T> A, NUMCPP::Sequence<T> scale) {
+		int n = A.getNrows();
+		T zero = NUMCPP::CONSTANTS<T>::zero;
+		int ilo = 0, ihi = n - 1;
+		m_count.assign(n, 0);
+
+		// rows isolating an eigenvalue are pushed to the bottom
+		for (int c = 0; c < n; ++c) {
+			const T* col = &A(0, c);
+			for (int r = 0; r < n; ++r)
+				if (r != c && col[r] != zero)
+					++m_count[r];
+		}
+		bool found = true;
+		while (found && ihi > 0) {
+			found = false;
+			for (int j = ihi; j >= 0; --j) {
+				if (m_count[j] != 0)
+					continue;
+				scale(ihi) = (T)j;
+				swap(A, j, ihi, ilo, ihi);
+				std::swap(m_count[j], m_count[ihi]);
+				// column ihi leaves the active block
+				const T* col = &A(0, ihi);
+				for (int r = 0; r < ihi; ++r)
+					if (col[r] != zero)
+						--m_count[r];
+				--ihi;
+				found = true;
+				break;
+			}
+		}
+		if (ihi == 0) {
+			m_ilo = m_ihi = 0;
+			return;
+		}
+
+		// columns isolating an eigenvalue are pushed to the left
+		m_count.assign(n, 0);
+		for (int c = 0; c <= ihi; ++c) {
+			const T* col = &A(0, c);
+			for (int r = 0; r <= ihi; ++r)
+				if (r != c && col[r] != zero)
+					++m_count[c];
+		}
+		found = true;
+		while (found && ilo < ihi) {
+			found = false;
+			for (int j = ilo; j <= ihi; ++j) {
+				if (m_count[j] != 0)
+					continue;
+				scale(ilo) = (T)j;
+				swap(A, j, ilo, ilo, ihi);
+				std::swap(m_count[j], m_count[ilo]);
+				// row ilo leaves the active block
+				for (int c = ilo + 1; c <= ihi; ++c)
+					if (A(ilo, c) != zero)
+						--m_count[c];
+				++ilo;
+				found = true;
+				break;
+			}
+		}
+		m_ilo = ilo;
+		m_ihi = ihi;
+	}
+
+	template<typename T>
+	void GEBAL<T>::scale(NUMCPP::FastMatrix<T> A, NUMCPP::Sequence<T> scale) {
+		int n = A.getNrows(), ilo = m_ilo, ihi = m_ihi;
+		if (ilo == ihi)
+			return;
+		T zero = NUMCPP::CONSTANTS<T>::zero, one = NUMCPP::CONSTANTS<T>::one, two = NUMCPP::CONSTANTS<T>::two;
+		T sfmin1 = NUMCPP::CONSTANTS<T>::safe_min / std::numeric_limits<T>::epsilon();
+		T sfmax1 = one / sfmin1;
+		T sfmin2 = sfmin1 * two;
+		T sfmax2 = one / sfmin2;
+		T factor = (T)0.95;
+		m_rmax.resize(n);
+		m_rssq.resize(n);
+		// rscale(r) is the max of the row r at the beginning of the sweep; rssq(r) = sum (A(r, ilo:ihi) / rscale(r))^2
+		// and rmax(r) is an upper bound of max |A(r, ilo:n-1)|, both updated when a column is scaled.
+		// The scaling factors of the rows are applied column by column: rowf(r) is the factor of the row r in the
+		// current sweep, already applied to the columns ilo:r-1 (at the time the column is balanced) and applied
+		// to the other columns at the end of the sweep
+		std::vector<T> rscale(n), rowf(n);
+
+		bool noconv = true;
+		while (noconv) {
+			noconv = false;
+			// row norms of the active block, column by column
+			std::fill(m_rmax.begin() + ilo, m_rmax.begin() + ihi + 1, zero);
+			std::fill(m_rssq.begin() + ilo, m_rssq.begin() + ihi + 1, zero);
+			std::fill(rowf.begin() + ilo, rowf.begin() + ihi + 1, one);
+			for (int c = ilo; c < n; ++c) {
+				const T* col = &A(0, c);
+				for (int r = ilo; r <= ihi; ++r)
+					m_rmax[r] = std::max(m_rmax[r], std::abs(col[r]));
+			}
+			for (int r = ilo; r <= ihi; ++r)
+				rscale[r] = m_rmax[r] == zero ? one : m_rmax[r];
+			for (int c = ilo; c <= ihi; ++c) {
+				const T* col = &A(0, c);
+				for (int r = ilo; r <= ihi; ++r) {
+					T x = col[r] / rscale[r];
+					m_rssq[r] += x * x;
+				}
+			}
+
+			bool scaled = false;
+			for (int i = ilo; i <= ihi; ++i) {
+				T* coli = &A(0, i);
+				if (scaled) {
+					for (int r = ilo; r < i; ++r)
+						coli[r] *= rowf[r];
+				}
+				T cscale = zero, cssq = one, ca = zero;
+				for (int r = 0; r <= ihi; ++r)
+					ca = std::max(ca, std::abs(coli[r]));
+				for (int r = ilo; r <= ihi; ++r) {
+					T x = std::abs(coli[r]);
+					if (x != zero) {
+						if (cscale < x) {
+							cssq = one + cssq * (cscale / x) * (cscale / x);
+							cscale = x;
+						}
+						else
+							cssq += (x / cscale) * (x / cscale);
+					}
+				}
+				T c = cscale * std::sqrt(cssq);
+				T r = rscale[i] * std::sqrt(std::max(m_rssq[i], zero));
+				T ra = m_rmax[i];
+				if (c == zero || r == zero)
+					continue;
+				if (std::isnan(c + ca + r + ra))
+					throw std::invalid_argument("NaN in gebal");
+				T g = r / two, f = one, s = c + r;
+				while (c < g && std::max(f, std::max(c, ca)) < sfmax2 && std::min(r, std::min(g, ra)) > sfmin2) {
+					f *= two;
+					c *= two;
+					ca *= two;
+					r /= two;
+					g /= two;
+					ra /= two;
+				}
+				g = c / two;
+				while (g >= r && std::max(r, ra) < sfmax2 && std::min(std::min(f, c), std::min(g, ca)) > sfmin2) {
+					f /= two;
+					c /= two;
+					g /= two;
+					ca /= two;
+					r *= two;
+					ra *= two;
+				}
+				// now balance
+				if (c + r >= factor * s)
+					continue;
+				if (f < one && scale(i) < one && f * scale(i) <= sfmin1)
+					continue;
+				if (f > one && scale(i) > one && scale(i) >= sfmax1 / f)
+					continue;
+				scale(i) *= f;
+				rowf[i] = one / f;
+				noconv = scaled = true;
+				// column i is scaled by f: updates the norms of the next rows
+				for (int k = i + 1; k <= ihi; ++k) {
+					T x = coli[k] / rscale[k];
+					m_rssq[k] += (f * x) * (f * x) - x * x;
+					if (f > one)
+						m_rmax[k] = std::max(m_rmax[k], f * std::abs(coli[k]));
+				}
+				for (int k = 0; k <= ihi; ++k)
+					coli[k] *= f;
+			}
+			// remaining row scalings
+			if (scaled) {
+				for (int c = ilo; c < n; ++c) {
+					T* col = &A(0, c);
+					for (int r = c <= ihi ? c : ilo; r <= ihi; ++r)
+						col[r] *= rowf[r];
+				}
+			}
+		}
+	}
+}
+
+#endif
@@ -1 +1,57 @@
-#pragma once
+#ifndef __lcpp_gehd2_h
+#define __lcpp_gehd2_h
+
+#include <stdexcept>
+#include "matrix.h"
+#include "matrix_0.h"
+#include "larfg.h"
+#include "larf.h"
+
+namespace LCPP {
+	/// <summary>
+	/// Reduces a real general matrix A to upper Hessenberg form H by an orthogonal similarity transformation:
+	/// Q' * A * Q = H (unblocked algorithm).
+	/// It is assumed that A is already upper triangular in rows and columns 0:ilo-1 and ihi+1:n-1 (see GEBAL);
+	/// ilo and ihi are 0-based and inclusive. By default, ilo = 0 and ihi = n-1.
+	/// On exit, the upper triangle and the first subdiagonal of A are overwritten with H, and the elements
+	/// below the first subdiagonal, with tau (n-1 elements), represent Q as a product of elementary reflectors
+	///     Q = H(ilo) H(ilo+1) . . . H(ihi-1)
+	/// where H(i) = I - tau(i) * v * v', v(0:i) = 0, v(i+1) = 1 and v(i+2:ihi) is stored in A(i+2:ihi, i).
+	/// Only tau(ilo:ihi-1) is referenced (GEHRD sets the other elements to 0).
+	/// </summary>
+	/// <typeparam name="T"></typeparam>
+	template<typename T>
+	class GEHD2 {
+	public:
+
+		GEHD2() {}
+
+		void operator()(int ilo, int ihi, NUMCPP::FastMatrix<T> A, NUMCPP::Sequence<T> tau);
+		void operator()(NUMCPP::FastMatrix<T> A, NUMCPP::Sequence<T> tau) {
+			(*this)(0, A.getNrows() - 1, A, tau);
+		}
+	};
+
+	template<typename T>
+	void GEHD2<T>::operator()(int ilo, int ihi, NUMCPP::FastMatrix<T> A, NUMCPP::Sequence<T> tau) {
+		int n = A.getNrows();
+		if (!A.isSquare())
+			throw std::invalid_argument("Not square matrix in gehd2");
+		if (ilo < 0 || ilo > std::max(0, n - 1) || ihi < std::min(ilo, n - 1) || ihi >= n || tau.length() < n - 1)
+			throw std::invalid_argument("Invalid arguments in gehd2");
+		LARFG<T> larfg;
+		LARF<T> larf;
+		for (int i = ilo; i < ihi; ++i) {
+			// H(i) annihilates A(i+2:ihi, i)
+			NUMCPP::Sequence<T> v = A.column(i).extract(i + 1, ihi - i);
+			T taui = larfg(v);
+			tau(i) = taui;
+			// A(0:ihi, i+1:ihi) = A(0:ihi, i+1:ihi) * H(i)
+			larf(Side::Right, v, taui, A.extract(0, ihi + 1, i + 1, ihi - i));
+			// A(i+1:ihi, i+1:n-1) = H(i) * A(i+1:ihi, i+1:n-1)
+			larf(Side::Left, v, taui, A.extract(i + 1, ihi - i, i + 1, n - i - 1));
+		}
+	}
+}
+
+#endif
@@ -1 +1,89 @@
-#pragma once
+#ifndef __lcpp_gehrd_h
+#define __lcpp_gehrd_h
+
+#include <algorithm>
+#include <stdexcept>
+#include "matrix.h"
+#include "matrix_0.h"
+#include "laenv.h"
+#include "gemm.h"
+#include "trmm.h"
+#include "larfb.h"
+#include "lahr2.h"
+#include "gehd2.h"
+
+namespace LCPP {
+	/// <summary>
+	/// Reduces a real general matrix A to upper Hessenberg form H by an orthogonal similarity transformation:
+	/// Q' * A * Q = H (blocked algorithm). The arguments and the output are the same as for GEHD2.
+	/// The columns are reduced by panels of nb (LAENV) columns: LAHR2 computes the block reflector
+	/// I - V * Tf * V' of the panel and Y = A * V * Tf; the trailing matrix is then updated from the right
+	/// by GEMM (A = A - Y * V') and from the left by LARFB. The last columns are reduced by GEHD2.
+	/// </summary>
+	/// <typeparam name="T"></typeparam>
+	template<typename T>
+	class GEHRD {
+	public:
+
+		GEHRD() {}
+
+		void operator()(int ilo, int ihi, NUMCPP::FastMatrix<T> A, NUMCPP::Sequence<T> tau);
+		void operator()(NUMCPP::FastMatrix<T> A, NUMCPP::Sequence<T> tau) {
+			(*this)(0, A.getNrows() - 1, A, tau);
+		}
+		void operator()(NUMCPP::Matrix<T>& A, NUMCPP::Sequence<T> tau) {
+			(*this)(A.all(), tau);
+		}
+	};
+
+	template<typename T>
+	void GEHRD<T>::operator()(int ilo, int ihi, NUMCPP::FastMatrix<T> A, NUMCPP::Sequence<T> tau) {
+		int n = A.getNrows();
+		if (!A.isSquare())
+			throw std::invalid_argument("Not square matrix in gehrd");
+		if (ilo < 0 || ilo > std::max(0, n - 1) || ihi < std::min(ilo, n - 1) || ihi >= n || tau.length() < n - 1)
+			throw std::invalid_argument("Invalid arguments in gehrd");
+		T zero = NUMCPP::CONSTANTS<T>::zero, one = NUMCPP::CONSTANTS<T>::one;
+		for (int i = 0; i < ilo; ++i)
+			tau(i) = zero;
+		for (int i = std::max(ilo, ihi); i < n - 1; ++i)
+			tau(i) = zero;
+		LAENV laenv;
+		int nh = ihi - ilo + 1;
+		int nb = laenv(LAENV::Optimal, "GEHRD", "", n, ilo, ihi, -1);
+		int nx = std::max(nb, laenv(LAENV::CrossOver, "GEHRD", "", n, ilo, ihi, -1));
+		int i = ilo;
+		if (nb < nh && nx < nh) {
+			NUMCPP::Matrix<T> Tm(nb, nb), Ym(n, nb);
+			int lda = A.getColumnIncrement(), ldy = Ym.getNrows();
+			T* a = A.ptr();
+			T* y = Ym.all().ptr();
+			GEMM<T> gemm;
+			TRMM<T> trmm;
+			LARFB<T> larfb;
+			LAHR2<T> lahr2;
+			for (; i < ihi - nx; i += nb) {
+				int ib = std::min(nb, ihi - i);
+				NUMCPP::FastMatrix<T> Tf = Tm.extract(0, ib, 0, ib);
+				lahr2(i, ib, ihi, A, tau.extract(i, ib), Tf, Ym.extract(0, ihi + 1, 0, ib));
+				// A(0:ihi, i+ib:ihi) = A(0:ihi, i+ib:ihi) - Y * V(i+ib:ihi, :)'. The last unit element of V is set explicitly
+				T ei = A(i + ib, i + ib - 1);
+				A(i + ib, i + ib - 1) = one;
+				gemm(false, true, ihi + 1, ihi - i - ib + 1, ib, -one, y, ldy, a + i + ib + i * lda, lda, one, a + (i + ib) * lda, lda);
+				A(i + ib, i + ib - 1) = ei;
+				// A(0:i, i+1:i+ib-1) = A(0:i, i+1:i+ib-1) - Y(0:i, 0:ib-2) * V(i+1:i+ib-1, 0:ib-2)'
+				NUMCPP::FastMatrix<T> W = Ym.extract(0, i + 1, 0, ib - 1);
+				trmm(Side::Right, Triangular::Lower, true, true, one, A.extract(i + 1, ib - 1, i, ib - 1), W);
+				for (int j = 0; j < ib - 1; ++j)
+					A.column(i + j + 1).left(i + 1).addAY(-one, W.column(j));
+				// A(i+1:ihi, i+ib:n-1) = H' * A(i+1:ihi, i+ib:n-1)
+				larfb(Side::Left, true, Direction::Forward, A.extract(i + 1, ihi - i, i, ib), Tf, A.extract(i + 1, ihi - i, i + ib, n - i - ib));
+			}
+		}
+		// remaining columns
+		GEHD2<T> gehd2;
+		gehd2(i, ihi, A, tau);
+	}
+}
+
+#endif
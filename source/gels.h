@@ -0,0 +1,115 @@
+#ifndef __lcpp_gels_h
+#define __lcpp_gels_h
+
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include "matrix.h"
+#include "matrix_0.h"
+#include "geqrf.h"
+#include "ormqr.h"
+#include "trsm.h"
+
+namespace LCPP {
+	/// <summary>
+	/// Solves overdetermined or underdetermined real linear systems involving an m by n matrix A of full rank,
+	/// with several right hand sides (columns of B):
+	/// m >= n: least squares solution of min || A * X - B ||, using the QR factorization of A:
+	///         X = inv(R) * (Q' * B)(0:n-1)
+	/// m < n:  minimum norm solution of A * X = B, using the LQ factorization A = L * Q, computed as the QR
+	///         factorization of A' (A' = Q' * L'): X = Q' * [inv(L) * B; 0]
+	/// B must have max(m, n) rows; on exit, its first n rows contain X. For m >= n, A is overwritten by its
+	/// QR factorization (as returned by GEQRF); for m < n, A is not modified.
+	/// All the right hand sides are processed together by ORMQR (LARFB) and TRSM.
+	/// The object keeps its workspace (tau and, for m < n, the transposed matrix), which is reused by the next calls;
+	/// a single GELS object should be used to solve many problems of the same size.
+	/// info() = 0 on success, or i > 0 if the i-th diagonal element of the triangular factor is zero
+	/// (A is not of full rank); in that case, X is not computed.
+	/// </summary>
+	/// <typeparam name="T"></typeparam>
+	template<typename T>
+	class GELS {
+	public:
+
+		GELS() :m_info(0) {}
+
+		void operator()(NUMCPP::FastMatrix<T> A, NUMCPP::FastMatrix<T> B);
+		void operator()(NUMCPP::Matrix<T>& A, NUMCPP::Matrix<T>& B) {
+			(*this)(A.all(), B.all());
+		}
+
+		int info() const {
+			return m_info;
+		}
+
+	private:
+
+		// checks the diagonal of the triangular factor (k x k)
+		int check(NUMCPP::FastMatrix<T> R);
+
+		// workspace
+		NUMCPP::Matrix<T> m_work;
+		std::vector<T> m_tau;
+
+		int m_info;
+	};
+
+	template<typename T>
+	void GELS<T>::operator()(NUMCPP::FastMatrix<T> A, NUMCPP::FastMatrix<T> B) {
+		int m = A.getNrows(), n = A.getNcols(), nrhs = B.getNcols();
+		if (B.getNrows() != std::max(m, n))
+			throw std::invalid_argument("Invalid dimensions in gels");
+		m_info = 0;
+		int k = std::min(m, n);
+		if (k == 0 || nrhs == 0) {
+			B.set(NUMCPP::CONSTANTS<T>::zero);
+			return;
+		}
+		if ((int)m_tau.size() < k)
+			m_tau.resize(k);
+		NUMCPP::Sequence<T> tau(m_tau.data(), k);
+		T one = NUMCPP::CONSTANTS<T>::one;
+		GEQRF<T> geqrf;
+		ORMQR<T> ormqr;
+		TRSM<T> trsm;
+		if (m >= n) {
+			// B(0:m-1, :) = Q' * B; X = inv(R) * B(0:n-1, :)
+			geqrf(A, tau);
+			ormqr(Side::Left, true, A, tau, B);
+			NUMCPP::FastMatrix<T> R = A.extract(0, n, 0, n);
+			m_info = check(R);
+			if (m_info != 0)
+				return;
+			trsm(Side::Left, Triangular::Upper, false, false, R, one, B.extract(0, n, 0, nrhs));
+		}
+		else {
+			// A' = Q1 * R (n x m), A = R' * Q1'
+			if (m_work.getNrows() < n || m_work.getNcols() < m)
+				m_work = NUMCPP::Matrix<T>(std::max(n, m_work.getNrows()), std::max(m, m_work.getNcols()));
+			NUMCPP::FastMatrix<T> At = m_work.extract(0, n, 0, m);
+			for (int i = 0; i < m; ++i)
+				At.column(i).copy(A.row(i));
+			geqrf(At, tau);
+			NUMCPP::FastMatrix<T> R = At.extract(0, m, 0, m);
+			m_info = check(R);
+			if (m_info != 0)
+				return;
+			// B(0:m-1, :) = inv(R') * B(0:m-1, :), B(m:n-1, :) = 0; X = Q * B
+			trsm(Side::Left, Triangular::Upper, true, false, R, one, B.extract(0, m, 0, nrhs));
+			B.extract(m, n - m, 0, nrhs).set(NUMCPP::CONSTANTS<T>::zero);
+			ormqr(Side::Left, false, At, tau, B);
+		}
+	}
+
+	template<typename T>
+	int GELS<T>::check(NUMCPP::FastMatrix<T> R) {
+		int k = R.getNrows();
+		for (int i = 0; i < k; ++i) {
+			if (R(i, i) == NUMCPP::CONSTANTS<T>::zero)
+				return i + 1;
+		}
+		return 0;
+	}
+}
+
+#endif
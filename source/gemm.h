@@ -1,13 +1,16 @@
 #ifndef __lcpp_gemm_h
 #define __lcpp_gemm_h
 
+#include <type_traits>
 #include "matrix.h"
+#include "simd.h"
+#include "axpy.h"
 #include "dot.h"
-#include "scal.h"
 
 namespace LCPP {
     /// <summary>
     /// Compute C:= alpha * op(A) * op(B) + beta * C, with op(X) = X or op(X) = X'
+    /// For doubles, the product is computed by the cache-blocked kernel of SIMD (SIMD::gemm), unless it is tiny.
     /// </summary>
     /// <typeparam name="T"></typeparam>
     template <typename T>
@@ -35,12 +38,8 @@ namespace LCPP {
 
         static const T zero, one;
 
-        void apply(bool tA, bool tB, T alpha, NUMCPP::FastMatrix<T>& A, NUMCPP::FastMatrix<T>& B, T beta, NUMCPP::FastMatrix<T>& C);
-        void apply_ab(T alpha, NUMCPP::FastMatrix<T>& A, NUMCPP::FastMatrix<T>& B, T beta, NUMCPP::FastMatrix<T>& C);
-        void apply_atb(T alpha, NUMCPP::FastMatrix<T>& A, NUMCPP::FastMatrix<T>& B, T beta, NUMCPP::FastMatrix<T>& C);
-        void apply_tab(T alpha, NUMCPP::FastMatrix<T>& A, NUMCPP::FastMatrix<T>& B, T beta, NUMCPP::FastMatrix<T>& C);
-        void apply_tatb(T alpha, NUMCPP::FastMatrix<T>& A, NUMCPP::FastMatrix<T>& B, T beta, NUMCPP::FastMatrix<T>& C);
-
+        // smallest m * n * k for which the blocked product (doubles) is faster than the plain loops
+        static const int MIN_BLOCKED = 512;
     };
 
     template <typename T>
@@ -73,7 +72,7 @@ namespace LCPP {
         if (ma != m || nb != n || ka != kb)
             throw std::invalid_argument("invalid dimensions in GEMM");
 
-        apply(tA, tB, alpha, A, B, beta, C);
+        apply(tA, tB, m, n, ka, alpha, A.cptr(), A.getColumnIncrement(), B.cptr(), B.getColumnIncrement(), beta, C.ptr(), C.getColumnIncrement());
     }
 
 
@@ -84,9 +83,17 @@ namespace LCPP {
         if (m == 0 || n == 0)
             return;
         if (alpha == zero || k == 0) {
-            mul(m, n, beta, C, ldc);
+            NUMCPP::FastMatrix<T>::mul(C, ldc, m, n, beta);
             return;
         }
+        if constexpr (std::is_same<T, double>::value) {
+            // packed, register-blocked product. The matrix-vector shapes (few columns in C, or few rows with op(A) = A')
+            // stay on the plain loops, where the packing would not be amortized
+            if ((double)m * n * k >= MIN_BLOCKED && n >= 4 && (m >= 4 || !tA)) {
+                NUMCPP::SIMD::gemm(tA, tB, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc);
+                return;
+            }
+        }
         if (!tA) {
             if (!tB)
                 apply_ab(m, n, k, alpha, A, lda, B, ldb, beta, C, ldc);
@@ -103,231 +110,50 @@ namespace LCPP {
 
     template<typename T>
     void GEMM<T>::apply_ab(int m, int n, int k, T alpha, const T* A, int lda, const T* B, int ldb, T beta, T* C, int ldc) {
-        T* cstart = C;
-        T* const cend = cstart + ldc * n;
-        const T* bstart = B;
-        const T* astart = A;
-        while (cstart != cend) {
-            // cur = C[.,j]
-            T* cur = cstart;
-            T* const end = cur + m;
-            if (beta == zero)
-                while (cur != end) { *cur++ = 0; }
-            else if (beta != one)
-                while (cur != end) { *cur++ *= beta; }
-            cur = cstart;
-            // bcur = bcur[., j]
-            const T* bcur = bstart;
-            const T* const bend = bcur + k;
-            const T* acur = astart;
-            while (bcur != bend) {
-                T temp = alpha * (*bcur++);
-                const T* a = acur;
-                cur = cstart;
-                while (cur != end) {
-                    *cur++ += temp * *a++;
-                }
-                acur += lda;
-            }
-            cstart += ldc;
-            bstart += ldb;
+        // C(:,j) = beta * C(:,j) + sum(alpha * B(l,j) * A(:,l)): axpy on contiguous columns
+        AXPY<T> axpy;
+        for (int j = 0; j < n; ++j, B += ldb, C += ldc) {
+            NUMCPP::FastMatrix<T>::mul(C, ldc, m, 1, beta);
+            const T* a = A;
+            for (int l = 0; l < k; ++l, a += lda)
+                axpy(m, alpha * B[l], a, C);
         }
     }
 
     template<typename T>
     void GEMM<T>::apply_atb(int m, int n, int k, T alpha, const T* A, int lda, const T* B, int ldb, T beta, T* C, int ldc) {
-        T* cstart = C;
-        T* const cend = cstart + ldc * n;
-        const T* bstart = B;
-        const T* astart = A;
-        while (cstart != cend) {
-            // cur = C[.,j]
-            T* cur = cstart;
-            T* const end = cur + m;
-            if (beta == zero)
-                while (cur != end) { *cur++ = 0; }
-            else if (beta != one)
-                while (cur != end) { *cur++ *= beta; }
-            cur = cstart;
-            // bcur = bcur[., j]
-            const T* bcur = bstart;
-            const T* const bend = bcur + k * ldb;
-            const T* acur = astart;
-            while (bcur != bend) {
-                T temp = alpha * (*bcur);
-                const T* a = acur;
-                cur = cstart;
-                while (cur != end) {
-                    *cur++ += temp * *a++;
-                }
-                acur += lda;
-                bcur += ldb;
-            }
-            cstart += ldc;
-            ++bstart;
+        // C(:,j) = beta * C(:,j) + sum(alpha * B(j,l) * A(:,l))
+        AXPY<T> axpy;
+        for (int j = 0; j < n; ++j, ++B, C += ldc) {
+            NUMCPP::FastMatrix<T>::mul(C, ldc, m, 1, beta);
+            const T* a = A;
+            for (int l = 0; l < k; ++l, a += lda)
+                axpy(m, alpha * B[l * ldb], a, C);
         }
     }
 
     template<typename T>
     void GEMM<T>::apply_tab(int m, int n, int k, T alpha, const T* A, int lda, const T* B, int ldb, T beta, T* C, int ldc) {
-        T* cstart = C;
-        T* const cend = cstart + ldc * n;
-        const T* bstart = B;
-        const T* astart = A;
-        while (cstart != cend) {
-            // cur = C[.,j]
-            T* cur = cstart;
-            T* const end = cur + m;
-            if (beta == zero)
-                while (cur != end) { *cur++ = 0; }
-            else if (beta != one)
-                while (cur != end) { *cur++ *= beta; }
-            cur = cstart;
-            // bcur = bcur[., j]
-            const T* bcur = bstart;
-            const T* const bend = bcur + k;
-            const T* acur = astart;
-            while (bcur != bend) {
-                T temp = alpha * (*bcur++);
-                const T* a = acur;
-                cur = cstart;
-                while (cur != end) {
-                    *cur++ += temp * *a;
-                    a += lda;
-                }
-                acur++;
-            }
-            cstart += ldc;
-            bstart += ldb;
-        }
-    }
-
-    template<typename T>
-    void GEMM<T>::apply_tatb(int m, int n, int k, T alpha, const T* A, int lda, const T* B, int ldb, T beta, T* C, int ldc) {
-        T* cstart = C;
-        T* const cend = cstart + ldc * n;
-        const T* bstart = B;
-        const T* astart = A;
-        while (cstart != cend) {
-            // cur = C[.,j]
-            T* cur = cstart;
-            T* const end = cur + m;
-            if (beta == zero)
-                while (cur != end) { *cur++ = 0; }
-            else if (beta != one)
-                while (cur != end) { *cur++ *= beta; }
-            cur = cstart;
-            const T* bcur = bstart;
-            const T* const bend = bcur + k * ldb;
-            const T* acur = astart;
-            while (bcur != bend) {
-                T temp = alpha * (*bcur);
-                const T* a = acur;
-                cur = cstart;
-                while (cur != end) {
-                    *cur++ += temp * *a;
-                    a += lda;
-                }
-                bcur += ldb;
-                acur++;
-            }
-            cstart += ldc;
-            bstart++;
-        }
-    }
-
-    template<typename T>
-    void GEMM<T>::apply(bool tA, bool tB, T alpha, NUMCPP::FastMatrix<T>& A, NUMCPP::FastMatrix<T>& B, T beta, NUMCPP::FastMatrix<T>& C) {
-        // we skip the check of the dimensions in this low level routine. Should be done before
-        if (C.isEmpty())
-            return;
-        if (alpha == zero || A.isEmpty()) {
-            NUMCPP::SequenceIterator<T> cols = C.columnsIterator();
-            while (cols.hasNext())
-                cols.next().mul(beta);
-            return;
-        }
-        if (!tA) {
-            if (!tB)
-                apply_ab(alpha, A, B, beta, C);
-            else
-                apply_atb(alpha, A, B, beta, C);
-        }
-        else {
-            if (!tB)
-                apply_tab(alpha, A, B, beta, C);
-            else
-                apply_tatb(alpha, A, B, beta, C);
-        }
-    }
-
-    template<typename T>
-    void GEMM<T>::apply_ab(T alpha, NUMCPP::FastMatrix<T>& A, NUMCPP::FastMatrix<T>& B, T beta, NUMCPP::FastMatrix<T>& C) {
-        NUMCPP::SequenceIterator<T> cols = C.columnsIterator();
-        NUMCPP::SequenceIterator<T> bcols = B.columnsIterator();
-        SCAL<T> scal;
+        // C(i,j) = beta * C(i,j) + alpha * A(:,i)' * B(:,j): dot products of contiguous columns
         DOT<T, T> dot;
-        while (cols.hasNext()) {
-            NUMCPP::Sequence<T> col = cols.next();
-            col.mul(beta);
-            NUMCPP::SequenceIterator<T> arows = A.rowsIterator();
-            NUMCPP::Sequence<T> bcol = bcols.next();
-            auto cur = col.begin();
-            while (arows.hasNext()) {
-                *cur++ += alpha * arows.next().dot(bcol);
+        for (int j = 0; j < n; ++j, B += ldb, C += ldc) {
+            const T* a = A;
+            for (int i = 0; i < m; ++i, a += lda) {
+                T s = dot(k, a, B);
+                C[i] = beta == zero ? alpha * s : beta * C[i] + alpha * s;
             }
         }
     }
 
     template<typename T>
-    void GEMM<T>::apply_atb(T alpha, NUMCPP::FastMatrix<T>& A, NUMCPP::FastMatrix<T>& B, T beta, NUMCPP::FastMatrix<T>& C) {
-        NUMCPP::SequenceIterator<T> cols = C.columnsIterator();
-        NUMCPP::SequenceIterator<T> bcols = B.rowsIterator();
-        SCAL<T> scal;
-        DOT<T, T> dot;
-        while (cols.hasNext()) {
-            NUMCPP::SequenceIterator<T> arows = A.rowsIterator();
-            NUMCPP::Sequence<T> col = cols.next();
-            col.mul(beta);
-            NUMCPP::Sequence<T> bcol = bcols.next();
-            auto cur = col.begin();
-            while (arows.hasNext()) {
-                *cur++ += alpha*arows.next().dot(bcol);
-            }
-        }
-    }
-
-    template<typename T>
-    void GEMM<T>::apply_tab(T alpha, NUMCPP::FastMatrix<T>& A, NUMCPP::FastMatrix<T>& B, T beta, NUMCPP::FastMatrix<T>& C) {
-        NUMCPP::SequenceIterator<T> cols = C.columnsIterator();
-        NUMCPP::SequenceIterator<T> bcols = B.columnsIterator();
-        SCAL<T> scal;
-        DOT<T, T> dot;
-        while (cols.hasNext()) {
-            NUMCPP::SequenceIterator<T> arows = A.columnsIterator();
-            NUMCPP::Sequence<T> col = cols.next();
-            col.mul(beta);
-            NUMCPP::Sequence<T> bcol = bcols.next();
-            auto cur = col.begin();
-            while (arows.hasNext()) {
-                *cur++ += alpha * arows.next().dot(bcol);
-            }
-        }
-    }
-    template<typename T>
-    void GEMM<T>::apply_tatb(T alpha, NUMCPP::FastMatrix<T>& A, NUMCPP::FastMatrix<T>& B, T beta, NUMCPP::FastMatrix<T>& C) {
-        NUMCPP::SequenceIterator<T> cols = C.columnsIterator();
-        NUMCPP::SequenceIterator<T> bcols = B.rowsIterator();
-        SCAL<T> scal;
+    void GEMM<T>::apply_tatb(int m, int n, int k, T alpha, const T* A, int lda, const T* B, int ldb, T beta, T* C, int ldc) {
+        // C(i,j) = beta * C(i,j) + alpha * A(:,i)' * B(j,:)'
         DOT<T, T> dot;
-        while (cols.hasNext()) {
-            NUMCPP::SequenceIterator<T> arows = A.columnsIterator();
-            NUMCPP::Sequence<T> col = cols.next();
-            col.mul(beta);
-            NUMCPP::Sequence<T> bcol = bcols.next();
-            auto cur = col.begin();
-            while (arows.hasNext()) {
-                *cur++ += alpha * arows.next().dot(bcol);
+        for (int j = 0; j < n; ++j, ++B, C += ldc) {
+            const T* a = A;
+            for (int i = 0; i < m; ++i, a += lda) {
+                T s = dot(k, a, 1, B, ldb);
+                C[i] = beta == zero ? alpha * s : beta * C[i] + alpha * s;
             }
         }
     }
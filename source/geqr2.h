@@ -0,0 +1,48 @@
+#ifndef __lcpp_geqr2_h
+#define __lcpp_geqr2_h
+
+#include <algorithm>
+#include <stdexcept>
+#include "matrix.h"
+#include "matrix_0.h"
+#include "larfg.h"
+#include "larf.h"
+
+namespace LCPP {
+	/// <summary>
+	/// Computes a QR factorization of a real m by n matrix A: A = Q * R (unblocked algorithm).
+	/// On exit, the elements on and above the diagonal of A contain the min(m,n) by n upper trapezoidal matrix R;
+	/// the elements below the diagonal, with the array tau, represent the orthogonal matrix Q as a product of
+	/// elementary reflectors Q = H(1) H(2) . . . H(k), where k = min(m,n).
+	/// Each H(i) has the form H(i) = I - tau * v * v', where v(0:i-1) = 0, v(i) = 1 and v(i+1:m-1) is stored in A(i+1:m-1, i).
+	/// </summary>
+	/// <typeparam name="T"></typeparam>
+	template<typename T>
+	class GEQR2 {
+	public:
+
+		GEQR2() {}
+
+		void operator()(NUMCPP::FastMatrix<T> A, NUMCPP::Sequence<T> tau);
+	};
+
+	template<typename T>
+	void GEQR2<T>::operator()(NUMCPP::FastMatrix<T> A, NUMCPP::Sequence<T> tau) {
+		int m = A.getNrows(), n = A.getNcols(), k = std::min(m, n);
+		if (tau.length() < k)
+			throw std::invalid_argument("Invalid dimensions in geqr2");
+		LARFG<T> larfg;
+		LARF<T> larf;
+		for (int i = 0; i < k; ++i) {
+			// generates H(i) to annihilate A(i+1:m-1, i)
+			NUMCPP::Sequence<T> v = A.column(i).drop(i, 0);
+			T taui = larfg(v);
+			tau(i) = taui;
+			// applies H(i) to A(i:m-1, i+1:n-1) from the left
+			if (i < n - 1)
+				larf(Side::Left, v, taui, A.extract(i, m - i, i + 1, n - i - 1));
+		}
+	}
+}
+
+#endif
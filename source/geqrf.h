@@ -0,0 +1,69 @@
+#ifndef __lcpp_geqrf_h
+#define __lcpp_geqrf_h
+
+#include <algorithm>
+#include <stdexcept>
+#include "matrix.h"
+#include "matrix_0.h"
+#include "laenv.h"
+#include "geqr2.h"
+#include "larft.h"
+#include "larfb.h"
+
+namespace LCPP {
+	/// <summary>
+	/// Computes a QR factorization of a real m by n matrix A: A = Q * R (blocked algorithm).
+	/// The output is the same as for GEQR2.
+	/// The panels of nb columns are factorized by GEQR2; the block reflector of each panel is then formed
+	/// in compact WY representation (LARFT) and applied to the trailing matrix by LARFB, so that most
+	/// of the work is done by GEMM. The block size and the crossover point (the last columns, or the whole
+	/// matrix if it is small, are factorized by GEQR2) are given by LAENV.
+	/// </summary>
+	/// <typeparam name="T"></typeparam>
+	template<typename T>
+	class GEQRF {
+	public:
+
+		GEQRF() {}
+
+		void operator()(NUMCPP::FastMatrix<T> A, NUMCPP::Sequence<T> tau);
+		void operator()(NUMCPP::Matrix<T>& A, NUMCPP::Sequence<T> tau) {
+			(*this)(A.all(), tau);
+		}
+	};
+
+	template<typename T>
+	void GEQRF<T>::operator()(NUMCPP::FastMatrix<T> A, NUMCPP::Sequence<T> tau) {
+		int m = A.getNrows(), n = A.getNcols(), k = std::min(m, n);
+		if (tau.length() < k)
+			throw std::invalid_argument("Invalid dimensions in geqrf");
+		if (k == 0)
+			return;
+		LAENV laenv;
+		int nb = laenv(LAENV::Optimal, "GEQRF", "", m, n, -1, -1);
+		int nx = std::max(nb, laenv(LAENV::CrossOver, "GEQRF", "", m, n, -1, -1));
+		int i = 0;
+		GEQR2<T> geqr2;
+		if (nb < k && nx < k) {
+			LARFT<T> larft;
+			LARFB<T> larfb;
+			NUMCPP::Matrix<T> Tm(nb, nb);
+			for (; i < k - nx; i += nb) {
+				int ib = std::min(nb, k - i);
+				// QR factorization of the panel A(i:m-1, i:i+ib-1)
+				NUMCPP::FastMatrix<T> panel = A.extract(i, m - i, i, ib);
+				geqr2(panel, tau.extract(i, ib));
+				if (i + ib < n) {
+					// H' = (H(i) H(i+1) ... H(i+ib-1))' applied to A(i:m-1, i+ib:n-1)
+					NUMCPP::FastMatrix<T> Tf = Tm.extract(0, ib, 0, ib);
+					larft(Direction::Forward, panel, tau.extract(i, ib), Tf);
+					larfb(Side::Left, true, Direction::Forward, panel, Tf, A.extract(i, m - i, i + ib, n - i - ib));
+				}
+			}
+		}
+		// remaining columns
+		geqr2(A.extract(i, m - i, i, n - i), tau.extract(i, k - i));
+	}
+}
+
+#endif
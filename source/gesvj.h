@@ -0,0 +1,226 @@
+#ifndef __lcpp_gesvj_h
+#define __lcpp_gesvj_h
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <vector>
+#include <stdexcept>
+#include "matrix.h"
+#include "matrix_0.h"
+#include "parallel.h"
+#include "dot.h"
+#include "nrm2.h"
+#include "rot.h"
+#include "geqrf.h"
+#include "ormqr.h"
+
+namespace LCPP {
+	/// <summary>
+	/// Computes the singular value decomposition of a real m x n matrix A (m >= n) by the one-sided Jacobi
+	/// method:
+	///     A = U * diag(sv) * V'
+	/// with U (m x n) and V (n x n) orthonormal and sv in descending order.
+	/// On exit, A is overwritten by U if wantu (otherwise A is destroyed) and V contains the right singular
+	/// vectors if wantv (V is not referenced otherwise).
+	/// When m > n, A is first reduced to its triangular factor R by GEQRF; the Jacobi iterations are applied
+	/// to R and U is recovered by ORMQR.
+	/// The columns are orthogonalized by plane rotations (ROT on contiguous columns), applied by pairs
+	/// (p, q) until |g(p)' * g(q)| <= sqrt(m) * eps * ||g(p)|| * ||g(q)|| for all pairs (DOT/NRM2). Each sweep
+	/// visits the pairs in a round-robin tournament ordering: the n/2 pairs of a round are disjoint, so that
+	/// they are processed in parallel on nthreads threads (0 = default concurrency).
+	/// Since the rotations are computed from the cosine of the angle between the columns only, the small
+	/// singular values are computed with a high relative accuracy when A = B * D with B well conditioned
+	/// and D diagonal. The columns of U corresponding to zero singular values are set to zero.
+	/// info() = 0 on success, or 1 if the orthogonality was not reached after 30 sweeps.
+	/// </summary>
+	/// <typeparam name="T"></typeparam>
+	template<typename T>
+	class GESVJ {
+	public:
+
+		GESVJ(int nthreads = 0) :m_nthreads(nthreads), m_info(0), m_sweeps(0) {}
+
+		void operator()(bool wantu, bool wantv, NUMCPP::FastMatrix<T> A, NUMCPP::Sequence<T> sv, NUMCPP::FastMatrix<T> V);
+		void operator()(bool wantu, bool wantv, NUMCPP::Matrix<T>& A, NUMCPP::Sequence<T> sv, NUMCPP::Matrix<T>& V) {
+			(*this)(wantu, wantv, A.all(), sv, V.all());
+		}
+
+		int info() const {
+			return m_info;
+		}
+
+		/// <summary>
+		/// Number of sweeps of the last decomposition
+		/// </summary>
+		int sweeps() const {
+			return m_sweeps;
+		}
+
+	private:
+
+		static const int MAXSWEEPS = 30;
+
+		// one-sided Jacobi on the columns of G (m x n)
+		void jacobi(bool wantv, NUMCPP::FastMatrix<T> G, NUMCPP::FastMatrix<T> V);
+
+		int m_nthreads, m_info, m_sweeps;
+	};
+
+	template<typename T>
+	void GESVJ<T>::operator()(bool wantu, bool wantv, NUMCPP::FastMatrix<T> A, NUMCPP::Sequence<T> sv, NUMCPP::FastMatrix<T> V) {
+		int m = A.getNrows(), n = A.getNcols();
+		if (m < n || sv.length() < n || (wantv && (V.getNrows() != n || V.getNcols() != n)))
+			throw std::invalid_argument("Invalid arguments in gesvj");
+		m_info = 0;
+		m_sweeps = 0;
+		if (n == 0)
+			return;
+		T zero = NUMCPP::CONSTANTS<T>::zero, one = NUMCPP::CONSTANTS<T>::one;
+		if (wantv) {
+			for (int j = 0; j < n; ++j) {
+				V.column(j).set(zero);
+				V(j, j) = one;
+			}
+		}
+		NRM2<T, T> nrm2;
+		if (m > n) {
+			// QR preconditioning: the rotations are applied to R (n x n)
+			NUMCPP::DataBlock<T> tau(n);
+			GEQRF<T> geqrf;
+			geqrf(A, tau.all());
+			NUMCPP::Matrix<T> R(n, n, [&](int r, int c) {return r <= c ? A(r, c) : zero; });
+			jacobi(wantv, R.all(), V);
+			// U = Q * (R * V * inv(S); 0)
+			NUMCPP::Matrix<T> U(m, n);
+			U.all().set(zero);
+			for (int j = 0; j < n; ++j) {
+				U.column(j).left(n).copy(R.column(j));
+				sv(j) = nrm2(n, &R(0, j), 1);
+			}
+			if (wantu) {
+				ORMQR<T> ormqr;
+				ormqr(Side::Left, false, A, tau.all(), U.all());
+			}
+			for (int j = 0; j < n; ++j)
+				A.column(j).copy(U.column(j));
+		}
+		else {
+			jacobi(wantv, A, V);
+			for (int j = 0; j < n; ++j)
+				sv(j) = nrm2(m, &A(0, j), 1);
+		}
+
+		// U = G * inv(S), singular values in descending order
+		if (wantu) {
+			for (int j = 0; j < n; ++j) {
+				if (sv(j) == zero)
+					A.column(j).set(zero);
+				else
+					A.column(j).div(sv(j));
+			}
+		}
+		std::vector<int> order(n);
+		std::iota(order.begin(), order.end(), 0);
+		std::stable_sort(order.begin(), order.end(), [&](int l, int r) {return sv(l) > sv(r); });
+		std::vector<T> s(n);
+		for (int j = 0; j < n; ++j)
+			s[j] = sv(order[j]);
+		for (int j = 0; j < n; ++j)
+			sv(j) = s[j];
+		// permutation of the columns (cycles)
+		std::vector<bool> done(n, false);
+		for (int j = 0; j < n; ++j) {
+			if (done[j] || order[j] == j)
+				continue;
+			// column j receives column order[j], ...
+			NUMCPP::DataBlock<T> ua(wantu ? m : 0), va(wantv ? n : 0);
+			if (wantu)
+				ua.all().copy(A.column(j));
+			if (wantv)
+				va.all().copy(V.column(j));
+			int cur = j;
+			while (true) {
+				done[cur] = true;
+				int src = order[cur];
+				if (src == j) {
+					if (wantu)
+						A.column(cur).copy(ua.all());
+					if (wantv)
+						V.column(cur).copy(va.all());
+					break;
+				}
+				if (wantu)
+					A.column(cur).copy(A.column(src));
+				if (wantv)
+					V.column(cur).copy(V.column(src));
+				cur = src;
+			}
+		}
+	}
+
+	template<typename T>
+	void GESVJ<T>::jacobi(bool wantv, NUMCPP::FastMatrix<T> G, NUMCPP::FastMatrix<T> V) {
+		int m = G.getNrows(), n = G.getNcols();
+		if (n < 2)
+			return;
+		T zero = NUMCPP::CONSTANTS<T>::zero, one = NUMCPP::CONSTANTS<T>::one, half = NUMCPP::CONSTANTS<T>::half;
+		T tol = std::sqrt((T)m) * std::numeric_limits<T>::epsilon();
+		int nthreads = m_nthreads > 0 ? m_nthreads : NUMCPP::Parallel::concurrency();
+		int ldg = G.getColumnIncrement(), ldv = wantv ? V.getColumnIncrement() : 0;
+		T* g = G.ptr();
+		T* v = wantv ? V.ptr() : nullptr;
+		// round-robin tournament: the players are the columns (and a dummy player n when n is odd)
+		int np = n + (n & 1), npairs = np / 2;
+		std::vector<int> players(np);
+		std::iota(players.begin(), players.end(), 0);
+		int nchunks = std::min(npairs, nthreads);
+		if ((long long)m * npairs < 4096)
+			nchunks = 1;
+
+		for (m_sweeps = 1; m_sweeps <= MAXSWEEPS; ++m_sweeps) {
+			std::atomic<int> rotations(0);
+			for (int round = 0; round < np - 1; ++round) {
+				NUMCPP::Parallel::forEach(nchunks, [&](int ch) {
+					DOT<T, T> dot;
+					NRM2<T, T> nrm2;
+					ROT<T> rot;
+					int nrot = 0;
+					for (int i = ch; i < npairs; i += nchunks) {
+						int p = players[i], q = players[np - 1 - i];
+						if (p >= n || q >= n)
+							continue;
+						T* gp = g + p * ldg;
+						T* gq = g + q * ldg;
+						T a = nrm2(m, gp, 1), b = nrm2(m, gq, 1);
+						if (a == zero || b == zero)
+							continue;
+						T cs = dot(m, gp, gq) / a / b;
+						if (std::abs(cs) <= tol)
+							continue;
+						++nrot;
+						// rotation which orthogonalizes the columns p and q
+						T zeta = (b / a - a / b) * half / cs;
+						T t = (zeta >= zero ? one : -one) / (std::abs(zeta) + std::sqrt(one + zeta * zeta));
+						T c = one / std::sqrt(one + t * t), s = c * t;
+						// g(p) = c * g(p) - s * g(q), g(q) = s * g(p) + c * g(q)
+						rot(m, gp, gq, c, -s);
+						if (v)
+							rot(n, v + p * ldv, v + q * ldv, c, -s);
+					}
+					rotations += nrot;
+					}, nchunks);
+				// next round
+				std::rotate(players.begin() + 1, players.end() - 1, players.end());
+			}
+			if (rotations == 0)
+				return;
+		}
+		m_sweeps = MAXSWEEPS;
+		m_info = 1;
+	}
+}
+
+#endif
@@ -2,6 +2,7 @@
 #define __lcpp_getrf2_h
 
 #include "matrix.h"
+#include "iamax.h"
 
 namespace LCPP {
 
@@ -63,7 +64,8 @@ namespace LCPP {
             T zero = NUMCPP::CONSTANTS<T>::zero, one = NUMCPP::CONSTANTS<T>::one;
             // Find pivot and test for singularity
             NUMCPP::Sequence<T>col = A.column(0);
-            int imax = col.imax();
+            IAMAX<T> iamax;
+            int imax = iamax(col);
             pivots(0) = imax;
             T cmax = col(imax);
             if (cmax != zero) {
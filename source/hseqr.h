@@ -0,0 +1,102 @@
+#ifndef __lcpp_hseqr_h
+#define __lcpp_hseqr_h
+
+#include <algorithm>
+#include <stdexcept>
+#include "matrix.h"
+#include "matrix_0.h"
+#include "laenv.h"
+#include "lahqr.h"
+#include "laqr0.h"
+
+namespace LCPP {
+	/// <summary>
+	/// Computes the eigenvalues of an upper Hessenberg matrix H and, optionally, the matrices T and Z from the
+	/// Schur decomposition H = Z * T * Z', where T is an upper quasi-triangular matrix (the Schur form),
+	/// and Z is the orthogonal matrix of Schur vectors.
+	/// H is assumed to be already upper triangular in rows and columns 0:ilo-1 and ihi+1:n-1 (see GEBAL;
+	/// ilo and ihi are 0-based and inclusive, by default 0 and n-1).
+	/// If wantt, H is overwritten by T (2 x 2 diagonal blocks in standard form, see LANV2).
+	/// If wantz, Z must contain on entry an orthogonal matrix Q (usually the one from the reduction to
+	/// the Hessenberg form, see ORGHR, or the identity); on exit it contains Q * Z.
+	/// The eigenvalues are stored in wr, wi (complex conjugate pairs are consecutive, positive imaginary part
+	/// first), in the same order as on the diagonal of T when wantt.
+	/// Small matrices are processed by the double-shift QR algorithm (LAHQR), larger ones by the multishift
+	/// QR algorithm with aggressive early deflation (LAQR0).
+	/// info() = 0 on success, or k > 0 if the algorithm failed to compute all the eigenvalues: the elements
+	/// k:ihi (0-based) of wr and wi contain those which have been successfully computed.
+	/// </summary>
+	/// <typeparam name="T"></typeparam>
+	template<typename T>
+	class HSEQR {
+	public:
+
+		HSEQR() :m_info(0) {}
+
+		void operator()(bool wantt, bool wantz, int ilo, int ihi, NUMCPP::FastMatrix<T> H, NUMCPP::Sequence<T> wr, NUMCPP::Sequence<T> wi, NUMCPP::FastMatrix<T> Z);
+		void operator()(bool wantt, bool wantz, NUMCPP::FastMatrix<T> H, NUMCPP::Sequence<T> wr, NUMCPP::Sequence<T> wi, NUMCPP::FastMatrix<T> Z) {
+			(*this)(wantt, wantz, 0, H.getNrows() - 1, H, wr, wi, Z);
+		}
+
+		int info() const {
+			return m_info;
+		}
+
+	private:
+
+		int m_info;
+		LAQR0<T> m_laqr0;
+	};
+
+	template<typename T>
+	void HSEQR<T>::operator()(bool wantt, bool wantz, int ilo, int ihi, NUMCPP::FastMatrix<T> H, NUMCPP::Sequence<T> wr, NUMCPP::Sequence<T> wi, NUMCPP::FastMatrix<T> Z) {
+		int n = H.getNrows();
+		if (!H.isSquare())
+			throw std::invalid_argument("Not square matrix in hseqr");
+		if (ilo < 0 || ilo > std::max(0, n - 1) || ihi < std::min(ilo, n - 1) || ihi >= n || wr.length() < n || wi.length() < n)
+			throw std::invalid_argument("Invalid arguments in hseqr");
+		if (wantz && (Z.getNrows() != n || Z.getNcols() != n))
+			throw std::invalid_argument("Invalid dimensions in hseqr");
+		m_info = 0;
+		if (n == 0)
+			return;
+		T zero = NUMCPP::CONSTANTS<T>::zero;
+		// eigenvalues isolated by GEBAL
+		for (int i = 0; i < ilo; ++i) {
+			wr(i) = H(i, i);
+			wi(i) = zero;
+		}
+		for (int i = ihi + 1; i < n; ++i) {
+			wr(i) = H(i, i);
+			wi(i) = zero;
+		}
+		if (ilo == ihi) {
+			wr(ilo) = H(ilo, ilo);
+			wi(ilo) = zero;
+			return;
+		}
+		LAENV laenv;
+		int nmin = std::max(15, laenv(LAENV::QRMinimum, "HSEQR", "", n, ilo, ihi, -1));
+		if (n > nmin) {
+			m_laqr0(wantt, wantz, ilo, ihi, H, wr, wi, ilo, ihi, Z);
+			m_info = m_laqr0.info();
+		}
+		else {
+			LAHQR<T> lahqr;
+			lahqr(wantt, wantz, ilo, ihi, H, wr, wi, ilo, ihi, Z);
+			m_info = lahqr.info();
+			if (m_info > 0) {
+				// rare LAHQR failure: LAQR0 sometimes succeeds when LAHQR fails
+				m_laqr0(wantt, wantz, ilo, m_info - 1, H, wr, wi, ilo, ihi, Z);
+				m_info = m_laqr0.info();
+			}
+		}
+		// clears out the trash
+		if ((wantt || m_info != 0) && n > 2) {
+			for (int c = 0; c < n - 2; ++c)
+				H.column(c).drop(c + 2, 0).set(zero);
+		}
+	}
+}
+
+#endif
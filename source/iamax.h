@@ -0,0 +1,56 @@
+#ifndef __lcpp_iamax_h
+#define __lcpp_iamax_h
+
+#include "sequence.h"
+
+namespace LCPP {
+
+    /// <summary>
+    /// Index (0-based) of the first element with the largest absolute value, -1 if n == 0
+    /// </summary>
+    template <typename T>
+    class IAMAX {
+    public:
+
+        IAMAX() {}
+
+        int operator()(int n, const T* X, int incx) {
+            return apply(n, X, incx);
+        }
+
+        int operator()(int n, const T* X) {
+            return apply(n, X, 1);
+        }
+
+        int operator()(NUMCPP::Sequence<T> X) {
+            return X.iamax();
+        }
+
+    private:
+
+        int apply(int n, const T* X, int incx);
+    };
+
+
+    template <typename T>
+    int IAMAX<T>::apply(int n, const T* X, int incx) {
+        if (n <= 0)
+            return -1;
+        if constexpr (std::is_same<T, double>::value) {
+            if (incx == 1 && n >= NUMCPP::SIMD::MIN_LENGTH)
+                return NUMCPP::SIMD::iamax(n, X);
+        }
+        T amax = std::abs(X[0]);
+        int imax = 0;
+        for (int i = 1, j = incx; i < n; ++i, j += incx) {
+            T cur = std::abs(X[j]);
+            if (cur > amax) {
+                amax = cur;
+                imax = i;
+            }
+        }
+        return imax;
+    }
+
+}
+#endif
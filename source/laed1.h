@@ -0,0 +1,240 @@
+#ifndef __lcpp_laed1_h
+#define __lcpp_laed1_h
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <vector>
+#include "matrix.h"
+#include "matrix_0.h"
+#include "parallel.h"
+#include "gemm.h"
+#include "rot.h"
+#include "laed4.h"
+
+namespace LCPP {
+	/// <summary>
+	/// Merge step of the divide-and-conquer symmetric tridiagonal eigensolver (see STEDC).
+	/// On entry, d(0:n1-1) and d(n1:n-1) contain the eigenvalues (in ascending order) of two tridiagonal
+	/// blocks T1 and T2, and the n x n matrix Q = diag(Q1, Q2) contains their eigenvectors. The tridiagonal
+	/// matrix to solve is diag(T1, T2) + |rho| * u * u', u = (0, ..., 0, 1, sign(rho), 0, ..., 0), rho being
+	/// the off-diagonal element at the cut (the diagonal elements at the cut have been decreased by |rho|).
+	/// On exit, d contains its eigenvalues in ascending order and Q its eigenvectors.
+	/// The problem is the rank one modification D + rho' * z * z' of a diagonal matrix (z is made of the last
+	/// row of Q1 and of the first row of Q2):
+	/// 1. Deflation: the eigenpairs with a negligible component of z are kept unchanged, and the pairs of close
+	///    eigenvalues are rotated so that one of them can be deflated.
+	/// 2. The k remaining eigenvalues are the roots of the secular equation (LAED4). The components of z are
+	///    recomputed from the roots (Gu - Eisenstat), so that the eigenvectors are numerically orthogonal.
+	/// 3. The eigenvectors are Q * S, S (k x k) being the eigenvectors of the secular problem. The columns of
+	///    Q are grouped by type (non-zero in the rows of Q1 only, in all the rows, in the rows of Q2 only), so
+	///    that two GEMM with the non-zero blocks are sufficient.
+	/// The roots and the products are computed on nthreads threads (0 = default concurrency).
+	/// info() = 0 on success, 1 if a secular equation did not converge.
+	/// </summary>
+	/// <typeparam name="T"></typeparam>
+	template<typename T>
+	class LAED1 {
+	public:
+
+		LAED1() :m_info(0) {}
+
+		void operator()(NUMCPP::Sequence<T> d, NUMCPP::FastMatrix<T> Q, T rho, int n1, int nthreads = 0);
+
+		int info() const {
+			return m_info;
+		}
+
+	private:
+
+		// C = A * B, by blocks of columns of C
+		static void multiply(int nthreads, NUMCPP::FastMatrix<T> A, NUMCPP::FastMatrix<T> B, NUMCPP::FastMatrix<T> C);
+
+		int m_info;
+	};
+
+	template<typename T>
+	void LAED1<T>::multiply(int nthreads, NUMCPP::FastMatrix<T> A, NUMCPP::FastMatrix<T> B, NUMCPP::FastMatrix<T> C) {
+		int n = C.getNcols();
+		T zero = NUMCPP::CONSTANTS<T>::zero, one = NUMCPP::CONSTANTS<T>::one;
+		if (A.getNcols() == 0) {
+			for (int j = 0; j < n; ++j)
+				C.column(j).set(zero);
+			return;
+		}
+		int nblocks = std::min(std::max(1, nthreads), std::max(1, n / 32));
+		int nb = (n + nblocks - 1) / nblocks;
+		NUMCPP::Parallel::forEach(nblocks, [&](int b) {
+			int c0 = b * nb, nc = std::min(nb, n - c0);
+			if (nc <= 0)
+				return;
+			GEMM<T> gemm;
+			gemm(false, false, one, A, B.extract(0, B.getNrows(), c0, nc), zero, C.extract(0, C.getNrows(), c0, nc));
+			}, nthreads);
+	}
+
+	template<typename T>
+	void LAED1<T>::operator()(NUMCPP::Sequence<T> d, NUMCPP::FastMatrix<T> Q, T rho, int n1, int nthreads) {
+		int n = d.length(), n2 = n - n1;
+		m_info = 0;
+		if (nthreads <= 0)
+			nthreads = NUMCPP::Parallel::concurrency();
+		T zero = NUMCPP::CONSTANTS<T>::zero, one = NUMCPP::CONSTANTS<T>::one, two = NUMCPP::CONSTANTS<T>::two;
+		T eps = std::numeric_limits<T>::epsilon();
+
+		// z = (Q1(n1-1, :), sign(rho) * Q2(0, :)) / sqrt(2), rho = 2 * |rho|, so that z'z = 1
+		std::vector<T> z(n);
+		T scale = one / std::sqrt(two);
+		for (int j = 0; j < n1; ++j)
+			z[j] = Q(n1 - 1, j) * scale;
+		if (rho < zero)
+			scale = -scale;
+		for (int j = n1; j < n; ++j)
+			z[j] = Q(n1, j) * scale;
+		rho = two * std::abs(rho);
+
+		// permutation which sorts d (merge of the two sorted lists)
+		std::vector<int> indx(n);
+		std::iota(indx.begin(), indx.end(), 0);
+		std::inplace_merge(indx.begin(), indx.begin() + n1, indx.end(), [&](int l, int r) {return d(l) < d(r); });
+
+		// 1. deflation
+		T dmax = zero, zmax = zero;
+		for (int j = 0; j < n; ++j) {
+			dmax = std::max(dmax, std::abs(d(j)));
+			zmax = std::max(zmax, std::abs(z[j]));
+		}
+		T tol = 8 * eps * std::max(dmax, zmax);
+		// type of the columns of Q: 1 = rows of Q1, 2 = all the rows, 3 = rows of Q2 (deflated columns are not used)
+		std::vector<int> coltyp(n), keep, defl;
+		for (int j = 0; j < n; ++j)
+			coltyp[j] = j < n1 ? 1 : 3;
+		int ldq = Q.getColumnIncrement();
+		T* q = Q.ptr();
+		ROT<T> rot;
+		int jlam = -1;
+		for (int t = 0; t < n; ++t) {
+			int nj = indx[t];
+			if (rho * std::abs(z[nj]) <= tol) {
+				defl.push_back(nj);
+				continue;
+			}
+			if (jlam < 0) {
+				jlam = nj;
+				continue;
+			}
+			// close eigenvalues: a rotation zeroes z(jlam)
+			T s = z[jlam], c = z[nj];
+			T tau = std::hypot(c, s), dd = d(nj) - d(jlam);
+			c /= tau;
+			s = -s / tau;
+			if (std::abs(dd * c * s) <= tol) {
+				z[nj] = tau;
+				z[jlam] = zero;
+				if (coltyp[nj] != coltyp[jlam])
+					coltyp[nj] = 2;
+				rot(n, q + jlam * ldq, q + nj * ldq, c, s);
+				T dl = d(jlam) * c * c + d(nj) * s * s;
+				d(nj) = d(jlam) * s * s + d(nj) * c * c;
+				d(jlam) = dl;
+				defl.push_back(jlam);
+			}
+			else
+				keep.push_back(jlam);
+			jlam = nj;
+		}
+		if (jlam >= 0)
+			keep.push_back(jlam);
+		int k = (int)keep.size();
+
+		// eigenvalues and columns of the result (not sorted)
+		std::vector<T> vals(n);
+		NUMCPP::Matrix<T> W(n, n);
+		if (k > 0) {
+			// 2. secular equation
+			NUMCPP::DataBlock<T> dlamda(k), w(k);
+			for (int t = 0; t < k; ++t) {
+				dlamda.all()(t) = d(keep[t]);
+				w.all()(t) = z[keep[t]];
+			}
+			NUMCPP::Matrix<T> S(k, k);
+			int nthr = k < 64 ? 1 : nthreads;
+			int nchunks = std::min(k, 4 * nthr);
+			std::atomic<int> failed(0);
+			NUMCPP::Parallel::forEach(nchunks, [&](int ch) {
+				LAED4<T> laed4;
+				for (int r = ch; r < k; r += nchunks) {
+					vals[r] = laed4(r, dlamda.all(), w.all(), rho, S.column(r));
+					if (laed4.info() != 0)
+						failed = 1;
+				}
+				}, nthr);
+			if (failed)
+				m_info = 1;
+			if (k == 1) {
+				S(0, 0) = one;
+			}
+			else {
+				// w(i)^2 = -prod (dlamda(j) - lambda(i)) / prod (dlamda(j) - dlamda(i)) (Lowner)
+				NUMCPP::Parallel::forEach(nchunks, [&](int ch) {
+					for (int i = ch; i < k; i += nchunks) {
+						T di = dlamda.all()(i), wi = S(i, i);
+						for (int j = 0; j < k; ++j)
+							if (j != i)
+								wi *= S(i, j) / (di - dlamda.all()(j));
+						wi = std::sqrt(-wi);
+						w.all()(i) = w.all()(i) >= zero ? wi : -wi;
+					}
+					}, nthr);
+				// eigenvectors of the secular problem: S(:, r) = w / delta / ||w / delta||
+				NUMCPP::Parallel::forEach(nchunks, [&](int ch) {
+					for (int r = ch; r < k; r += nchunks) {
+						NUMCPP::Sequence<T> s = S.column(r);
+						T nrm = zero;
+						for (int i = 0; i < k; ++i) {
+							s(i) = w.all()(i) / s(i);
+							nrm += s(i) * s(i);
+						}
+						s.mul(one / std::sqrt(nrm));
+					}
+					}, nthr);
+			}
+
+			// 3. eigenvectors: the non deflated columns of Q are packed by type
+			int k1 = 0, k2 = 0;
+			for (int t = 0; t < k; ++t) {
+				if (coltyp[keep[t]] == 1)
+					++k1;
+				else if (coltyp[keep[t]] == 2)
+					++k2;
+			}
+			int pos[4] = { 0, 0, k1, k1 + k2 };
+			NUMCPP::Matrix<T> Qp(n, k), Sp(k, k);
+			for (int t = 0; t < k; ++t) {
+				int p = pos[coltyp[keep[t]]]++;
+				Qp.column(p).copy(Q.column(keep[t]));
+				Sp.row(p).copy(S.row(t));
+			}
+			NUMCPP::FastMatrix<T> Wk = W.extract(0, n, 0, k);
+			multiply(nthreads, Qp.extract(0, n1, 0, k1 + k2), Sp.extract(0, k1 + k2, 0, k), Wk.extract(0, n1, 0, k));
+			multiply(nthreads, Qp.extract(n1, n2, k1, k - k1), Sp.extract(k1, k - k1, 0, k), Wk.extract(n1, n2, 0, k));
+		}
+		for (int t = 0; t < n - k; ++t) {
+			vals[k + t] = d(defl[t]);
+			W.column(k + t).copy(Q.column(defl[t]));
+		}
+
+		// sorted eigenvalues and eigenvectors
+		std::vector<int> order(n);
+		std::iota(order.begin(), order.end(), 0);
+		std::stable_sort(order.begin(), order.end(), [&](int l, int r) {return vals[l] < vals[r]; });
+		for (int t = 0; t < n; ++t) {
+			d(t) = vals[order[t]];
+			Q.column(t).copy(W.column(order[t]));
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,162 @@
+#ifndef __lcpp_laed4_h
+#define __lcpp_laed4_h
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include "matrix.h"
+
+namespace LCPP {
+	/// <summary>
+	/// Computes the i-th (0-based) eigenvalue of the rank one modification of a diagonal matrix
+	///     D + rho * z * z'
+	/// where d(0) < d(1) < ... < d(k-1) and rho > 0, i.e. the i-th root of the secular equation
+	///     f(lambda) = 1 + rho * sum z(j)^2 / (d(j) - lambda) = 0
+	/// The root lies in ]d(i), d(i+1)[ (or ]d(k-1), d(k-1) + rho * z'z] for the last one). The equation is
+	/// solved for tau = lambda - d(org), org being the pole closest to the root, so that the differences
+	///     delta(j) = (d(j) - d(org)) - tau = d(j) - lambda
+	/// are computed accurately; they are returned in delta (they define the eigenvector, see LAED1).
+	/// Each step interpolates the two parts of the sum (poles below and above the root) by simple rationals
+	/// with the poles of the interval ("middle way"); the root is kept inside a bracket, which is bisected
+	/// when the interpolation leaves it.
+	/// info() = 0 on success, 1 if the iteration did not converge.
+	/// </summary>
+	/// <typeparam name="T"></typeparam>
+	template<typename T>
+	class LAED4 {
+	public:
+
+		LAED4() :m_info(0) {}
+
+		T operator()(int i, NUMCPP::Sequence<T> d, NUMCPP::Sequence<T> z, T rho, NUMCPP::Sequence<T> delta);
+
+		int info() const {
+			return m_info;
+		}
+
+	private:
+
+		static const int MAXIT = 100;
+
+		int m_info;
+		// d(j) - d(org)
+		std::vector<T> m_dd;
+	};
+
+	template<typename T>
+	T LAED4<T>::operator()(int i, NUMCPP::Sequence<T> d, NUMCPP::Sequence<T> z, T rho, NUMCPP::Sequence<T> delta) {
+		int k = d.length();
+		m_info = 0;
+		T zero = NUMCPP::CONSTANTS<T>::zero, one = NUMCPP::CONSTANTS<T>::one, two = NUMCPP::CONSTANTS<T>::two, half = NUMCPP::CONSTANTS<T>::half;
+		if (k == 1) {
+			T tau = rho * z(0) * z(0);
+			delta(0) = -tau;
+			return d(0) + tau;
+		}
+		T eps = std::numeric_limits<T>::epsilon();
+		// the poles of the interval are ii and ii+1; psi is the sum on j <= ii and phi on j > ii
+		int ii = std::min(i, k - 2);
+		int org;
+		T lo, hi;
+		if (i < k - 1) {
+			// the sign of f at the middle of the interval gives the closest pole
+			T mid = half * (d(i + 1) - d(i));
+			T f = one;
+			for (int j = 0; j < k; ++j)
+				f += rho * z(j) * z(j) / ((d(j) - d(i)) - mid);
+			if (f >= zero) {
+				org = i;
+				lo = zero;
+				hi = mid;
+			}
+			else {
+				org = i + 1;
+				lo = -mid;
+				hi = zero;
+			}
+		}
+		else {
+			org = k - 1;
+			lo = zero;
+			hi = zero;
+			for (int j = 0; j < k; ++j)
+				hi += z(j) * z(j);
+			hi *= rho;
+		}
+		T dorg = d(org);
+		m_dd.resize(k);
+		for (int j = 0; j < k; ++j)
+			m_dd[j] = d(j) - dorg;
+
+		T tau = half * (lo + hi);
+		for (int iter = 0; ; ++iter) {
+			if (iter == MAXIT) {
+				m_info = 1;
+				break;
+			}
+			T psi = zero, dpsi = zero, phi = zero, dphi = zero;
+			for (int j = 0; j <= ii; ++j) {
+				T t = z(j) / (m_dd[j] - tau);
+				psi += z(j) * t;
+				dpsi += t * t;
+			}
+			for (int j = ii + 1; j < k; ++j) {
+				T t = z(j) / (m_dd[j] - tau);
+				phi += z(j) * t;
+				dphi += t * t;
+			}
+			T f = one + rho * (psi + phi);
+			T erretm = 8 * (one + rho * (std::abs(psi) + std::abs(phi))) + 3 * std::abs(f) + std::abs(tau) * rho * (dpsi + dphi);
+			if (std::abs(f) <= eps * erretm)
+				break;
+			// f is increasing in the interval
+			if (f < zero)
+				lo = tau;
+			else
+				hi = tau;
+			// model: f(tau + eta) = c + b / (dp - eta) + e / (dq - eta), which interpolates psi and phi
+			T dp = m_dd[ii] - tau, dq = m_dd[ii + 1] - tau;
+			T b = rho * dpsi * dp * dp, e = rho * dphi * dq * dq;
+			T c = f - b / dp - e / dq;
+			// c * eta^2 - (c * (dp + dq) + b + e) * eta + dp * dq * f = 0
+			T qb = c * (dp + dq) + b + e, qc = dp * dq * f;
+			T next = half * (lo + hi);
+			T disc = qb * qb - 4 * c * qc;
+			if (disc >= zero) {
+				T sq = std::sqrt(disc), eta[2];
+				int neta = 0;
+				if (c == zero) {
+					if (qb != zero)
+						eta[neta++] = qc / qb;
+				}
+				else if (qb >= zero) {
+					eta[neta++] = (qb + sq) / (two * c);
+					if (qb + sq != zero)
+						eta[neta++] = two * qc / (qb + sq);
+				}
+				else {
+					eta[neta++] = (qb - sq) / (two * c);
+					eta[neta++] = two * qc / (qb - sq);
+				}
+				for (int l = 0; l < neta; ++l) {
+					T t = tau + eta[l];
+					if (t > lo && t < hi) {
+						next = t;
+						break;
+					}
+				}
+			}
+			if (next == tau || hi - lo <= two * eps * std::max(std::abs(lo), std::abs(hi))) {
+				tau = next;
+				break;
+			}
+			tau = next;
+		}
+		for (int j = 0; j < k; ++j)
+			delta(j) = m_dd[j] - tau;
+		return dorg + tau;
+	}
+}
+
+#endif
@@ -13,7 +13,14 @@ namespace LCPP{
 			Minimum=2,
 			CrossOver=3,
 			MinimumColumn = 5,
-			CrossOverSVD=6
+			CrossOverSVD=6,
+			// maximum size of the subproblems at the bottom of the divide-and-conquer tree (STEDC)
+			DCLeaf = 9,
+			// parameters of the multishift QR algorithm (HSEQR). n1 = n, n2 = ilo, n3 = ihi
+			QRMinimum = 12,
+			QRWindow = 13,
+			QRNibble = 14,
+			QRShifts = 15
 
 		};
 		
@@ -0,0 +1,93 @@
+#ifndef __lcpp_laev2_h
+#define __lcpp_laev2_h
+
+#include <cmath>
+#include "constants.h"
+
+namespace LCPP {
+	/// <summary>
+	/// Computes the eigendecomposition of a 2 x 2 symmetric matrix
+	///     [ a  b ]
+	///     [ b  c ]
+	/// rt1 is the eigenvalue of larger absolute value, rt2 the other one, and (cs1, sn1) is the unit right
+	/// eigenvector of rt1:
+	///     [ cs1  sn1 ] [ a  b ] [ cs1 -sn1 ]   [ rt1  0  ]
+	///     [-sn1  cs1 ] [ b  c ] [ sn1  cs1 ] = [  0  rt2 ]
+	/// rt1 is accurate to a few ulps; rt2 may be inaccurate if there is massive cancellation in the determinant.
+	/// </summary>
+	/// <typeparam name="T"></typeparam>
+	template<typename T>
+	class LAEV2 {
+	public:
+
+		LAEV2() {}
+
+		void operator()(T a, T b, T c, T& rt1, T& rt2, T& cs1, T& sn1) const;
+	};
+
+	template<typename T>
+	void LAEV2<T>::operator()(T a, T b, T c, T& rt1, T& rt2, T& cs1, T& sn1) const {
+		T zero = NUMCPP::CONSTANTS<T>::zero, one = NUMCPP::CONSTANTS<T>::one, half = NUMCPP::CONSTANTS<T>::half;
+		T sm = a + c, df = a - c, adf = std::abs(df), tb = b + b, ab = std::abs(tb);
+		T acmx = a, acmn = c;
+		if (std::abs(a) <= std::abs(c)) {
+			acmx = c;
+			acmn = a;
+		}
+		T rt;
+		if (adf > ab)
+			rt = adf * std::sqrt(one + (ab / adf) * (ab / adf));
+		else if (adf < ab)
+			rt = ab * std::sqrt(one + (adf / ab) * (adf / ab));
+		else
+			rt = ab * std::sqrt((T)2);
+		int sgn1, sgn2;
+		if (sm < zero) {
+			rt1 = half * (sm - rt);
+			sgn1 = -1;
+			// order of execution important to get full accuracy
+			rt2 = (acmx / rt1) * acmn - (b / rt1) * b;
+		}
+		else if (sm > zero) {
+			rt1 = half * (sm + rt);
+			sgn1 = 1;
+			rt2 = (acmx / rt1) * acmn - (b / rt1) * b;
+		}
+		else {
+			rt1 = half * rt;
+			rt2 = -half * rt;
+			sgn1 = 1;
+		}
+		// eigenvector
+		T cs;
+		if (df >= zero) {
+			cs = df + rt;
+			sgn2 = 1;
+		}
+		else {
+			cs = df - rt;
+			sgn2 = -1;
+		}
+		if (std::abs(cs) > ab) {
+			T ct = -tb / cs;
+			sn1 = one / std::sqrt(one + ct * ct);
+			cs1 = ct * sn1;
+		}
+		else if (ab == zero) {
+			cs1 = one;
+			sn1 = zero;
+		}
+		else {
+			T tn = -cs / tb;
+			cs1 = one / std::sqrt(one + tn * tn);
+			sn1 = tn * cs1;
+		}
+		if (sgn1 == sgn2) {
+			T tn = cs1;
+			cs1 = -sn1;
+			sn1 = tn;
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,280 @@
+#ifndef __lcpp_laexc_h
+#define __lcpp_laexc_h
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "matrix.h"
+#include "matrix_0.h"
+#include "larfg.h"
+#include "lartg.h"
+#include "lanv2.h"
+#include "rot.h"
+
+namespace LCPP {
+	/// <summary>
+	/// Swaps the adjacent diagonal blocks T11 (n1 x n1) and T22 (n2 x n2), starting at the row j1 (0-based),
+	/// of an upper quasi-triangular matrix T in Schur canonical form, by an orthogonal similarity
+	/// transformation. n1 and n2 are 1 or 2. If wantq, the transformation is accumulated in Q (Q = Q * U).
+	/// info() = 1 if the swap was rejected because the transformed matrix would be too far from
+	/// the Schur form (the blocks are then too close); T and Q are unchanged in that case.
+	/// </summary>
+	/// <typeparam name="T"></typeparam>
+	template<typename T>
+	class LAEXC {
+	public:
+
+		LAEXC() :m_info(0) {}
+
+		void operator()(bool wantq, NUMCPP::FastMatrix<T> A, NUMCPP::FastMatrix<T> Q, int j1, int n1, int n2);
+
+		int info() const {
+			return m_info;
+		}
+
+	private:
+
+		// solves T11 * X - X * T22 = T12 (d contains the (n1+n2) x (n1+n2) diagonal block)
+		static void sylvester(const T* d, int ldd, int n1, int n2, T* x, int ldx);
+		// applies the reflector I - tau * u * u' (u has 3 elements) to the m x n matrix a from the left or the right
+		static void reflect(Side side, const T* u, T tau, T* a, int lda, int m, int n);
+
+		int m_info;
+	};
+
+	template<typename T>
+	void LAEXC<T>::sylvester(const T* d, int ldd, int n1, int n2, T* x, int ldx) {
+		// Kronecker form: (I (x) T11 - T22' (x) I) vec(X) = vec(T12), solved by Gaussian elimination
+		// with complete pivoting. Small pivots are perturbed
+		T zero = NUMCPP::CONSTANTS<T>::zero;
+		int n = n1 * n2;
+		T k[4][4], b[4];
+		int jpiv[4];
+		T eps = std::numeric_limits<T>::epsilon(), smin = zero;
+		for (int c = 0; c < n1 + n2; ++c)
+			for (int r = 0; r < n1 + n2; ++r)
+				smin = std::max(smin, std::abs(d[r + c * ldd]));
+		smin = std::max(eps * smin, NUMCPP::CONSTANTS<T>::safe_min / eps);
+		for (int j = 0; j < n2; ++j) {
+			for (int i = 0; i < n1; ++i) {
+				int row = i + j * n1;
+				b[row] = d[i + (n1 + j) * ldd];
+				for (int q = 0; q < n2; ++q) {
+					for (int p = 0; p < n1; ++p) {
+						T v = zero;
+						if (q == j)
+							v += d[i + p * ldd];
+						if (p == i)
+							v -= d[n1 + q + (n1 + j) * ldd];
+						k[row][p + q * n1] = v;
+					}
+				}
+			}
+		}
+		for (int i = 0; i < n; ++i)
+			jpiv[i] = i;
+		for (int i = 0; i < n; ++i) {
+			int ip = i, jp = i;
+			T xmax = zero;
+			for (int r = i; r < n; ++r) {
+				for (int c = i; c < n; ++c) {
+					if (std::abs(k[r][c]) > xmax) {
+						xmax = std::abs(k[r][c]);
+						ip = r;
+						jp = c;
+					}
+				}
+			}
+			if (ip != i) {
+				for (int c = 0; c < n; ++c)
+					std::swap(k[ip][c], k[i][c]);
+				std::swap(b[ip], b[i]);
+			}
+			if (jp != i) {
+				for (int r = 0; r < n; ++r)
+					std::swap(k[r][jp], k[r][i]);
+				std::swap(jpiv[jp], jpiv[i]);
+			}
+			if (std::abs(k[i][i]) < smin)
+				k[i][i] = smin;
+			for (int r = i + 1; r < n; ++r) {
+				T f = k[r][i] / k[i][i];
+				for (int c = i + 1; c < n; ++c)
+					k[r][c] -= f * k[i][c];
+				b[r] -= f * b[i];
+			}
+		}
+		T y[4];
+		for (int i = n - 1; i >= 0; --i) {
+			T s = b[i];
+			for (int c = i + 1; c < n; ++c)
+				s -= k[i][c] * y[c];
+			y[i] = s / k[i][i];
+		}
+		for (int i = 0; i < n; ++i) {
+			int p = jpiv[i];
+			x[p % n1 + (p / n1) * ldx] = y[i];
+		}
+	}
+
+	template<typename T>
+	void LAEXC<T>::reflect(Side side, const T* u, T tau, T* a, int lda, int m, int n) {
+		if (side == Side::Left) {
+			for (int c = 0; c < n; ++c) {
+				T* col = a + c * lda;
+				T s = tau * (u[0] * col[0] + u[1] * col[1] + u[2] * col[2]);
+				col[0] -= s * u[0];
+				col[1] -= s * u[1];
+				col[2] -= s * u[2];
+			}
+		}
+		else {
+			T* c0 = a, * c1 = a + lda, * c2 = a + 2 * lda;
+			for (int r = 0; r < m; ++r) {
+				T s = tau * (u[0] * c0[r] + u[1] * c1[r] + u[2] * c2[r]);
+				c0[r] -= s * u[0];
+				c1[r] -= s * u[1];
+				c2[r] -= s * u[2];
+			}
+		}
+	}
+
+	template<typename T>
+	void LAEXC<T>::operator()(bool wantq, NUMCPP::FastMatrix<T> A, NUMCPP::FastMatrix<T> Q, int j1, int n1, int n2) {
+		m_info = 0;
+		int n = A.getNrows();
+		if (n == 0 || n1 == 0 || n2 == 0 || j1 + n1 >= n)
+			return;
+		T zero = NUMCPP::CONSTANTS<T>::zero, one = NUMCPP::CONSTANTS<T>::one;
+		int lda = A.getColumnIncrement();
+		int j2 = j1 + 1, j3 = j1 + 2, j4 = j1 + 3;
+		ROT<T> rot;
+		LANV2<T> lanv2;
+		if (n1 == 1 && n2 == 1) {
+			// swaps two 1 x 1 blocks
+			T t11 = A(j1, j1), t22 = A(j2, j2);
+			T cs, sn, temp;
+			LARTG<T> lartg;
+			lartg(A(j1, j2), t22 - t11, cs, sn, temp);
+			if (j3 < n)
+				rot(n - j1 - 2, &A(j1, j3), lda, &A(j2, j3), lda, cs, sn);
+			rot(j1, &A(0, j1), 1, &A(0, j2), 1, cs, sn);
+			A(j1, j1) = t22;
+			A(j2, j2) = t11;
+			if (wantq)
+				rot(Q.getNrows(), &Q(0, j1), 1, &Q(0, j2), 1, cs, sn);
+			return;
+		}
+
+		// swapping involves at least one 2 x 2 block: copies the diagonal block of order n1+n2
+		int nd = n1 + n2;
+		T d[16], x[4];
+		T dnorm = zero;
+		for (int c = 0; c < nd; ++c) {
+			for (int r = 0; r < nd; ++r) {
+				d[r + 4 * c] = A(j1 + r, j1 + c);
+				dnorm = std::max(dnorm, std::abs(d[r + 4 * c]));
+			}
+		}
+		T eps = std::numeric_limits<T>::epsilon();
+		T thresh = std::max(10 * eps * dnorm, NUMCPP::CONSTANTS<T>::safe_min / eps);
+		// solves T11 * X - X * T22 = T12
+		sylvester(d, 4, n1, n2, x, 2);
+		LARFG<T> larfg;
+		T* pa = &A(0, 0);
+		if (n1 == 1 && n2 == 2) {
+			// reflector H such that (1, X11, X12) * H = (0, 0, *)
+			T u[3] = { one, x[0], x[2] };
+			T tau = larfg(3, u[2], u, 1);
+			u[2] = one;
+			T t11 = A(j1, j1);
+			// tentative swap on the diagonal block
+			reflect(Side::Left, u, tau, d, 4, 3, 3);
+			reflect(Side::Right, u, tau, d, 4, 3, 3);
+			if (std::max(std::max(std::abs(d[2]), std::abs(d[2 + 4])), std::abs(d[2 + 8] - t11)) > thresh) {
+				m_info = 1;
+				return;
+			}
+			reflect(Side::Left, u, tau, pa + j1 + j1 * lda, lda, 3, n - j1);
+			reflect(Side::Right, u, tau, pa + j1 * lda, lda, j2 + 1, 3);
+			A(j3, j1) = zero;
+			A(j3, j2) = zero;
+			A(j3, j3) = t11;
+			if (wantq)
+				reflect(Side::Right, u, tau, &Q(0, j1), Q.getColumnIncrement(), Q.getNrows(), 3);
+		}
+		else if (n1 == 2 && n2 == 1) {
+			// reflector H such that H * (-X11, -X21, 1)' = (*, 0, 0)'
+			T u[3] = { -x[0], -x[1], one };
+			T tau = larfg(3, u[0], u + 1, 1);
+			u[0] = one;
+			T t33 = A(j3, j3);
+			reflect(Side::Left, u, tau, d, 4, 3, 3);
+			reflect(Side::Right, u, tau, d, 4, 3, 3);
+			if (std::max(std::max(std::abs(d[1]), std::abs(d[2])), std::abs(d[0] - t33)) > thresh) {
+				m_info = 1;
+				return;
+			}
+			reflect(Side::Right, u, tau, pa + j1 * lda, lda, j3 + 1, 3);
+			reflect(Side::Left, u, tau, pa + j1 + j2 * lda, lda, 3, n - j1 - 1);
+			A(j1, j1) = t33;
+			A(j2, j1) = zero;
+			A(j3, j1) = zero;
+			if (wantq)
+				reflect(Side::Right, u, tau, &Q(0, j1), Q.getColumnIncrement(), Q.getNrows(), 3);
+		}
+		else {
+			// reflectors H(1), H(2) such that H(2) H(1) (-X; I) = (R; 0), R upper triangular
+			T u1[3] = { -x[0], -x[1], one };
+			T tau1 = larfg(3, u1[0], u1 + 1, 1);
+			u1[0] = one;
+			T temp = -tau1 * (x[2] + u1[1] * x[3]);
+			T u2[3] = { -temp * u1[1] - x[3], -temp * u1[2], one };
+			T tau2 = larfg(3, u2[0], u2 + 1, 1);
+			u2[0] = one;
+			reflect(Side::Left, u1, tau1, d, 4, 3, 4);
+			reflect(Side::Right, u1, tau1, d, 4, 4, 3);
+			reflect(Side::Left, u2, tau2, d + 1, 4, 3, 4);
+			reflect(Side::Right, u2, tau2, d + 4, 4, 4, 3);
+			if (std::max(std::max(std::abs(d[2]), std::abs(d[2 + 4])), std::max(std::abs(d[3]), std::abs(d[3 + 4]))) > thresh) {
+				m_info = 1;
+				return;
+			}
+			reflect(Side::Left, u1, tau1, pa + j1 + j1 * lda, lda, 3, n - j1);
+			reflect(Side::Right, u1, tau1, pa + j1 * lda, lda, j4 + 1, 3);
+			reflect(Side::Left, u2, tau2, pa + j2 + j1 * lda, lda, 3, n - j1);
+			reflect(Side::Right, u2, tau2, pa + j2 * lda, lda, j4 + 1, 3);
+			A(j3, j1) = zero;
+			A(j3, j2) = zero;
+			A(j4, j1) = zero;
+			A(j4, j2) = zero;
+			if (wantq) {
+				reflect(Side::Right, u1, tau1, &Q(0, j1), Q.getColumnIncrement(), Q.getNrows(), 3);
+				reflect(Side::Right, u2, tau2, &Q(0, j2), Q.getColumnIncrement(), Q.getNrows(), 3);
+			}
+		}
+
+		T wr1, wi1, wr2, wi2, cs, sn;
+		if (n2 == 2) {
+			// standardizes the new 2 x 2 block T11
+			lanv2(A(j1, j1), A(j1, j2), A(j2, j1), A(j2, j2), wr1, wi1, wr2, wi2, cs, sn);
+			if (j1 + 2 < n)
+				rot(n - j1 - 2, &A(j1, j1 + 2), lda, &A(j2, j1 + 2), lda, cs, sn);
+			rot(j1, &A(0, j1), 1, &A(0, j2), 1, cs, sn);
+			if (wantq)
+				rot(Q.getNrows(), &Q(0, j1), 1, &Q(0, j2), 1, cs, sn);
+		}
+		if (n1 == 2) {
+			// standardizes the new 2 x 2 block T22
+			int k3 = j1 + n2, k4 = k3 + 1;
+			lanv2(A(k3, k3), A(k3, k4), A(k4, k3), A(k4, k4), wr1, wi1, wr2, wi2, cs, sn);
+			if (k3 + 2 < n)
+				rot(n - k3 - 2, &A(k3, k3 + 2), lda, &A(k4, k3 + 2), lda, cs, sn);
+			rot(k3, &A(0, k3), 1, &A(0, k4), 1, cs, sn);
+			if (wantq)
+				rot(Q.getNrows(), &Q(0, k3), 1, &Q(0, k4), 1, cs, sn);
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,314 @@
+#ifndef __lcpp_lahqr_h
+#define __lcpp_lahqr_h
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include "matrix.h"
+#include "matrix_0.h"
+#include "larfg.h"
+#include "lanv2.h"
+#include "rot.h"
+
+namespace LCPP {
+	/// <summary>
+	/// Computes the eigenvalues and optionally the Schur factorization of an upper Hessenberg matrix H
+	/// by the double-shift implicit QR algorithm (one bulge of two shifts at a time). It is used as the
+	/// base case of the multishift QR algorithm (HSEQR) for small matrices and for the deflation windows.
+	/// Only the active block H(ilo:ihi, ilo:ihi) is reduced (0-based, inclusive); H is assumed to be already
+	/// upper quasi-triangular outside of it (see GEBAL).
+	/// If wantt, H is overwritten by the quasi-triangular Schur form T (2 x 2 diagonal blocks in standard
+	/// form, see LANV2); otherwise only the eigenvalues are computed.
+	/// If wantz, the transformations are applied to the rows iloz:ihiz of Z (Z = Z * Q).
+	/// The eigenvalues ilo:ihi are stored in wr, wi (complex conjugate pairs are consecutive, positive
+	/// imaginary part first).
+	/// info() = 0 on success, or k > 0 if the iteration failed to converge: only the eigenvalues k:ihi
+	/// (0-based) have been computed.
+	/// </summary>
+	/// <typeparam name="T"></typeparam>
+	template<typename T>
+	class LAHQR {
+	public:
+
+		LAHQR() :m_info(0) {}
+
+		void operator()(bool wantt, bool wantz, int ilo, int ihi, NUMCPP::FastMatrix<T> H, NUMCPP::Sequence<T> wr, NUMCPP::Sequence<T> wi,
+			int iloz, int ihiz, NUMCPP::FastMatrix<T> Z);
+
+		int info() const {
+			return m_info;
+		}
+
+	private:
+
+		int m_info;
+	};
+
+	template<typename T>
+	void LAHQR<T>::operator()(bool wantt, bool wantz, int ilo, int ihi, NUMCPP::FastMatrix<T> H, NUMCPP::Sequence<T> wr, NUMCPP::Sequence<T> wi,
+		int iloz, int ihiz, NUMCPP::FastMatrix<T> Z) {
+		int n = H.getNrows();
+		if (!H.isSquare())
+			throw std::invalid_argument("Not square matrix in lahqr");
+		m_info = 0;
+		if (n == 0)
+			return;
+		T zero = NUMCPP::CONSTANTS<T>::zero, one = NUMCPP::CONSTANTS<T>::one;
+		if (ilo == ihi) {
+			wr(ilo) = H(ilo, ilo);
+			wi(ilo) = zero;
+			return;
+		}
+		// clears out the trash
+		for (int j = ilo; j < ihi - 2; ++j) {
+			H(j + 2, j) = zero;
+			H(j + 3, j) = zero;
+		}
+		if (ilo <= ihi - 2)
+			H(ihi, ihi - 2) = zero;
+
+		int nh = ihi - ilo + 1;
+		T ulp = std::numeric_limits<T>::epsilon();
+		T smlnum = NUMCPP::CONSTANTS<T>::safe_min * ((T)nh / ulp);
+		// exceptional shifts
+		const T dat1 = (T)0.75, dat2 = (T)-0.4375;
+		const int kexsh = 10;
+		// I1 and I2 are the indices of the first row and last column of H to which transformations must be applied
+		int i1 = 0, i2 = n - 1;
+		int itmax = 30 * std::max(10, nh);
+		int kdefl = 0;
+		LARFG<T> larfg;
+		LANV2<T> lanv2;
+		ROT<T> rot;
+		T v[3];
+		int ldh = H.getColumnIncrement();
+
+		// the active block is H(l:i, l:i); i decreases when eigenvalues converge
+		int i = ihi;
+		while (i >= ilo) {
+			int l = ilo;
+			bool converged = false;
+			for (int its = 0; its <= itmax; ++its) {
+				// looks for a single small subdiagonal element
+				int k;
+				for (k = i; k > l; --k) {
+					T hk = std::abs(H(k, k - 1));
+					if (hk <= smlnum)
+						break;
+					T tst = std::abs(H(k - 1, k - 1)) + std::abs(H(k, k));
+					if (tst == zero) {
+						if (k - 2 >= ilo)
+							tst += std::abs(H(k - 1, k - 2));
+						if (k + 1 <= ihi)
+							tst += std::abs(H(k + 1, k));
+					}
+					// conservative small subdiagonal deflation criterion (Ahues & Tisseur)
+					if (hk <= ulp * tst) {
+						T ab = std::max(hk, std::abs(H(k - 1, k)));
+						T ba = std::min(hk, std::abs(H(k - 1, k)));
+						T aa = std::max(std::abs(H(k, k)), std::abs(H(k - 1, k - 1) - H(k, k)));
+						T bb = std::min(std::abs(H(k, k)), std::abs(H(k - 1, k - 1) - H(k, k)));
+						T s = aa + ab;
+						if (ba * (ab / s) <= std::max(smlnum, ulp * (bb * (aa / s))))
+							break;
+					}
+				}
+				l = k;
+				if (l > ilo)
+					H(l, l - 1) = zero;
+				// exit when a 1 x 1 or 2 x 2 block has split off
+				if (l >= i - 1) {
+					converged = true;
+					break;
+				}
+				++kdefl;
+				// the active rows/columns when only the eigenvalues are wanted
+				if (!wantt) {
+					i1 = l;
+					i2 = i;
+				}
+
+				T h11, h12, h21, h22;
+				if (kdefl % (2 * kexsh) == 0) {
+					// exceptional shift
+					T s = std::abs(H(i, i - 1)) + std::abs(H(i - 1, i - 2));
+					h11 = dat1 * s + H(i, i);
+					h12 = dat2 * s;
+					h21 = s;
+					h22 = h11;
+				}
+				else if (kdefl % kexsh == 0) {
+					// exceptional shift
+					T s = std::abs(H(l + 1, l)) + std::abs(H(l + 2, l + 1));
+					h11 = dat1 * s + H(l, l);
+					h12 = dat2 * s;
+					h21 = s;
+					h22 = h11;
+				}
+				else {
+					// Francis double shift: eigenvalues of the trailing 2 x 2 block
+					h11 = H(i - 1, i - 1);
+					h21 = H(i, i - 1);
+					h12 = H(i - 1, i);
+					h22 = H(i, i);
+				}
+				T rt1r, rt1i, rt2r, rt2i;
+				T s = std::abs(h11) + std::abs(h12) + std::abs(h21) + std::abs(h22);
+				if (s == zero) {
+					rt1r = rt1i = rt2r = rt2i = zero;
+				}
+				else {
+					h11 /= s;
+					h21 /= s;
+					h12 /= s;
+					h22 /= s;
+					T tr = (h11 + h22) / 2;
+					T det = (h11 - tr) * (h22 - tr) - h12 * h21;
+					T rtdisc = std::sqrt(std::abs(det));
+					if (det >= zero) {
+						// complex conjugate shifts
+						rt1r = tr * s;
+						rt2r = rt1r;
+						rt1i = rtdisc * s;
+						rt2i = -rt1i;
+					}
+					else {
+						// real shifts (uses only one of them, the closest to h22)
+						rt1r = tr + rtdisc;
+						rt2r = tr - rtdisc;
+						if (std::abs(rt1r - h22) <= std::abs(rt2r - h22))
+							rt1r *= s;
+						else
+							rt1r = rt2r * s;
+						rt2r = rt1r;
+						rt1i = rt2i = zero;
+					}
+				}
+
+				// looks for two consecutive small subdiagonal elements
+				int m;
+				for (m = i - 2; m >= l; --m) {
+					// first column of (H - rt1 I) * (H - rt2 I), scaled to avoid overflow
+					T h21s = H(m + 1, m);
+					s = std::abs(H(m, m) - rt2r) + std::abs(rt2i) + std::abs(h21s);
+					h21s = H(m + 1, m) / s;
+					v[0] = h21s * H(m, m + 1) + (H(m, m) - rt1r) * ((H(m, m) - rt2r) / s) - rt1i * (rt2i / s);
+					v[1] = h21s * (H(m, m) + H(m + 1, m + 1) - rt1r - rt2r);
+					v[2] = h21s * H(m + 2, m + 1);
+					s = std::abs(v[0]) + std::abs(v[1]) + std::abs(v[2]);
+					v[0] /= s;
+					v[1] /= s;
+					v[2] /= s;
+					if (m == l)
+						break;
+					T h00 = std::abs(H(m, m - 1)) * (std::abs(v[1]) + std::abs(v[2]));
+					T h01 = std::abs(v[0]) * (std::abs(H(m - 1, m - 1)) + std::abs(H(m, m)) + std::abs(H(m + 1, m + 1)));
+					if (h00 <= ulp * h01)
+						break;
+				}
+
+				// double-shift QR step: chases the bulge from row m to the bottom of the active block
+				for (k = m; k < i; ++k) {
+					// the first iteration introduces the bulge, the next ones restore the Hessenberg form
+					// in the column k-1
+					int nr = std::min(3, i - k + 1);
+					if (k > m) {
+						for (int j = 0; j < nr; ++j)
+							v[j] = H(k + j, k - 1);
+					}
+					T t1 = larfg(nr, v[0], v + 1, 1);
+					if (k > m) {
+						H(k, k - 1) = v[0];
+						H(k + 1, k - 1) = zero;
+						if (k < i - 1)
+							H(k + 2, k - 1) = zero;
+					}
+					else if (m > l) {
+						// uses the following instead of H(k, k-1) = -H(k, k-1) to avoid a bug when v(1) and v(2) underflow
+						H(k, k - 1) *= one - t1;
+					}
+					T v2 = v[1], t2 = t1 * v2;
+					if (nr == 3) {
+						T v3 = v[2], t3 = t1 * v3;
+						// applies G from the left to the rows k:k+2 of H
+						for (int j = k; j <= i2; ++j) {
+							T* hj = &H(k, j);
+							T sum = hj[0] + v2 * hj[1] + v3 * hj[2];
+							hj[0] -= sum * t1;
+							hj[1] -= sum * t2;
+							hj[2] -= sum * t3;
+						}
+						// applies G from the right to the columns k:k+2 of H and Z
+						T* hk0 = &H(0, k), * hk1 = hk0 + ldh, * hk2 = hk1 + ldh;
+						for (int j = i1; j <= std::min(k + 3, i); ++j) {
+							T sum = hk0[j] + v2 * hk1[j] + v3 * hk2[j];
+							hk0[j] -= sum * t1;
+							hk1[j] -= sum * t2;
+							hk2[j] -= sum * t3;
+						}
+						if (wantz) {
+							T* zk0 = &Z(0, k), * zk1 = &Z(0, k + 1), * zk2 = &Z(0, k + 2);
+							for (int j = iloz; j <= ihiz; ++j) {
+								T sum = zk0[j] + v2 * zk1[j] + v3 * zk2[j];
+								zk0[j] -= sum * t1;
+								zk1[j] -= sum * t2;
+								zk2[j] -= sum * t3;
+							}
+						}
+					}
+					else if (nr == 2) {
+						for (int j = k; j <= i2; ++j) {
+							T* hj = &H(k, j);
+							T sum = hj[0] + v2 * hj[1];
+							hj[0] -= sum * t1;
+							hj[1] -= sum * t2;
+						}
+						T* hk0 = &H(0, k), * hk1 = hk0 + ldh;
+						for (int j = i1; j <= i; ++j) {
+							T sum = hk0[j] + v2 * hk1[j];
+							hk0[j] -= sum * t1;
+							hk1[j] -= sum * t2;
+						}
+						if (wantz) {
+							T* zk0 = &Z(0, k), * zk1 = &Z(0, k + 1);
+							for (int j = iloz; j <= ihiz; ++j) {
+								T sum = zk0[j] + v2 * zk1[j];
+								zk0[j] -= sum * t1;
+								zk1[j] -= sum * t2;
+							}
+						}
+					}
+				}
+			}
+			if (!converged) {
+				// failure to converge in the remaining active block
+				m_info = i + 1;
+				return;
+			}
+			if (l == i) {
+				// 1 x 1 block: real eigenvalue
+				wr(i) = H(i, i);
+				wi(i) = zero;
+			}
+			else {
+				// 2 x 2 block: standard form and eigenvalues
+				T cs, sn;
+				lanv2(H(i - 1, i - 1), H(i - 1, i), H(i, i - 1), H(i, i), wr(i - 1), wi(i - 1), wr(i), wi(i), cs, sn);
+				if (wantt) {
+					// applies the transformation to the rest of H
+					if (i2 > i)
+						rot(i2 - i, &H(i - 1, i + 1), ldh, &H(i, i + 1), ldh, cs, sn);
+					rot(i - i1 - 1, &H(i1, i - 1), 1, &H(i1, i), 1, cs, sn);
+				}
+				if (wantz)
+					rot(ihiz - iloz + 1, &Z(iloz, i - 1), 1, &Z(iloz, i), 1, cs, sn);
+			}
+			// resets the deflation counter and continues with the remaining active block
+			kdefl = 0;
+			i = l - 1;
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,98 @@
+#ifndef __lcpp_lahr2_h
+#define __lcpp_lahr2_h
+
+#include "matrix.h"
+#include "matrix_0.h"
+#include "larfg.h"
+#include "gemm.h"
+#include "trmm.h"
+
+namespace LCPP {
+	/// <summary>
+	/// Reduces the nb columns c0:c0+nb-1 of a real general n x n matrix A so that the elements below the first
+	/// subdiagonal are zero (panel of the blocked Hessenberg reduction, see GEHRD). Only the rows 0:ihi are referenced.
+	/// The reduction is performed by an orthogonal similarity transformation Q' * A * Q; the routine returns the
+	/// matrices V and Tf which determine Q as a block reflector I - V * Tf * V', and also the matrix Y = A * V * Tf.
+	/// V is stored below the first subdiagonal of the panel (unit elements not stored, as for GEHD2),
+	/// Tf is nb x nb upper triangular and Y is (ihi+1) x nb. The trailing part of A is not modified:
+	/// A is only updated in the panel columns.
+	/// </summary>
+	/// <typeparam name="T"></typeparam>
+	template<typename T>
+	class LAHR2 {
+	public:
+
+		LAHR2() {}
+
+		void operator()(int c0, int nb, int ihi, NUMCPP::FastMatrix<T> A, NUMCPP::Sequence<T> tau, NUMCPP::FastMatrix<T> Tf, NUMCPP::FastMatrix<T> Y);
+	};
+
+	template<typename T>
+	void LAHR2<T>::operator()(int c0, int nb, int ihi, NUMCPP::FastMatrix<T> A, NUMCPP::Sequence<T> tau, NUMCPP::FastMatrix<T> Tf, NUMCPP::FastMatrix<T> Y) {
+		// the unit element of the first reflector is in row kk
+		int kk = c0 + 1, nr = ihi + 1 - kk;
+		if (nr <= 1 || nb == 0)
+			return;
+		T zero = NUMCPP::CONSTANTS<T>::zero, one = NUMCPP::CONSTANTS<T>::one;
+		int lda = A.getColumnIncrement(), ldt = Tf.getColumnIncrement(), ldy = Y.getColumnIncrement();
+		T* a = A.ptr();
+		T* t = Tf.ptr();
+		T* y = Y.ptr();
+		auto pa = [=](int r, int c) {return a + r + c * lda; };
+		GEMM<T> gemm;
+		TRMM<T> trmm;
+		LARFG<T> larfg;
+		T ei = zero;
+		for (int j = 0; j < nb; ++j) {
+			int cj = c0 + j;
+			if (j > 0) {
+				// updates A(kk:ihi, cj): b = b - Y * V(kk+j-1, :)'
+				gemm(false, true, nr, 1, j, -one, y + kk, ldy, pa(kk + j - 1, c0), lda, one, pa(kk, cj), lda);
+				// applies I - V * Tf' * V' to b from the left, using the last column of Tf as workspace
+				// w = V1' * b1 + V2' * b2
+				NUMCPP::FastMatrix<T> w = Tf.extract(0, j, nb - 1, 1);
+				NUMCPP::FastMatrix<T> V1 = A.extract(kk, j, c0, j);
+				w.column(0).copy(A.column(cj).extract(kk, j));
+				trmm(Side::Left, Triangular::Lower, true, true, one, V1, w);
+				gemm(true, false, j, 1, nr - j, one, pa(kk + j, c0), lda, pa(kk + j, cj), lda, one, w.ptr(), ldt);
+				// w = Tf' * w
+				trmm(Side::Left, Triangular::Upper, true, false, one, Tf.extract(0, j, 0, j), w);
+				// b2 = b2 - V2 * w, b1 = b1 - V1 * w
+				gemm(false, false, nr - j, 1, j, -one, pa(kk + j, c0), lda, w.ptr(), ldt, one, pa(kk + j, cj), lda);
+				trmm(Side::Left, Triangular::Lower, false, true, one, V1, w);
+				A.column(cj).extract(kk, j).addAY(-one, w.column(0));
+				*pa(kk + j - 1, cj - 1) = ei;
+			}
+			// H(j) annihilates A(kk+j+1:ihi, cj)
+			T tj = larfg(nr - j, *pa(kk + j, cj), pa(std::min(kk + j + 1, ihi), cj), 1);
+			tau(j) = tj;
+			ei = *pa(kk + j, cj);
+			*pa(kk + j, cj) = one;
+			// Y(kk:ihi, j) = tau * (A(kk:ihi, cj+1:ihi) * v - Y(kk:ihi, 0:j-1) * Tf(0:j-1, j)), with Tf(0:j-1, j) = V2' * v
+			T* yj = y + j * ldy;
+			T* tj_col = t + j * ldt;
+			gemm(false, false, nr, 1, nr - j, one, pa(kk, cj + 1), lda, pa(kk + j, cj), lda, zero, yj + kk, ldy);
+			if (j > 0) {
+				gemm(true, false, j, 1, nr - j, one, pa(kk + j, c0), lda, pa(kk + j, cj), lda, zero, tj_col, ldt);
+				gemm(false, false, nr, 1, j, -one, y + kk, ldy, tj_col, ldt, one, yj + kk, ldy);
+			}
+			for (int i = kk; i <= ihi; ++i)
+				yj[i] *= tj;
+			// Tf(0:j-1, j) = -tau * Tf(0:j-1, 0:j-1) * Tf(0:j-1, j)
+			if (j > 0)
+				trmm(Side::Left, Triangular::Upper, false, false, -tj, Tf.extract(0, j, 0, j), Tf.extract(0, j, j, 1));
+			tj_col[j] = tj;
+		}
+		*pa(kk + nb - 1, c0 + nb - 1) = ei;
+		// Y(0:kk-1, :) = A(0:kk-1, c0+1:ihi) * V * Tf
+		NUMCPP::FastMatrix<T> Yt = Y.extract(0, kk, 0, nb);
+		for (int j = 0; j < nb; ++j)
+			Yt.column(j).copy(A.column(c0 + 1 + j).left(kk));
+		trmm(Side::Right, Triangular::Lower, false, true, one, A.extract(kk, nb, c0, nb), Yt);
+		if (nr > nb)
+			gemm(false, false, kk, nb, nr - nb, one, pa(0, c0 + nb + 1), lda, pa(kk + nb, c0), lda, one, y, ldy);
+		trmm(Side::Right, Triangular::Upper, false, false, one, Tf, Yt);
+	}
+}
+
+#endif
@@ -0,0 +1,145 @@
+#ifndef __lcpp_lanv2_h
+#define __lcpp_lanv2_h
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "constants.h"
+
+namespace LCPP {
+	/// <summary>
+	/// Computes the Schur factorization of a real 2 x 2 nonsymmetric matrix in standardized form:
+	///     [ a  b ]   [ cs -sn ] [ aa  bb ] [ cs  sn ]
+	///     [ c  d ] = [ sn  cs ] [ cc  dd ] [-sn  cs ]
+	/// where either cc = 0, so that aa and dd are real eigenvalues, or aa = dd and bb * cc < 0, so that
+	/// aa +/- sqrt(bb * cc) are complex conjugate eigenvalues.
+	/// On exit, (a, b, c, d) contain (aa, bb, cc, dd) and (rt1r, rt1i), (rt2r, rt2i) the eigenvalues.
+	/// </summary>
+	/// <typeparam name="T"></typeparam>
+	template<typename T>
+	class LANV2 {
+	public:
+
+		LANV2() {}
+
+		void operator()(T& a, T& b, T& c, T& d, T& rt1r, T& rt1i, T& rt2r, T& rt2i, T& cs, T& sn) const;
+	};
+
+	template<typename T>
+	void LANV2<T>::operator()(T& a, T& b, T& c, T& d, T& rt1r, T& rt1i, T& rt2r, T& rt2i, T& cs, T& sn) const {
+		T zero = NUMCPP::CONSTANTS<T>::zero, one = NUMCPP::CONSTANTS<T>::one, half = NUMCPP::CONSTANTS<T>::half;
+		T multpl = 4;
+		T eps = std::numeric_limits<T>::epsilon();
+		T safmn2 = std::pow(NUMCPP::CONSTANTS<T>::radix, (int)(std::log(NUMCPP::CONSTANTS<T>::safe_min / eps) / std::log(NUMCPP::CONSTANTS<T>::radix) / 2));
+		T safmx2 = one / safmn2;
+		auto sign = [=](T x, T y) {return y >= zero ? std::abs(x) : -std::abs(x); };
+		if (c == zero) {
+			cs = one;
+			sn = zero;
+		}
+		else if (b == zero) {
+			// swaps rows and columns
+			cs = zero;
+			sn = one;
+			std::swap(a, d);
+			b = -c;
+			c = zero;
+		}
+		else if (a - d == zero && sign(one, b) != sign(one, c)) {
+			cs = one;
+			sn = zero;
+		}
+		else {
+			T temp = a - d;
+			T p = half * temp;
+			T bcmax = std::max(std::abs(b), std::abs(c));
+			T bcmis = std::min(std::abs(b), std::abs(c)) * sign(one, b) * sign(one, c);
+			T scale = std::max(std::abs(p), bcmax);
+			T z = (p / scale) * p + (bcmax / scale) * bcmis;
+			if (z >= multpl * eps) {
+				// real eigenvalues
+				z = p + sign(std::sqrt(scale) * std::sqrt(z), p);
+				a = d + z;
+				d = d - (bcmax / z) * bcmis;
+				T tau = std::hypot(c, z);
+				cs = z / tau;
+				sn = c / tau;
+				b = b - c;
+				c = zero;
+			}
+			else {
+				// complex eigenvalues, or real (almost) equal eigenvalues: makes the diagonal elements equal
+				T sigma = b + c;
+				for (int count = 0; count < 20; ++count) {
+					scale = std::max(std::abs(temp), std::abs(sigma));
+					if (scale >= safmx2) {
+						sigma *= safmn2;
+						temp *= safmn2;
+					}
+					else if (scale <= safmn2) {
+						sigma *= safmx2;
+						temp *= safmx2;
+					}
+					else
+						break;
+				}
+				p = half * temp;
+				T tau = std::hypot(sigma, temp);
+				cs = std::sqrt(half * (one + std::abs(sigma) / tau));
+				sn = -(p / (tau * cs)) * sign(one, sigma);
+				// [aa bb; cc dd] = [a b; c d] * [cs -sn; sn cs]
+				T aa = a * cs + b * sn;
+				T bb = -a * sn + b * cs;
+				T cc = c * cs + d * sn;
+				T dd = -c * sn + d * cs;
+				// [a b; c d] = [cs sn; -sn cs] * [aa bb; cc dd]
+				a = aa * cs + cc * sn;
+				b = bb * cs + dd * sn;
+				c = -aa * sn + cc * cs;
+				d = -bb * sn + dd * cs;
+				temp = half * (a + d);
+				a = temp;
+				d = temp;
+				if (c != zero) {
+					if (b != zero) {
+						if (sign(one, b) == sign(one, c)) {
+							// real eigenvalues: reduces to upper triangular form
+							T sab = std::sqrt(std::abs(b));
+							T sac = std::sqrt(std::abs(c));
+							p = sign(sab * sac, c);
+							tau = one / std::sqrt(std::abs(b + c));
+							a = temp + p;
+							d = temp - p;
+							b = b - c;
+							c = zero;
+							T cs1 = sab * tau;
+							T sn1 = sac * tau;
+							temp = cs * cs1 - sn * sn1;
+							sn = cs * sn1 + sn * cs1;
+							cs = temp;
+						}
+					}
+					else {
+						b = -c;
+						c = zero;
+						temp = cs;
+						cs = -sn;
+						sn = temp;
+					}
+				}
+			}
+		}
+		rt1r = a;
+		rt2r = d;
+		if (c == zero) {
+			rt1i = zero;
+			rt2i = zero;
+		}
+		else {
+			rt1i = std::sqrt(std::abs(b)) * std::sqrt(std::abs(c));
+			rt2i = -rt1i;
+		}
+	}
+}
+
+#endif
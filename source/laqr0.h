@@ -0,0 +1,226 @@
+#ifndef __lcpp_laqr0_h
+#define __lcpp_laqr0_h
+
+#include <algorithm>
+#include <cmath>
+#include "matrix.h"
+#include "matrix_0.h"
+#include "laenv.h"
+#include "lanv2.h"
+#include "lahqr.h"
+#include "laqr2.h"
+#include "laqr5.h"
+
+namespace LCPP {
+	/// <summary>
+	/// Computes the eigenvalues and optionally the Schur factorization of an upper Hessenberg matrix H by the
+	/// multishift QR algorithm with aggressive early deflation (Braman, Byers and Mathias):
+	/// at each iteration, the deflation window at the bottom of the active block is examined for converged
+	/// eigenvalues (LAQR2); its undeflated eigenvalues are then used as shifts for a small-bulge multishift
+	/// QR sweep (LAQR5), unless enough eigenvalues have just been deflated.
+	/// The arguments and the output are the same as for LAHQR (all the indices are 0-based).
+	/// The number of shifts and the size of the deflation window are given by LAENV (QRShifts, QRWindow).
+	/// </summary>
+	/// <typeparam name="T"></typeparam>
+	template<typename T>
+	class LAQR0 {
+	public:
+
+		LAQR0() :m_info(0) {}
+
+		void operator()(bool wantt, bool wantz, int ilo, int ihi, NUMCPP::FastMatrix<T> H, NUMCPP::Sequence<T> wr, NUMCPP::Sequence<T> wi,
+			int iloz, int ihiz, NUMCPP::FastMatrix<T> Z);
+
+		int info() const {
+			return m_info;
+		}
+
+	private:
+
+		int m_info;
+		LAQR2<T> m_aed;
+		LAQR5<T> m_sweep;
+		NUMCPP::Matrix<T> m_w;
+	};
+
+	template<typename T>
+	void LAQR0<T>::operator()(bool wantt, bool wantz, int ilo, int ihi, NUMCPP::FastMatrix<T> H, NUMCPP::Sequence<T> wr, NUMCPP::Sequence<T> wi,
+		int iloz, int ihiz, NUMCPP::FastMatrix<T> Z) {
+		// matrices of order ntiny or smaller are processed by LAHQR
+		const int ntiny = 15;
+		// exceptional deflation windows: after kexnw iterations without deflation
+		const int kexnw = 5;
+		// exceptional shifts: after kexsh iterations without deflation
+		const int kexsh = 6;
+		const T wilk1 = (T)0.75, wilk2 = (T)-0.4375;
+		int n = H.getNrows();
+		m_info = 0;
+		if (n == 0)
+			return;
+		if (n <= ntiny) {
+			LAHQR<T> lahqr;
+			lahqr(wantt, wantz, ilo, ihi, H, wr, wi, iloz, ihiz, Z);
+			m_info = lahqr.info();
+			return;
+		}
+		T zero = NUMCPP::CONSTANTS<T>::zero;
+		LAENV laenv;
+		int nmin = std::max(ntiny, laenv(LAENV::QRMinimum, "HSEQR", "", n, ilo, ihi, -1));
+		int nibble = laenv(LAENV::QRNibble, "HSEQR", "", n, ilo, ihi, -1);
+		// recommended deflation window size
+		int nwr = laenv(LAENV::QRWindow, "HSEQR", "", n, ilo, ihi, -1);
+		nwr = std::min(std::min(ihi - ilo + 1, (n - 1) / 3), std::max(2, nwr));
+		// recommended number of simultaneous shifts
+		int nsr = laenv(LAENV::QRShifts, "HSEQR", "", n, ilo, ihi, -1);
+		nsr = std::min(std::min(nsr, (n - 3) / 6), ihi - ilo);
+		nsr = std::max(2, nsr - nsr % 2);
+		int nwmax = (n - 1) / 3;
+		int nw = nwmax;
+		int nsmax = (n - 3) / 6;
+		nsmax -= nsmax % 2;
+		// number of iterations since a deflation
+		int ndfl = 1;
+		int ndec = -1;
+		int itmax = std::max(30, 2 * kexsh) * std::max(10, ihi - ilo + 1);
+		int kbot = ihi;
+		LANV2<T> lanv2;
+		LAHQR<T> lahqr;
+
+		for (int it = 0; it < itmax; ++it) {
+			// done when kbot falls below ilo
+			if (kbot < ilo)
+				return;
+			// locates the active block
+			int ktop = kbot;
+			while (ktop > ilo && H(ktop, ktop - 1) != zero)
+				--ktop;
+
+			// selects the deflation window size. Typical case: if possible and advisable, nibbles the entire
+			// active block; if not, uses nwr or nwr+1, depending on which has the smaller subdiagonal entry.
+			// Exceptional case: if there have been no deflations in kexnw or more iterations, the window size is
+			// first rapidly increased (larger windows are, in general, more powerful), and then gradually reduced
+			int nh = kbot - ktop + 1;
+			int nwupbd = std::min(nh, nwmax);
+			if (ndfl < kexnw)
+				nw = std::min(nwupbd, nwr);
+			else
+				nw = std::min(nwupbd, 2 * nw);
+			if (nw < nwmax) {
+				if (nw >= nh - 1)
+					nw = nh;
+				else {
+					int kwtop = kbot - nw + 1;
+					if (std::abs(H(kwtop, kwtop - 1)) > std::abs(H(kwtop - 1, kwtop - 2)))
+						++nw;
+				}
+			}
+			if (ndfl < kexnw)
+				ndec = -1;
+			else if (ndec >= 0 || nw >= nwupbd) {
+				++ndec;
+				if (nw - ndec < 2)
+					ndec = 0;
+				nw -= ndec;
+			}
+
+			// aggressive early deflation
+			m_aed(wantt, wantz, ktop, kbot, nw, H, iloz, ihiz, Z, wr, wi);
+			int ls = m_aed.ns(), ld = m_aed.nd();
+			kbot -= ld;
+			// ks points to the shifts
+			int ks = kbot - ls + 1;
+
+			// skips the QR sweep if many eigenvalues have just been deflated, or if the remaining active block is small
+			if (ld == 0 || (100 * ld <= nw * nibble && kbot - ktop + 1 > std::min(nmin, nwmax))) {
+				int ns = std::min(std::min(nsmax, nsr), std::max(2, kbot - ktop));
+				ns -= ns % 2;
+				if (ndfl % kexsh == 0) {
+					// exceptional shifts
+					ks = kbot - ns + 1;
+					for (int i = kbot; i >= std::max(ks + 1, ktop + 2); i -= 2) {
+						T ss = std::abs(H(i, i - 1)) + std::abs(H(i - 1, i - 2));
+						T aa = wilk1 * ss + H(i, i), bb = ss, cc = wilk2 * ss, dd = aa, cs, sn;
+						lanv2(aa, bb, cc, dd, wr(i - 1), wi(i - 1), wr(i), wi(i), cs, sn);
+					}
+					if (ks == ktop) {
+						wr(ks + 1) = H(ks + 1, ks + 1);
+						wi(ks + 1) = zero;
+						wr(ks) = wr(ks + 1);
+						wi(ks) = wi(ks + 1);
+					}
+				}
+				else {
+					// got ns/2 or fewer shifts? uses the eigenvalues of the trailing principal submatrix
+					if (kbot - ks + 1 <= ns / 2) {
+						ks = kbot - ns + 1;
+						if (m_w.getNrows() < ns)
+							m_w = NUMCPP::Matrix<T>(ns, ns);
+						NUMCPP::FastMatrix<T> W = m_w.extract(0, ns, 0, ns);
+						for (int c = 0; c < ns; ++c)
+							W.column(c).copy(H.column(ks + c).extract(ks, ns));
+						lahqr(false, false, 0, ns - 1, W, wr.drop(ks, 0), wi.drop(ks, 0), 0, -1, W);
+						ks += lahqr.info();
+						// in case of a rare QR failure, uses the eigenvalues of the trailing 2 x 2 principal submatrix
+						if (ks >= kbot) {
+							T aa = H(kbot - 1, kbot - 1), cc = H(kbot, kbot - 1), bb = H(kbot - 1, kbot), dd = H(kbot, kbot), cs, sn;
+							lanv2(aa, bb, cc, dd, wr(kbot - 1), wi(kbot - 1), wr(kbot), wi(kbot), cs, sn);
+							ks = kbot - 1;
+						}
+					}
+					if (kbot - ks + 1 > ns) {
+						// sorts the shifts by decreasing magnitude (helps a little); the smallest ones are used.
+						// Bubble sort keeps complex conjugate pairs together
+						bool sorted = false;
+						for (int k = kbot; k > ks && !sorted; --k) {
+							sorted = true;
+							for (int i = ks; i < k; ++i) {
+								if (std::abs(wr(i)) + std::abs(wi(i)) < std::abs(wr(i + 1)) + std::abs(wi(i + 1))) {
+									sorted = false;
+									std::swap(wr(i), wr(i + 1));
+									std::swap(wi(i), wi(i + 1));
+								}
+							}
+						}
+					}
+					// shuffles the shifts into pairs of real shifts and pairs of complex conjugate shifts
+					// (complex conjugate shifts are already adjacent)
+					for (int i = kbot; i >= ks + 2; i -= 2) {
+						if (wi(i) != -wi(i - 1)) {
+							T swap = wr(i);
+							wr(i) = wr(i - 1);
+							wr(i - 1) = wr(i - 2);
+							wr(i - 2) = swap;
+							swap = wi(i);
+							wi(i) = wi(i - 1);
+							wi(i - 1) = wi(i - 2);
+							wi(i - 2) = swap;
+						}
+					}
+				}
+				// if there are only two shifts and both are real, uses only one of them
+				if (kbot - ks + 1 == 2 && wi(kbot) == zero) {
+					if (std::abs(wr(kbot) - H(kbot, kbot)) < std::abs(wr(kbot - 1) - H(kbot, kbot)))
+						wr(kbot - 1) = wr(kbot);
+					else
+						wr(kbot) = wr(kbot - 1);
+				}
+				// uses up to ns of the smallest magnitude shifts
+				ns = std::min(ns, kbot - ks + 1);
+				ns -= ns % 2;
+				ks = kbot - ns + 1;
+				// small-bulge multishift QR sweep
+				m_sweep(wantt, wantz, ktop, kbot, ns, wr.drop(ks, 0), wi.drop(ks, 0), H, iloz, ihiz, Z);
+			}
+			// notes the progress (or the lack of it)
+			if (ld > 0)
+				ndfl = 1;
+			else
+				++ndfl;
+		}
+		if (kbot >= ilo)
+			// iteration limit exceeded
+			m_info = kbot + 1;
+	}
+}
+
+#endif
@@ -0,0 +1,57 @@
+#ifndef __lcpp_laqr1_h
+#define __lcpp_laqr1_h
+
+#include <cmath>
+#include "matrix.h"
+
+namespace LCPP {
+	/// <summary>
+	/// Given a 2 x 2 or 3 x 3 upper Hessenberg matrix H (n = 2 or 3), computes a scalar multiple of the first column of
+	///     K = (H - (sr1 + i * si1) * I) * (H - (sr2 + i * si2) * I)
+	/// (the shifts are either both real, or complex conjugate). The scaling avoids overflows and most underflows.
+	/// This is the first column of the bulges introduced by the multishift QR sweeps (LAQR5).
+	/// </summary>
+	/// <typeparam name="T"></typeparam>
+	template<typename T>
+	class LAQR1 {
+	public:
+
+		LAQR1() {}
+
+		void operator()(int n, const NUMCPP::FastMatrix<T>& H, T sr1, T si1, T sr2, T si2, T* v) const;
+	};
+
+	template<typename T>
+	void LAQR1<T>::operator()(int n, const NUMCPP::FastMatrix<T>& H, T sr1, T si1, T sr2, T si2, T* v) const {
+		T zero = NUMCPP::CONSTANTS<T>::zero;
+		if (n == 2) {
+			T s = std::abs(H(0, 0) - sr2) + std::abs(si2) + std::abs(H(1, 0));
+			if (s == zero) {
+				v[0] = zero;
+				v[1] = zero;
+			}
+			else {
+				T h21s = H(1, 0) / s;
+				v[0] = h21s * H(0, 1) + (H(0, 0) - sr1) * ((H(0, 0) - sr2) / s) - si1 * (si2 / s);
+				v[1] = h21s * (H(0, 0) + H(1, 1) - sr1 - sr2);
+			}
+		}
+		else {
+			T s = std::abs(H(0, 0) - sr2) + std::abs(si2) + std::abs(H(1, 0)) + std::abs(H(2, 0));
+			if (s == zero) {
+				v[0] = zero;
+				v[1] = zero;
+				v[2] = zero;
+			}
+			else {
+				T h21s = H(1, 0) / s;
+				T h31s = H(2, 0) / s;
+				v[0] = (H(0, 0) - sr1) * ((H(0, 0) - sr2) / s) - si1 * (si2 / s) + H(0, 1) * h21s + H(0, 2) * h31s;
+				v[1] = h21s * (H(0, 0) + H(1, 1) - sr1 - sr2) + H(1, 2) * h31s;
+				v[2] = h31s * (H(0, 0) + H(2, 2) - sr1 - sr2) + h21s * H(2, 1);
+			}
+		}
+	}
+}
+
+#endif
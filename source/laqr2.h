@@ -0,0 +1,270 @@
+#ifndef __lcpp_laqr2_h
+#define __lcpp_laqr2_h
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include "matrix.h"
+#include "matrix_0.h"
+#include "gemm.h"
+#include "larfg.h"
+#include "larf.h"
+#include "lanv2.h"
+#include "lahqr.h"
+#include "trexc.h"
+#include "gehrd.h"
+#include "ormqr.h"
+
+namespace LCPP {
+	/// <summary>
+	/// Aggressive early deflation (AED) for the multishift QR algorithm (see LAQR0).
+	/// The trailing nw x nw principal submatrix (the deflation window) of the active block H(ktop:kbot, ktop:kbot)
+	/// is reduced to Schur form T = V' * W * V (LAHQR). With s the subdiagonal element coupling the window
+	/// to the rest of the active block, the "spike" s * V(0, :) tells which eigenvalues of the window can be
+	/// deflated: a negligible spike component means a converged eigenvalue. The undeflatable eigenvalues are
+	/// moved to the top of the window (TREXC), the window is returned to Hessenberg form and the orthogonal
+	/// transformation is applied to the rest of H (and to Z) by GEMM.
+	/// On exit, nd() eigenvalues have been deflated (they are stored in sr/si(kbot-nd+1:kbot)), and the
+	/// ns() undeflated eigenvalues of the window, stored in sr/si(kbot-nd-ns+1:kbot-nd), can be used as shifts.
+	/// The indices are 0-based; see LAHQR for wantt, wantz, iloz and ihiz.
+	/// </summary>
+	/// <typeparam name="T"></typeparam>
+	template<typename T>
+	class LAQR2 {
+	public:
+
+		LAQR2() :m_ns(0), m_nd(0) {}
+
+		void operator()(bool wantt, bool wantz, int ktop, int kbot, int nw, NUMCPP::FastMatrix<T> H, int iloz, int ihiz, NUMCPP::FastMatrix<T> Z,
+			NUMCPP::Sequence<T> sr, NUMCPP::Sequence<T> si);
+
+		/// <summary>
+		/// Number of undeflated eigenvalues (shifts)
+		/// </summary>
+		int ns() const {
+			return m_ns;
+		}
+
+		/// <summary>
+		/// Number of deflated eigenvalues
+		/// </summary>
+		int nd() const {
+			return m_nd;
+		}
+
+	private:
+
+		static NUMCPP::FastMatrix<T> workspace(NUMCPP::Matrix<T>& W, int m, int n) {
+			if (W.getNrows() < m || W.getNcols() < n)
+				W = NUMCPP::Matrix<T>(std::max(m, W.getNrows()), std::max(n, W.getNcols()));
+			return W.extract(0, m, 0, n);
+		}
+
+		int m_ns, m_nd;
+		NUMCPP::Matrix<T> m_t, m_v, m_w;
+		std::vector<T> m_work;
+	};
+
+	template<typename T>
+	void LAQR2<T>::operator()(bool wantt, bool wantz, int ktop, int kbot, int nw, NUMCPP::FastMatrix<T> H, int iloz, int ihiz, NUMCPP::FastMatrix<T> Z,
+		NUMCPP::Sequence<T> sr, NUMCPP::Sequence<T> si) {
+		m_ns = 0;
+		m_nd = 0;
+		if (ktop > kbot || nw < 1)
+			return;
+		int n = H.getNrows();
+		T zero = NUMCPP::CONSTANTS<T>::zero, one = NUMCPP::CONSTANTS<T>::one;
+		T ulp = std::numeric_limits<T>::epsilon();
+		T smlnum = NUMCPP::CONSTANTS<T>::safe_min * ((T)n / ulp);
+
+		// deflation window
+		int jw = std::min(nw, kbot - ktop + 1);
+		int kwtop = kbot - jw + 1;
+		T s = kwtop == ktop ? zero : H(kwtop, kwtop - 1);
+		if (kbot == kwtop) {
+			// 1 x 1 deflation window: not much to do
+			sr(kwtop) = H(kwtop, kwtop);
+			si(kwtop) = zero;
+			m_ns = 1;
+			if (std::abs(s) <= std::max(smlnum, ulp * std::abs(H(kwtop, kwtop)))) {
+				m_ns = 0;
+				m_nd = 1;
+				if (kwtop > ktop)
+					H(kwtop, kwtop - 1) = zero;
+			}
+			return;
+		}
+
+		// converts the window to spike-triangular form. In case of a (rare) QR failure, AED continues
+		// with the part of the window which has converged (infqr)
+		NUMCPP::FastMatrix<T> Tw = workspace(m_t, jw, jw);
+		NUMCPP::FastMatrix<T> V = workspace(m_v, jw, jw);
+		for (int c = 0; c < jw; ++c) {
+			for (int r = 0; r < jw; ++r) {
+				Tw(r, c) = r <= c + 1 ? H(kwtop + r, kwtop + c) : zero;
+				V(r, c) = r == c ? one : zero;
+			}
+		}
+		LAHQR<T> lahqr;
+		lahqr(true, true, 0, jw - 1, Tw, sr.drop(kwtop, 0), si.drop(kwtop, 0), 0, jw - 1, V);
+		int infqr = lahqr.info();
+		// TREXC needs a clean margin near the diagonal
+		for (int j = 0; j < jw - 3; ++j) {
+			Tw(j + 2, j) = zero;
+			Tw(j + 3, j) = zero;
+		}
+		if (jw > 2)
+			Tw(jw - 1, jw - 3) = zero;
+
+		// deflation checks, from the bottom of the window
+		TREXC<T> trexc;
+		int ns = jw;
+		int ilst = infqr;
+		while (ilst < ns) {
+			bool bulge = ns > 1 && Tw(ns - 1, ns - 2) != zero;
+			if (!bulge) {
+				// real eigenvalue
+				T foo = std::abs(Tw(ns - 1, ns - 1));
+				if (foo == zero)
+					foo = std::abs(s);
+				if (std::abs(s * V(0, ns - 1)) <= std::max(smlnum, ulp * foo))
+					// deflatable
+					--ns;
+				else {
+					// undeflatable: moves it up out of the way (TREXC can not fail in this case)
+					int ifst = ns - 1;
+					trexc(true, Tw, V, ifst, ilst);
+					++ilst;
+				}
+			}
+			else {
+				// complex conjugate pair
+				T foo = std::abs(Tw(ns - 1, ns - 1)) + std::sqrt(std::abs(Tw(ns - 1, ns - 2))) * std::sqrt(std::abs(Tw(ns - 2, ns - 1)));
+				if (foo == zero)
+					foo = std::abs(s);
+				if (std::max(std::abs(s * V(0, ns - 1)), std::abs(s * V(0, ns - 2))) <= std::max(smlnum, ulp * foo))
+					// deflatable
+					ns -= 2;
+				else {
+					// undeflatable: moves them up out of the way. TREXC does the right thing with ilst
+					// in case of a rare exchange failure
+					int ifst = ns - 1;
+					trexc(true, Tw, V, ifst, ilst);
+					ilst += 2;
+				}
+			}
+		}
+		if (ns == 0)
+			s = zero;
+
+		if (ns < jw) {
+			// sorting the diagonal blocks of T improves the accuracy for graded matrices.
+			// Bubble sort deals well with exchange failures
+			bool sorted = false;
+			int i = ns;
+			while (!sorted) {
+				sorted = true;
+				int kend = i - 1;
+				i = infqr;
+				int k = (i == ns - 1 || Tw(i + 1, i) == zero) ? i + 1 : i + 2;
+				while (k <= kend) {
+					T evi = std::abs(Tw(i, i)), evk = std::abs(Tw(k, k));
+					if (k != i + 1)
+						evi += std::sqrt(std::abs(Tw(i + 1, i))) * std::sqrt(std::abs(Tw(i, i + 1)));
+					if (k != kend && Tw(k + 1, k) != zero)
+						evk += std::sqrt(std::abs(Tw(k + 1, k))) * std::sqrt(std::abs(Tw(k, k + 1)));
+					if (evi >= evk)
+						i = k;
+					else {
+						sorted = false;
+						int ifst = i, il = k;
+						trexc(true, Tw, V, ifst, il);
+						i = trexc.info() == 0 ? il : k;
+					}
+					k = (i == kend || Tw(i + 1, i) == zero) ? i + 1 : i + 2;
+				}
+			}
+		}
+
+		// restores the shift/eigenvalue array from T
+		LANV2<T> lanv2;
+		for (int i = jw - 1; i >= infqr;) {
+			if (i == infqr || Tw(i, i - 1) == zero) {
+				sr(kwtop + i) = Tw(i, i);
+				si(kwtop + i) = zero;
+				--i;
+			}
+			else {
+				T aa = Tw(i - 1, i - 1), cc = Tw(i, i - 1), bb = Tw(i - 1, i), dd = Tw(i, i), cs, sn;
+				lanv2(aa, bb, cc, dd, sr(kwtop + i - 1), si(kwtop + i - 1), sr(kwtop + i), si(kwtop + i), cs, sn);
+				i -= 2;
+			}
+		}
+
+		if (ns < jw || s == zero) {
+			if (ns > 1 && s != zero) {
+				// reflects the spike back into the lower triangle, and reduces T(0:ns-1, 0:ns-1) to Hessenberg form
+				if ((int)m_work.size() < 2 * jw)
+					m_work.resize(2 * jw);
+				NUMCPP::Sequence<T> w(m_work.data(), ns), tau(m_work.data() + jw, jw);
+				for (int j = 0; j < ns; ++j)
+					w(j) = V(0, j);
+				LARFG<T> larfg;
+				T beta = w(0);
+				T t = larfg(ns, beta, &w(1), 1);
+				w(0) = one;
+				for (int c = 0; c < jw - 2; ++c)
+					for (int r = c + 2; r < jw; ++r)
+						Tw(r, c) = zero;
+				LARF<T> larf;
+				larf(Side::Left, w, t, Tw.extract(0, ns, 0, jw));
+				larf(Side::Right, w, t, Tw.extract(0, ns, 0, ns));
+				larf(Side::Right, w, t, V.extract(0, jw, 0, ns));
+				GEHRD<T> gehrd;
+				gehrd(0, ns - 1, Tw, tau);
+				// V = V * Q
+				ORMQR<T> ormqr;
+				ormqr(Side::Right, false, Tw.extract(1, ns - 1, 0, ns - 1), tau, V.extract(0, jw, 1, ns - 1));
+			}
+			// copies the updated window into place
+			if (kwtop > 0)
+				H(kwtop, kwtop - 1) = s * V(0, 0);
+			for (int c = 0; c < jw; ++c)
+				for (int r = 0; r <= std::min(c + 1, jw - 1); ++r)
+					H(kwtop + r, kwtop + c) = Tw(r, c);
+
+			GEMM<T> gemm;
+			int ldh = H.getColumnIncrement();
+			T* h = H.ptr();
+			// vertical slab of H
+			int ltop = wantt ? 0 : ktop;
+			if (kwtop > ltop) {
+				NUMCPP::FastMatrix<T> W = workspace(m_w, kwtop - ltop, jw);
+				gemm(false, false, kwtop - ltop, jw, jw, one, h + ltop + kwtop * ldh, ldh, V.ptr(), V.getColumnIncrement(), zero, W.ptr(), W.getColumnIncrement());
+				for (int c = 0; c < jw; ++c)
+					H.column(kwtop + c).extract(ltop, kwtop - ltop).copy(W.column(c));
+			}
+			// horizontal slab of H
+			if (wantt && kbot < n - 1) {
+				NUMCPP::FastMatrix<T> W = workspace(m_w, jw, n - kbot - 1);
+				gemm(true, false, jw, n - kbot - 1, jw, one, V.ptr(), V.getColumnIncrement(), h + kwtop + (kbot + 1) * ldh, ldh, zero, W.ptr(), W.getColumnIncrement());
+				for (int c = 0; c < n - kbot - 1; ++c)
+					H.column(kbot + 1 + c).extract(kwtop, jw).copy(W.column(c));
+			}
+			// vertical slab of Z
+			if (wantz && ihiz >= iloz) {
+				NUMCPP::FastMatrix<T> W = workspace(m_w, ihiz - iloz + 1, jw);
+				gemm(false, false, ihiz - iloz + 1, jw, jw, one, &Z(iloz, kwtop), Z.getColumnIncrement(), V.ptr(), V.getColumnIncrement(), zero, W.ptr(), W.getColumnIncrement());
+				for (int c = 0; c < jw; ++c)
+					Z.column(kwtop + c).extract(iloz, ihiz - iloz + 1).copy(W.column(c));
+			}
+		}
+
+		m_nd = jw - ns;
+		// subtracting infqr from the spike length takes care of the case of a rare QR failure
+		m_ns = ns - infqr;
+	}
+}
+
+#endif
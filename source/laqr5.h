@@ -0,0 +1,325 @@
+#ifndef __lcpp_laqr5_h
+#define __lcpp_laqr5_h
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include "matrix.h"
+#include "matrix_0.h"
+#include "gemm.h"
+#include "larfg.h"
+#include "laqr1.h"
+
+namespace LCPP {
+	/// <summary>
+	/// Performs a single small-bulge multishift QR sweep on the active block H(ktop:kbot, ktop:kbot) of an upper
+	/// Hessenberg matrix (0-based, inclusive). The nshfts shifts (sr, si) are used in pairs (complex conjugate
+	/// pairs are assumed to be consecutive; if nshfts is odd, one real shift is dropped): each pair introduces
+	/// a 3 x 3 bulge, and the chain of nshfts / 2 tightly packed bulges is chased down the diagonal.
+	/// The bulges are moved by steps of about 3 * nshfts / 2 columns: inside a step, the reflectors are only applied
+	/// to a small diagonal window of H, and are accumulated in an orthogonal matrix U; the rest of H (and Z) is then
+	/// updated by matrix-matrix products (GEMM) with U.
+	/// See LAHQR for wantt, wantz, iloz and ihiz.
+	/// </summary>
+	/// <typeparam name="T"></typeparam>
+	template<typename T>
+	class LAQR5 {
+	public:
+
+		LAQR5() {}
+
+		void operator()(bool wantt, bool wantz, int ktop, int kbot, int nshfts, NUMCPP::Sequence<T> sr, NUMCPP::Sequence<T> si,
+			NUMCPP::FastMatrix<T> H, int iloz, int ihiz, NUMCPP::FastMatrix<T> Z);
+
+	private:
+
+		static NUMCPP::FastMatrix<T> workspace(NUMCPP::Matrix<T>& W, int m, int n) {
+			if (W.getNrows() < m || W.getNcols() < n)
+				W = NUMCPP::Matrix<T>(std::max(m, W.getNrows()), std::max(n, W.getNcols()));
+			return W.extract(0, m, 0, n);
+		}
+
+		NUMCPP::Matrix<T> m_u, m_w;
+		// reflectors (tau, v(1), v(2)) of the bulges
+		std::vector<T> m_v;
+	};
+
+	template<typename T>
+	void LAQR5<T>::operator()(bool wantt, bool wantz, int ktop, int kbot, int nshfts, NUMCPP::Sequence<T> sr, NUMCPP::Sequence<T> si,
+		NUMCPP::FastMatrix<T> H, int iloz, int ihiz, NUMCPP::FastMatrix<T> Z) {
+		if (nshfts < 2 || ktop >= kbot)
+			return;
+		int n = H.getNrows();
+		T zero = NUMCPP::CONSTANTS<T>::zero, one = NUMCPP::CONSTANTS<T>::one;
+		// shuffles the shifts into pairs of real shifts and pairs of complex conjugate shifts
+		// (complex conjugate shifts are assumed to be adjacent)
+		for (int i = 0; i < nshfts - 2; i += 2) {
+			if (si(i) != -si(i + 1)) {
+				T swap = sr(i);
+				sr(i) = sr(i + 1);
+				sr(i + 1) = sr(i + 2);
+				sr(i + 2) = swap;
+				swap = si(i);
+				si(i) = si(i + 1);
+				si(i + 1) = si(i + 2);
+				si(i + 2) = swap;
+			}
+		}
+		// nshfts is supposed to be even; if it is odd, the last (real) shift is dropped
+		int ns = nshfts - nshfts % 2;
+		T ulp = std::numeric_limits<T>::epsilon();
+		T smlnum = NUMCPP::CONSTANTS<T>::safe_min * ((T)n / ulp);
+		// clears the trash
+		if (ktop + 2 <= kbot)
+			H(ktop + 2, ktop) = zero;
+		// number of bulges, and order of the window of accumulated transformations
+		int nbmps = ns / 2;
+		int kdu = 6 * nbmps - 3;
+		if ((int)m_v.size() < 3 * nbmps)
+			m_v.resize(3 * nbmps);
+		NUMCPP::FastMatrix<T> U = workspace(m_u, kdu, kdu);
+		int ldu = U.getColumnIncrement(), ldh = H.getColumnIncrement();
+		T* h = H.ptr();
+		LARFG<T> larfg;
+		LAQR1<T> laqr1;
+		GEMM<T> gemm;
+
+		// the reflector of the bulge m at step k acts on the rows/columns k+1:k+3; the first bulge
+		// is introduced at k = ktop-1. The window of U starts at the row/column incol+1
+		for (int incol = 3 * (1 - nbmps) + ktop - 1; incol <= kbot - 2; incol += 3 * nbmps - 2) {
+			int ndcol = incol + kdu;
+			U.set(zero);
+			U.diagonal().set(one);
+			// chases the chain of bulges one column at a time
+			for (int krcol = incol; krcol <= std::min(incol + 3 * nbmps - 3, kbot - 2); ++krcol) {
+				// bulges mtop:mbot are active; if bmp22, the bulge m22 reaches the bottom and is reduced to 2 x 2
+				int mtop = std::max(0, ((ktop - 1) - krcol + 2) / 3);
+				int mbot = std::min(nbmps, (kbot - krcol) / 3) - 1;
+				int m22 = mbot + 1;
+				bool bmp22 = (mbot < nbmps - 1) && (krcol + 3 * m22 == kbot - 2);
+
+				// generates the reflectors that chase the chain right one column
+				for (int m = mtop; m <= mbot; ++m) {
+					int k = krcol + 3 * m;
+					T* v = &m_v[3 * m];
+					if (k == ktop - 1) {
+						laqr1(3, H.extract(ktop, 3, ktop, 3), sr(2 * m), si(2 * m), sr(2 * m + 1), si(2 * m + 1), v);
+						T alpha = v[0];
+						v[0] = larfg(3, alpha, v + 1, 1);
+					}
+					else {
+						T beta = H(k + 1, k);
+						v[1] = H(k + 2, k);
+						v[2] = H(k + 3, k);
+						v[0] = larfg(3, beta, v + 1, 1);
+						// a bulge may collapse because of vigilant deflation or destructive underflow; in the underflow
+						// case, tries to reintroduce it by ignoring H(k+1, k) and H(k+2, k)
+						if (H(k + 3, k) != zero || H(k + 3, k + 1) != zero || H(k + 3, k + 2) == zero) {
+							// typical case: not collapsed (yet)
+							H(k + 1, k) = beta;
+							H(k + 2, k) = zero;
+							H(k + 3, k) = zero;
+						}
+						else {
+							// atypical case: collapsed. If the fill resulting from the new reflector is too large,
+							// it is abandoned
+							T vt[3];
+							laqr1(3, H.extract(k + 1, 3, k + 1, 3), sr(2 * m), si(2 * m), sr(2 * m + 1), si(2 * m + 1), vt);
+							T alpha = vt[0];
+							vt[0] = larfg(3, alpha, vt + 1, 1);
+							T refsum = vt[0] * (H(k + 1, k) + vt[1] * H(k + 2, k));
+							if (std::abs(H(k + 2, k) - refsum * vt[1]) + std::abs(refsum * vt[2]) >
+								ulp * (std::abs(H(k, k)) + std::abs(H(k + 1, k + 1)) + std::abs(H(k + 2, k + 2)))) {
+								// a new bulge here would create non-negligible fill: uses the old one
+								H(k + 1, k) = beta;
+								H(k + 2, k) = zero;
+								H(k + 3, k) = zero;
+							}
+							else {
+								// a new bulge here would create only negligible fill: replaces the old reflector
+								H(k + 1, k) -= refsum;
+								H(k + 2, k) = zero;
+								H(k + 3, k) = zero;
+								v[0] = vt[0];
+								v[1] = vt[1];
+								v[2] = vt[2];
+							}
+						}
+					}
+				}
+				// generates a 2 x 2 reflector, if needed
+				int k22 = krcol + 3 * m22;
+				if (bmp22) {
+					T* v = &m_v[3 * m22];
+					if (k22 == ktop - 1) {
+						laqr1(2, H.extract(k22 + 1, 2, k22 + 1, 2), sr(2 * m22), si(2 * m22), sr(2 * m22 + 1), si(2 * m22 + 1), v);
+						T beta = v[0];
+						v[0] = larfg(2, beta, v + 1, 1);
+					}
+					else {
+						T beta = H(k22 + 1, k22);
+						v[1] = H(k22 + 2, k22);
+						v[0] = larfg(2, beta, v + 1, 1);
+						H(k22 + 1, k22) = beta;
+						H(k22 + 2, k22) = zero;
+					}
+				}
+
+				// multiplies H by the reflectors from the left (inside the window)
+				int jbot = std::min(ndcol, kbot);
+				for (int j = std::max(ktop, krcol); j <= jbot; ++j) {
+					int mend = std::min(mbot, (j - krcol + 2) / 3 - 1);
+					T* hj = h + j * ldh;
+					for (int m = mtop; m <= mend; ++m) {
+						int k = krcol + 3 * m;
+						const T* v = &m_v[3 * m];
+						T refsum = v[0] * (hj[k + 1] + v[1] * hj[k + 2] + v[2] * hj[k + 3]);
+						hj[k + 1] -= refsum;
+						hj[k + 2] -= refsum * v[1];
+						hj[k + 3] -= refsum * v[2];
+					}
+				}
+				if (bmp22) {
+					const T* v = &m_v[3 * m22];
+					for (int j = std::max(k22 + 1, ktop); j <= jbot; ++j) {
+						T* hj = h + j * ldh;
+						T refsum = v[0] * (hj[k22 + 1] + v[1] * hj[k22 + 2]);
+						hj[k22 + 1] -= refsum;
+						hj[k22 + 2] -= refsum * v[1];
+					}
+				}
+
+				// multiplies H by the reflectors from the right (inside the window), and accumulates them in U.
+				// The fill of the last row is delayed until the vigilant deflation check is done
+				int jtop = std::max(ktop, incol);
+				for (int m = mtop; m <= mbot; ++m) {
+					const T* v = &m_v[3 * m];
+					if (v[0] == zero)
+						continue;
+					int k = krcol + 3 * m;
+					T* h1 = h + (k + 1) * ldh, * h2 = h1 + ldh, * h3 = h2 + ldh;
+					for (int j = jtop; j <= std::min(kbot, k + 3); ++j) {
+						T refsum = v[0] * (h1[j] + v[1] * h2[j] + v[2] * h3[j]);
+						h1[j] -= refsum;
+						h2[j] -= refsum * v[1];
+						h3[j] -= refsum * v[2];
+					}
+					int kms = k - incol;
+					T* u1 = &U(0, kms), * u2 = u1 + ldu, * u3 = u2 + ldu;
+					for (int j = std::max(0, ktop - incol - 1); j < kdu; ++j) {
+						T refsum = v[0] * (u1[j] + v[1] * u2[j] + v[2] * u3[j]);
+						u1[j] -= refsum;
+						u2[j] -= refsum * v[1];
+						u3[j] -= refsum * v[2];
+					}
+				}
+				if (bmp22 && m_v[3 * m22] != zero) {
+					const T* v = &m_v[3 * m22];
+					T* h1 = h + (k22 + 1) * ldh, * h2 = h1 + ldh;
+					for (int j = jtop; j <= std::min(kbot, k22 + 3); ++j) {
+						T refsum = v[0] * (h1[j] + v[1] * h2[j]);
+						h1[j] -= refsum;
+						h2[j] -= refsum * v[1];
+					}
+					int kms = k22 - incol;
+					T* u1 = &U(0, kms), * u2 = u1 + ldu;
+					for (int j = std::max(0, ktop - incol - 1); j < kdu; ++j) {
+						T refsum = v[0] * (u1[j] + v[1] * u2[j]);
+						u1[j] -= refsum;
+						u2[j] -= refsum * v[1];
+					}
+				}
+
+				// vigilant deflation check: the traditional small-compared-to-nearby-diagonals criterion and the
+				// Ahues & Tisseur criterion must both be satisfied
+				int mstart = mtop;
+				if (krcol + 3 * mstart < ktop)
+					++mstart;
+				int mend = mbot;
+				if (bmp22)
+					++mend;
+				if (krcol == kbot - 2)
+					++mend;
+				for (int m = mstart; m <= mend; ++m) {
+					int k = std::min(kbot - 1, krcol + 3 * m);
+					if (H(k + 1, k) == zero)
+						continue;
+					T tst1 = std::abs(H(k, k)) + std::abs(H(k + 1, k + 1));
+					if (tst1 == zero) {
+						if (k >= ktop + 1)
+							tst1 += std::abs(H(k, k - 1));
+						if (k >= ktop + 2)
+							tst1 += std::abs(H(k, k - 2));
+						if (k >= ktop + 3)
+							tst1 += std::abs(H(k, k - 3));
+						if (k <= kbot - 2)
+							tst1 += std::abs(H(k + 2, k + 1));
+						if (k <= kbot - 3)
+							tst1 += std::abs(H(k + 3, k + 1));
+						if (k <= kbot - 4)
+							tst1 += std::abs(H(k + 4, k + 1));
+					}
+					if (std::abs(H(k + 1, k)) <= std::max(smlnum, ulp * tst1)) {
+						T h12 = std::max(std::abs(H(k + 1, k)), std::abs(H(k, k + 1)));
+						T h21 = std::min(std::abs(H(k + 1, k)), std::abs(H(k, k + 1)));
+						T h11 = std::max(std::abs(H(k + 1, k + 1)), std::abs(H(k, k) - H(k + 1, k + 1)));
+						T h22 = std::min(std::abs(H(k + 1, k + 1)), std::abs(H(k, k) - H(k + 1, k + 1)));
+						T scl = h11 + h12;
+						T tst2 = h22 * (h11 / scl);
+						if (tst2 == zero || h21 * (h12 / scl) <= std::max(smlnum, ulp * tst2))
+							H(k + 1, k) = zero;
+					}
+				}
+
+				// fills in the last row of each bulge
+				mend = std::min(nbmps, (kbot - krcol - 1) / 3) - 1;
+				for (int m = mtop; m <= mend; ++m) {
+					int k = krcol + 3 * m;
+					const T* v = &m_v[3 * m];
+					T refsum = v[0] * v[2] * H(k + 4, k + 3);
+					H(k + 4, k + 1) = -refsum;
+					H(k + 4, k + 2) = -refsum * v[1];
+					H(k + 4, k + 3) -= refsum * v[2];
+				}
+			}
+
+			// uses U to update the far-from-diagonal entries of H, and Z
+			int jtop = wantt ? 0 : ktop, jbot = wantt ? n - 1 : kbot;
+			int k1 = std::max(0, ktop - incol - 1);
+			int nu = kdu - std::max(0, ndcol - kbot) - k1;
+			if (nu <= 0)
+				continue;
+			// the row/column k1 of U corresponds to the row/column i1 of H
+			int i1 = incol + 1 + k1;
+			T* u = &U(k1, k1);
+			// horizontal multiply: H(i1:i1+nu-1, jcol:jbot) = U' * H(i1:i1+nu-1, jcol:jbot)
+			int jcol = std::min(ndcol, kbot) + 1;
+			if (jcol <= jbot) {
+				int nc = jbot - jcol + 1;
+				NUMCPP::FastMatrix<T> W = workspace(m_w, nu, nc);
+				gemm(true, false, nu, nc, nu, one, u, ldu, h + i1 + jcol * ldh, ldh, zero, W.ptr(), W.getColumnIncrement());
+				for (int c = 0; c < nc; ++c)
+					H.column(jcol + c).extract(i1, nu).copy(W.column(c));
+			}
+			// vertical multiply: H(jtop:jrow, i1:i1+nu-1) = H(jtop:jrow, i1:i1+nu-1) * U
+			int nr = std::max(ktop, incol) - jtop;
+			if (nr > 0) {
+				NUMCPP::FastMatrix<T> W = workspace(m_w, nr, nu);
+				gemm(false, false, nr, nu, nu, one, h + jtop + i1 * ldh, ldh, u, ldu, zero, W.ptr(), W.getColumnIncrement());
+				for (int c = 0; c < nu; ++c)
+					H.column(i1 + c).extract(jtop, nr).copy(W.column(c));
+			}
+			// Z = Z * U
+			if (wantz && ihiz >= iloz) {
+				int nz = ihiz - iloz + 1;
+				NUMCPP::FastMatrix<T> W = workspace(m_w, nz, nu);
+				gemm(false, false, nz, nu, nu, one, &Z(iloz, i1), Z.getColumnIncrement(), u, ldu, zero, W.ptr(), W.getColumnIncrement());
+				for (int c = 0; c < nu; ++c)
+					Z.column(i1 + c).extract(iloz, nz).copy(W.column(c));
+			}
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,67 @@
+#ifndef __lcpp_larf_h
+#define __lcpp_larf_h
+
+#include <vector>
+#include <stdexcept>
+#include "matrix.h"
+#include "matrix_0.h"
+#include "dot.h"
+
+namespace LCPP {
+    /// <summary>
+    /// Applies a real elementary reflector H to a real m by n matrix C, from either the left or the right.
+    /// H is represented in the form
+    ///       H = I - tau * v * v**T
+    /// where tau is a real scalar and v is a real vector (see LARFG).
+    /// The first element of v is not referenced and assumed to be 1 (so that v can be stored
+    /// in place of the reduced vector). v has m elements (left) or n elements (right).
+    /// </summary>
+    /// <typeparam name="T"></typeparam>
+    template <typename T>
+    class LARF {
+    public:
+
+        LARF() {}
+
+        void operator()(Side side, NUMCPP::Sequence<T> v, T tau, NUMCPP::FastMatrix<T> C);
+    };
+
+    template <typename T>
+    void LARF<T>::operator()(Side side, NUMCPP::Sequence<T> v, T tau, NUMCPP::FastMatrix<T> C) {
+        int m = C.getNrows(), n = C.getNcols();
+        if (v.length() != (side == Side::Left ? m : n))
+            throw std::invalid_argument("Invalid dimensions in larf");
+        if (tau == NUMCPP::CONSTANTS<T>::zero || C.isEmpty())
+            return;
+        NUMCPP::Sequence<T> v1 = v.drop(1, 0);
+        if (side == Side::Left) {
+            // C(:,j) -= tau * v * (v' * C(:,j))
+            DOT<T, T> dot;
+            NUMCPP::SequenceIterator<T> cols = C.columnsIterator();
+            while (cols.hasNext()) {
+                NUMCPP::Sequence<T> c = cols.next();
+                T* pc = c.start();
+                T s = *pc;
+                if (m > 1)
+                    s += dot(v1, c.drop(1, 0));
+                s *= tau;
+                *pc -= s;
+                if (m > 1)
+                    c.drop(1, 0).addAY(-s, v1);
+            }
+        }
+        else {
+            // w = C * v, C = C - tau * w * v'
+            std::vector<T> w(m);
+            NUMCPP::Sequence<T> ws(w.data(), m);
+            ws.copy(C.column(0));
+            for (int j = 1; j < n; ++j)
+                ws.addAY(v(j), C.column(j));
+            C.column(0).addAY(-tau, ws);
+            for (int j = 1; j < n; ++j)
+                C.column(j).addAY(-tau * v(j), ws);
+        }
+    }
+}
+
+#endif
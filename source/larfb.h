@@ -0,0 +1,118 @@
+#ifndef __lcpp_larfb_h
+#define __lcpp_larfb_h
+
+#include <stdexcept>
+#include "matrix.h"
+#include "matrix_0.h"
+#include "gemm.h"
+#include "trmm.h"
+
+namespace LCPP {
+    /// <summary>
+    /// Applies a real block reflector H = I - V * Tf * V' or its transpose H' to a real m by n matrix C,
+    /// from the left (C = H * C or H' * C) or from the right (C = C * H or C * H').
+    /// V (m x k for left, n x k for right) and Tf (k x k) are defined as in LARFT (vectors stored columnwise,
+    /// unit diagonal of V not referenced).
+    /// The computation is done by Level 3 operations (GEMM for the rectangular part of V, TRMM for
+    /// its triangular part and for Tf), through a workspace W of size n x k (left) or m x k (right).
+    /// </summary>
+    /// <typeparam name="T"></typeparam>
+    template <typename T>
+    class LARFB {
+    public:
+
+        LARFB() {}
+
+        void operator()(Side side, bool trans, Direction direct, NUMCPP::FastMatrix<T> V, NUMCPP::FastMatrix<T> Tf, NUMCPP::FastMatrix<T> C);
+
+    private:
+
+        void left(bool trans, Direction direct, NUMCPP::FastMatrix<T> V, NUMCPP::FastMatrix<T> Tf, NUMCPP::FastMatrix<T> C);
+        void right(bool trans, Direction direct, NUMCPP::FastMatrix<T> V, NUMCPP::FastMatrix<T> Tf, NUMCPP::FastMatrix<T> C);
+    };
+
+    template <typename T>
+    void LARFB<T>::operator()(Side side, bool trans, Direction direct, NUMCPP::FastMatrix<T> V, NUMCPP::FastMatrix<T> Tf, NUMCPP::FastMatrix<T> C) {
+        int m = C.getNrows(), n = C.getNcols(), k = V.getNcols();
+        if (V.getNrows() != (side == Side::Left ? m : n) || k > V.getNrows() || Tf.getNrows() != k || Tf.getNcols() != k)
+            throw std::invalid_argument("Invalid dimensions in larfb");
+        if (m == 0 || n == 0 || k == 0)
+            return;
+        if (side == Side::Left)
+            left(trans, direct, V, Tf, C);
+        else
+            right(trans, direct, V, Tf, C);
+    }
+
+    template <typename T>
+    void LARFB<T>::left(bool trans, Direction direct, NUMCPP::FastMatrix<T> V, NUMCPP::FastMatrix<T> Tf, NUMCPP::FastMatrix<T> C) {
+        int m = C.getNrows(), n = C.getNcols(), k = V.getNcols();
+        int ldv = V.getColumnIncrement(), ldc = C.getColumnIncrement();
+        T one = NUMCPP::CONSTANTS<T>::one;
+        bool forward = direct == Direction::Forward;
+        // V = [V1; V2] (forward, V1 = unit lower k x k) or [V1; V2] (backward, V2 = unit upper k x k)
+        // the triangular block of V and the corresponding rows of C start at row r0, the rectangular part at row q0
+        int r0 = forward ? 0 : m - k, q0 = forward ? k : 0;
+        Triangular vuplo = forward ? Triangular::Lower : Triangular::Upper;
+        Triangular tuplo = forward ? Triangular::Upper : Triangular::Lower;
+        NUMCPP::FastMatrix<T> Vt = V.extract(r0, k, 0, k);
+        const T* v = V.cptr();
+        T* c = C.ptr();
+        NUMCPP::Matrix<T> Wm(n, k);
+        NUMCPP::FastMatrix<T> W = Wm.all();
+        T* w = W.ptr();
+        int ldw = W.getColumnIncrement();
+        GEMM<T> gemm;
+        TRMM<T> trmm;
+        // W = C' * V = Ct' * Vt + Cq' * Vq
+        for (int j = 0; j < k; ++j)
+            W.column(j).copy(C.row(r0 + j));
+        trmm(Side::Right, vuplo, false, true, one, Vt, W);
+        if (m > k)
+            gemm(true, false, n, k, m - k, one, c + q0, ldc, v + q0, ldv, one, w, ldw);
+        // W = W * Tf' (H) or W * Tf (H')
+        trmm(Side::Right, tuplo, !trans, false, one, Tf, W);
+        // C = C - V * W'
+        if (m > k)
+            gemm(false, true, m - k, n, k, -one, v + q0, ldv, w, ldw, one, c + q0, ldc);
+        trmm(Side::Right, vuplo, true, true, one, Vt, W);
+        for (int j = 0; j < k; ++j)
+            C.row(r0 + j).addAY(-one, W.column(j));
+    }
+
+    template <typename T>
+    void LARFB<T>::right(bool trans, Direction direct, NUMCPP::FastMatrix<T> V, NUMCPP::FastMatrix<T> Tf, NUMCPP::FastMatrix<T> C) {
+        int m = C.getNrows(), n = C.getNcols(), k = V.getNcols();
+        int ldv = V.getColumnIncrement(), ldc = C.getColumnIncrement();
+        T one = NUMCPP::CONSTANTS<T>::one;
+        bool forward = direct == Direction::Forward;
+        int r0 = forward ? 0 : n - k, q0 = forward ? k : 0;
+        Triangular vuplo = forward ? Triangular::Lower : Triangular::Upper;
+        Triangular tuplo = forward ? Triangular::Upper : Triangular::Lower;
+        NUMCPP::FastMatrix<T> Vt = V.extract(r0, k, 0, k);
+        const T* v = V.cptr();
+        T* c = C.ptr();
+        NUMCPP::Matrix<T> Wm(m, k);
+        NUMCPP::FastMatrix<T> W = Wm.all();
+        T* w = W.ptr();
+        int ldw = W.getColumnIncrement();
+        GEMM<T> gemm;
+        TRMM<T> trmm;
+        // W = C * V = Ct * Vt + Cq * Vq
+        for (int j = 0; j < k; ++j)
+            W.column(j).copy(C.column(r0 + j));
+        trmm(Side::Right, vuplo, false, true, one, Vt, W);
+        if (n > k)
+            gemm(false, false, m, k, n - k, one, c + q0 * ldc, ldc, v + q0, ldv, one, w, ldw);
+        // W = W * Tf (H) or W * Tf' (H')
+        trmm(Side::Right, tuplo, trans, false, one, Tf, W);
+        // C = C - W * V'
+        if (n > k)
+            gemm(false, true, m, n - k, k, -one, w, ldw, v + q0, ldv, one, c + q0 * ldc, ldc);
+        trmm(Side::Right, vuplo, true, true, one, Vt, W);
+        for (int j = 0; j < k; ++j)
+            C.column(r0 + j).addAY(-one, W.column(j));
+    }
+}
+
+#endif
@@ -1,13 +1,20 @@
 #ifndef __lcpp_larfg_h
 #define __lcpp_larfg_h
 
+#include <cmath>
+#include <limits>
 #include "sequence.h"
+#include "nrm2.h"
 
 namespace LCPP {
     /// <summary>
     /// Generates an elementary reflector(Householder matrix).
     ///       H * ( alpha ) = ( beta ),   H**T * H = I.
     ///           (   x   )   (   0  )
+    /// H = I - tau * ( 1 ) * ( 1 v**T ), where tau is returned.
+    ///               ( v )
+    /// On exit, alpha is overwritten by beta and x by v. If x = 0, tau = 0 and H = I.
+    /// The Sequence version uses the first element of X as alpha and the remaining elements as x.
     /// </summary>
      template <typename T>
      class LARFG {
@@ -17,34 +24,58 @@ namespace LCPP {
        
         T operator()( NUMCPP::Sequence<T> X) {
             int incx = X.increment(), n = X.length();
-            T* x = X.begin();
-            if (incx == 1)
-                return apply(n, *x, x+1);
-            else
-                return apply(n, *x, x + incx, incx);
+            if (n == 0)
+                return NUMCPP::CONSTANTS<T>::zero;
+            T* x = X.start();
+            return apply(n, *x, x + incx, incx);
         }
 
-    private:
+        T operator()(int n, T& alpha, T* x, int incx) {
+            return apply(n, alpha, x, incx);
+        }
 
-        T apply(int n, T alpha, T* X, int incx);
+    private:
 
-        T apply(int n, T alpha, T* X);
+        T apply(int n, T& alpha, T* X, int incx);
     };
 
 
     template <typename T>
-    T LARFG<T>::apply(int n, T alpha, T* X, int incx) {
-
-        return 0;
-    }
-
-    template <typename T>
-    T LARFG<T>::apply(int n, T alpha, T* X) {
-
-        return 0;
+    T LARFG<T>::apply(int n, T& alpha, T* X, int incx) {
+        T zero = NUMCPP::CONSTANTS<T>::zero, one = NUMCPP::CONSTANTS<T>::one;
+        if (n <= 1)
+            return zero;
+        NRM2<T, T> nrm2;
+        T xnorm = nrm2(n - 1, X, incx);
+        if (xnorm == zero)
+            return zero;
+        T beta = -std::copysign(std::hypot(alpha, xnorm), alpha);
+        T safmin = NUMCPP::CONSTANTS<T>::safe_min / std::numeric_limits<T>::epsilon();
+        int knt = 0;
+        auto scale = [=](T s) {
+            T* x = X;
+            for (int i = 1; i < n; ++i, x += incx)
+                *x *= s;
+        };
+        if (std::abs(beta) < safmin) {
+            // xnorm, beta may be inaccurate; scale x and recompute them
+            T rsafmn = one / safmin;
+            do {
+                ++knt;
+                scale(rsafmn);
+                beta *= rsafmn;
+                alpha *= rsafmn;
+            } while (std::abs(beta) < safmin && knt < 20);
+            xnorm = nrm2(n - 1, X, incx);
+            beta = -std::copysign(std::hypot(alpha, xnorm), alpha);
+        }
+        T tau = (beta - alpha) / beta;
+        scale(one / (alpha - beta));
+        for (int j = 0; j < knt; ++j)
+            beta *= safmin;
+        alpha = beta;
+        return tau;
     }
 
 }
 #endif
-
-
@@ -0,0 +1,113 @@
+#ifndef __lcpp_larft_h
+#define __lcpp_larft_h
+
+#include <stdexcept>
+#include "matrix.h"
+#include "matrix_0.h"
+
+namespace LCPP {
+    /// <summary>
+    /// Forms the triangular factor Tf of a real block reflector H of order n, which is defined as a product
+    /// of k elementary reflectors (compact WY representation):
+    ///     H = I - V * Tf * V'
+    /// Forward: H = H(1) H(2) ... H(k) and Tf is upper triangular
+    /// Backward: H = H(k) ... H(2) H(1) and Tf is lower triangular
+    /// The vectors are stored columnwise in V (n x k):
+    /// Forward: V(i,i) = 1 (not referenced) and V(0:i-1, i) = 0 (not referenced)
+    /// Backward: V(n-k+i, i) = 1 (not referenced) and V(n-k+i+1:n-1, i) = 0 (not referenced)
+    /// so that V can be the output of a QR (or QL) factorization.
+    /// </summary>
+    /// <typeparam name="T"></typeparam>
+    template <typename T>
+    class LARFT {
+    public:
+
+        LARFT() {}
+
+        void operator()(Direction direct, NUMCPP::FastMatrix<T> V, NUMCPP::Sequence<T> tau, NUMCPP::FastMatrix<T> Tf);
+
+    private:
+
+        void forward(int n, int k, const T* v, int ldv, NUMCPP::Sequence<T> tau, T* t, int ldt);
+        void backward(int n, int k, const T* v, int ldv, NUMCPP::Sequence<T> tau, T* t, int ldt);
+    };
+
+    template <typename T>
+    void LARFT<T>::operator()(Direction direct, NUMCPP::FastMatrix<T> V, NUMCPP::Sequence<T> tau, NUMCPP::FastMatrix<T> Tf) {
+        int n = V.getNrows(), k = V.getNcols();
+        if (k > n || tau.length() < k || Tf.getNrows() != k || Tf.getNcols() != k)
+            throw std::invalid_argument("Invalid dimensions in larft");
+        if (k == 0)
+            return;
+        if (direct == Direction::Forward)
+            forward(n, k, V.cptr(), V.getColumnIncrement(), tau, Tf.ptr(), Tf.getColumnIncrement());
+        else
+            backward(n, k, V.cptr(), V.getColumnIncrement(), tau, Tf.ptr(), Tf.getColumnIncrement());
+    }
+
+    template <typename T>
+    void LARFT<T>::forward(int n, int k, const T* v, int ldv, NUMCPP::Sequence<T> tau, T* t, int ldt) {
+        T zero = NUMCPP::CONSTANTS<T>::zero;
+        for (int i = 0; i < k; ++i) {
+            T* ti = t + i * ldt;
+            T taui = tau(i);
+            if (taui == zero) {
+                for (int j = 0; j <= i; ++j)
+                    ti[j] = zero;
+                continue;
+            }
+            // Tf(0:i-1, i) = -tau(i) * V(i:n-1, 0:i-1)' * V(i:n-1, i)
+            const T* vi = v + i * ldv;
+            for (int j = 0; j < i; ++j) {
+                const T* vj = v + j * ldv;
+                T s = vj[i];
+                for (int r = i + 1; r < n; ++r)
+                    s += vj[r] * vi[r];
+                ti[j] = -taui * s;
+            }
+            // Tf(0:i-1, i) = Tf(0:i-1, 0:i-1) * Tf(0:i-1, i) (upper triangular)
+            for (int r = 0; r < i; ++r) {
+                T s = zero;
+                for (int c = r; c < i; ++c)
+                    s += t[r + c * ldt] * ti[c];
+                ti[r] = s;
+            }
+            ti[i] = taui;
+        }
+    }
+
+    template <typename T>
+    void LARFT<T>::backward(int n, int k, const T* v, int ldv, NUMCPP::Sequence<T> tau, T* t, int ldt) {
+        T zero = NUMCPP::CONSTANTS<T>::zero;
+        for (int i = k - 1; i >= 0; --i) {
+            T* ti = t + i * ldt;
+            T taui = tau(i);
+            if (taui == zero) {
+                for (int j = i; j < k; ++j)
+                    ti[j] = zero;
+                continue;
+            }
+            // unit element of the reflector i
+            int p = n - k + i;
+            // Tf(i+1:k-1, i) = -tau(i) * V(0:p, i+1:k-1)' * V(0:p, i)
+            const T* vi = v + i * ldv;
+            for (int j = i + 1; j < k; ++j) {
+                const T* vj = v + j * ldv;
+                T s = vj[p];
+                for (int r = 0; r < p; ++r)
+                    s += vj[r] * vi[r];
+                ti[j] = -taui * s;
+            }
+            // Tf(i+1:k-1, i) = Tf(i+1:k-1, i+1:k-1) * Tf(i+1:k-1, i) (lower triangular)
+            for (int r = k - 1; r > i; --r) {
+                T s = zero;
+                for (int c = i + 1; c <= r; ++c)
+                    s += t[r + c * ldt] * ti[c];
+                ti[r] = s;
+            }
+            ti[i] = taui;
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef __lcpp_lartg_h
+#define __lcpp_lartg_h
+
+#include <cmath>
+#include "constants.h"
+
+namespace LCPP {
+	/// <summary>
+	/// Generates a plane rotation so that
+	///     [  c  s ] [ f ]   [ r ]
+	///     [ -s  c ] [ g ] = [ 0 ]
+	/// with c * c + s * s = 1 (see ROT for the application of the rotation). r has the sign of f.
+	/// </summary>
+	/// <typeparam name="T"></typeparam>
+	template<typename T>
+	class LARTG {
+	public:
+
+		LARTG() {}
+
+		void operator()(T f, T g, T& c, T& s, T& r) const;
+	};
+
+	template<typename T>
+	void LARTG<T>::operator()(T f, T g, T& c, T& s, T& r) const {
+		T zero = NUMCPP::CONSTANTS<T>::zero, one = NUMCPP::CONSTANTS<T>::one;
+		if (g == zero) {
+			c = one;
+			s = zero;
+			r = f;
+		}
+		else if (f == zero) {
+			c = zero;
+			s = g > zero ? one : -one;
+			r = std::abs(g);
+		}
+		else {
+			T d = std::hypot(f, g);
+			c = std::abs(f) / d;
+			r = f > zero ? d : -d;
+			s = g / r;
+		}
+	}
+}
+
+#endif
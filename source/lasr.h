@@ -0,0 +1,147 @@
+#ifndef __lcpp_lasr_h
+#define __lcpp_lasr_h
+
+#include <algorithm>
+#include <stdexcept>
+#include "matrix.h"
+#include "matrix_0.h"
+#include "rot.h"
+
+namespace LCPP {
+    /// <summary>
+    /// Applies k sequences of plane rotations to a real m x n matrix A, from the right (the rotation j acts
+    /// on the columns j and j+1, the sequences have n-1 rotations) or from the left (the rotation j acts on
+    /// the rows j and j+1, the sequences have m-1 rotations). Each rotation is applied as in ROT:
+    ///     x = c * x + s * y, y = c * y - s * x,  with x the column (row) j and y the column (row) j+1.
+    /// The sequence l is stored in the column l of C and S. The sequences are applied in order (0 to k-1),
+    /// and the rotations of a sequence from the first one to the last one (Forward) or in the reverse order
+    /// (Backward), as in the implicit QR/QL iterations.
+    /// From the right, the rows are independent: A is processed by blocks of MB rows, and in each block the
+    /// rotations are applied in wavefront order (sequence l runs one column behind sequence l-1), so that
+    /// only k+1 columns of the block are active at a time and stay in L1 across the k sequences. The rotations
+    /// are applied on unit-stride columns, and two rotations of consecutive sequences which share a column are
+    /// applied in a single pass. From the left, the columns are independent and
+    /// the same wavefront is used on blocks of NB columns (each rotation updating NB independent pairs).
+    /// Identity rotations (c = 1, s = 0) are skipped.
+    /// </summary>
+    /// <typeparam name="T"></typeparam>
+    template <typename T>
+    class LASR {
+    public:
+
+        LASR() {}
+
+        void operator()(Side side, Direction direct, NUMCPP::FastMatrix<T> C, NUMCPP::FastMatrix<T> S, NUMCPP::FastMatrix<T> A);
+
+        void operator()(Side side, Direction direct, int m, int n, int k, const T* C, const T* S, int ldcs, T* A, int lda) {
+            if (side == Side::Right)
+                right(direct, m, n, k, C, S, ldcs, A, lda);
+            else
+                left(direct, m, n, k, C, S, ldcs, A, lda);
+        }
+
+    private:
+
+        static constexpr int MB = 128, NB = 16;
+
+        // two rotations sharing a column, applied to the consecutive columns a0, a1, a2
+        static void rot2(int n, T* a0, T* a1, T* a2, T c1, T s1, T c2, T s2, bool forward);
+        void right(Direction direct, int m, int n, int k, const T* C, const T* S, int ldcs, T* A, int lda);
+        void left(Direction direct, int m, int n, int k, const T* C, const T* S, int ldcs, T* A, int lda);
+    };
+
+    template <typename T>
+    void LASR<T>::operator()(Side side, Direction direct, NUMCPP::FastMatrix<T> C, NUMCPP::FastMatrix<T> S, NUMCPP::FastMatrix<T> A) {
+        int m = A.getNrows(), n = A.getNcols(), k = C.getNcols();
+        int nr = (side == Side::Right ? n : m) - 1;
+        if (S.getNcols() != k || C.getNrows() < nr || S.getNrows() < nr || C.getColumnIncrement() != S.getColumnIncrement())
+            throw std::invalid_argument("invalid dimensions in LASR");
+        (*this)(side, direct, m, n, k, C.cptr(), S.cptr(), C.getColumnIncrement(), A.ptr(), A.getColumnIncrement());
+    }
+
+    template <typename T>
+    void LASR<T>::rot2(int n, T* a0, T* a1, T* a2, T c1, T s1, T c2, T s2, bool forward) {
+        if (forward) {
+            // (a1, a2) then (a0, a1)
+            for (int i = 0; i < n; ++i) {
+                T x0 = a0[i], x1 = a1[i], x2 = a2[i];
+                T y1 = c1 * x1 + s1 * x2;
+                a2[i] = c1 * x2 - s1 * x1;
+                a0[i] = c2 * x0 + s2 * y1;
+                a1[i] = c2 * y1 - s2 * x0;
+            }
+        }
+        else {
+            // (a0, a1) then (a1, a2)
+            for (int i = 0; i < n; ++i) {
+                T x0 = a0[i], x1 = a1[i], x2 = a2[i];
+                a0[i] = c1 * x0 + s1 * x1;
+                T y1 = c1 * x1 - s1 * x0;
+                a1[i] = c2 * y1 + s2 * x2;
+                a2[i] = c2 * x2 - s2 * y1;
+            }
+        }
+    }
+
+    template <typename T>
+    void LASR<T>::right(Direction direct, int m, int n, int k, const T* C, const T* S, int ldcs, T* A, int lda) {
+        int nr = n - 1;
+        if (m <= 0 || nr <= 0 || k <= 0)
+            return;
+        T zero = NUMCPP::CONSTANTS<T>::zero, one = NUMCPP::CONSTANTS<T>::one;
+        ROT<T> rot;
+        bool forward = direct == Direction::Forward;
+        for (int i0 = 0; i0 < m; i0 += MB) {
+            int mb = std::min(MB, m - i0);
+            T* a = A + i0;
+            // step t: rotation t-l of the sequence l
+            for (int t = 0; t < nr + k - 1; ++t) {
+                int l0 = std::max(0, t - nr + 1), l1 = std::min(k - 1, t);
+                for (int l = l0; l <= l1; ++l) {
+                    int j = forward ? t - l : nr - 1 - (t - l);
+                    T c = C[j + l * ldcs], s = S[j + l * ldcs];
+                    bool id = c == one && s == zero;
+                    if (l < l1) {
+                        // the next sequence updates one of the two columns: both rotations are applied in one pass
+                        int j2 = forward ? j - 1 : j + 1;
+                        T c2 = C[j2 + (l + 1) * ldcs], s2 = S[j2 + (l + 1) * ldcs];
+                        if (!id && (c2 != one || s2 != zero)) {
+                            int p = forward ? j2 : j;
+                            rot2(mb, a + p * lda, a + (p + 1) * lda, a + (p + 2) * lda, c, s, c2, s2, forward);
+                            ++l;
+                            continue;
+                        }
+                    }
+                    if (!id)
+                        rot(mb, a + j * lda, a + (j + 1) * lda, c, s);
+                }
+            }
+        }
+    }
+
+    template <typename T>
+    void LASR<T>::left(Direction direct, int m, int n, int k, const T* C, const T* S, int ldcs, T* A, int lda) {
+        int nr = m - 1;
+        if (n <= 0 || nr <= 0 || k <= 0)
+            return;
+        T zero = NUMCPP::CONSTANTS<T>::zero, one = NUMCPP::CONSTANTS<T>::one;
+        ROT<T> rot;
+        bool forward = direct == Direction::Forward;
+        for (int p0 = 0; p0 < n; p0 += NB) {
+            int nb = std::min(NB, n - p0);
+            T* a = A + p0 * lda;
+            for (int t = 0; t < nr + k - 1; ++t) {
+                int l0 = std::max(0, t - nr + 1), l1 = std::min(k - 1, t);
+                for (int l = l0; l <= l1; ++l) {
+                    int j = forward ? t - l : nr - 1 - (t - l);
+                    T c = C[j + l * ldcs], s = S[j + l * ldcs];
+                    if (c == one && s == zero)
+                        continue;
+                    rot(nb, a + j, lda, a + j + 1, lda, c, s);
+                }
+            }
+        }
+    }
+}
+
+#endif
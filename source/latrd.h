@@ -0,0 +1,83 @@
+#ifndef __lcpp_latrd_h
+#define __lcpp_latrd_h
+
+#include <algorithm>
+#include "matrix.h"
+#include "matrix_0.h"
+#include "larfg.h"
+#include "symv.h"
+#include "gemm.h"
+#include "dot.h"
+
+namespace LCPP {
+	/// <summary>
+	/// Reduces the first nb columns of a real symmetric n x n matrix A to tridiagonal form by an orthogonal
+	/// similarity transformation Q' * A * Q (panel of the blocked tridiagonal reduction, see SYTRD).
+	/// Only the lower triangle of A is referenced. The reflectors are stored as in SYTD2 and the off-diagonal
+	/// elements of the panel are returned in e(0:nb-1); the unit elements of the reflectors are set explicitly
+	/// in A(i+1, i).
+	/// The routine also returns the n x nb matrix W needed to update the trailing matrix
+	/// A(nb:n-1, nb:n-1) = A(nb:n-1, nb:n-1) - V * W' - W * V' (SYR2K), V being the reflectors of the panel.
+	/// The diagonal of the panel is updated, but the trailing matrix is not modified.
+	/// </summary>
+	/// <typeparam name="T"></typeparam>
+	template<typename T>
+	class LATRD {
+	public:
+
+		LATRD() {}
+
+		void operator()(int nb, NUMCPP::FastMatrix<T> A, NUMCPP::Sequence<T> e, NUMCPP::Sequence<T> tau, NUMCPP::FastMatrix<T> W);
+	};
+
+	template<typename T>
+	void LATRD<T>::operator()(int nb, NUMCPP::FastMatrix<T> A, NUMCPP::Sequence<T> e, NUMCPP::Sequence<T> tau, NUMCPP::FastMatrix<T> W) {
+		int n = A.getNrows();
+		if (n == 0)
+			return;
+		T zero = NUMCPP::CONSTANTS<T>::zero, one = NUMCPP::CONSTANTS<T>::one, half = NUMCPP::CONSTANTS<T>::half;
+		int lda = A.getColumnIncrement(), ldw = W.getColumnIncrement();
+		T* a = A.ptr();
+		T* w = W.ptr();
+		auto pa = [=](int r, int c) {return a + r + c * lda; };
+		auto pw = [=](int r, int c) {return w + r + c * ldw; };
+		LARFG<T> larfg;
+		SYMV<T> symv;
+		GEMM<T> gemm;
+		DOT<T, T> dot;
+		for (int i = 0; i < nb; ++i) {
+			int m = n - i - 1;
+			if (i > 0) {
+				// A(i:n-1, i) = A(i:n-1, i) - V(i:n-1, 0:i-1) * W(i, 0:i-1)' - W(i:n-1, 0:i-1) * V(i, 0:i-1)'
+				gemm(false, true, m + 1, 1, i, -one, pa(i, 0), lda, pw(i, 0), ldw, one, pa(i, i), lda);
+				gemm(false, true, m + 1, 1, i, -one, pw(i, 0), ldw, pa(i, 0), lda, one, pa(i, i), lda);
+			}
+			if (m == 0)
+				break;
+			// H(i) annihilates A(i+2:n-1, i)
+			T* v = pa(i + 1, i);
+			tau(i) = larfg(m, *v, pa(std::min(i + 2, n - 1), i), 1);
+			e(i) = *v;
+			*v = one;
+			// W(i+1:n-1, i) = tau * (A(i+1:n-1, i+1:n-1) * v - V * (W' * v) - W * (V' * v)), using W(0:i-1, i) as workspace
+			T* wi = pw(i + 1, i);
+			symv(Triangular::Lower, m, one, pa(i + 1, i + 1), lda, v, 1, zero, wi, 1);
+			if (i > 0) {
+				T* t = pw(0, i);
+				gemm(true, false, i, 1, m, one, pw(i + 1, 0), ldw, v, lda, zero, t, ldw);
+				gemm(false, false, m, 1, i, -one, pa(i + 1, 0), lda, t, ldw, one, wi, ldw);
+				gemm(true, false, i, 1, m, one, pa(i + 1, 0), lda, v, lda, zero, t, ldw);
+				gemm(false, false, m, 1, i, -one, pw(i + 1, 0), ldw, t, ldw, one, wi, ldw);
+			}
+			T ti = tau(i);
+			for (int r = 0; r < m; ++r)
+				wi[r] *= ti;
+			// W(i+1:n-1, i) = W(i+1:n-1, i) - 1/2 * tau * (W(i+1:n-1, i)' * v) * v
+			T alpha = -half * ti * dot(m, wi, v);
+			for (int r = 0; r < m; ++r)
+				wi[r] += alpha * v[r];
+		}
+	}
+}
+
+#endif
@@ -10,6 +10,10 @@
 #include "sequence.h"
 #include "Testmat1.h"
 #include "TestBlas.h"
+#include "TestCholesky.h"
+#include "TestSolve1.h"
+#include "TestQR.h"
+#include "TestEigen.h"
 
 int main()
 {
@@ -17,11 +21,46 @@ int main()
         int m = 10, n = 15, k = 10, q = 10; // q = 1000000;
         TestBlas blas;
         TestMatrix1 test1;
+        TestCholesky chol;
+        TestSolve1 solve;
+        TestQR qr;
+        TestEigen eigen;
         //blas.test1(10000, q);
         //blas.test2(m,n,q);
+        //blas.testLASR(2000, 2000, 16);
+        //blas.testSIMD(10000, 100000);
+        //blas.testNRM2(10000, 100000);
+        //blas.testExpressions(10000, 100000);
+        //blas.testParallelReductions(20000000);
+        //blas.testIAMAX(10000, 100000);
+        //blas.testContiguous(12, 10000000);
+        //blas.testRandom(10000000);
+        //blas.testBlockedGEMM(1000, 1000, 1000);
         test1.testGEMM(m, n, k, q);
         test1.testTRSM();
         //test1.testTRMM();
+        //chol.testPOTF2(100);
+        //chol.testPOTRF2(500);
+        //chol.testPOTRF(2000, 0);
+        //chol.testTPOTRF(2000, 128, 0);
+        //chol.testCHUD(100);
+        //chol.testWindowedLeastSquares(10, 250, 100000);
+        //chol.testPackedCholesky(1000);
+        //solve.testPOSV(1000, 100);
+        //solve.testBand(1000000, 5, 5);
+        //qr.testLARFG(100, 50);
+        //qr.testLARFB(1000, 500, 32);
+        //qr.testGEQRF(1000, 500);
+        //qr.testTSQR(1000000, 50, 0);
+        //qr.testGELS(1000, 50, 100);
+        //qr.testGELS(50, 1000, 100);
+        //qr.testManyGELS(10000, 250, 10);
+        //eigen.testGEHRD(1000);
+        //eigen.testGEBAL(1000);
+        //eigen.testHSEQR(1000);
+        //eigen.testCompanion(100, 20);
+        //eigen.testSYEVD(1000);
+        //eigen.testGESVJ(2000, 500);
 
     }
     catch (const std::exception& err) {
@@ -45,9 +45,9 @@ namespace NUMCPP {
 			return Sequence<T>(m_data + row, m_data + row + m_lda * m_ncols, m_lda);
 		}
 
-		Sequence<T> column(int col) const {
+		ContiguousSequence<T> column(int col) const {
 			int start = col * m_lda;
-			return Sequence<T>(m_data + start, m_data + start + m_nrows);
+			return ContiguousSequence<T>(m_data + start, m_data + start + m_nrows);
 		}
 
 		Sequence<T> diagonal() const {
@@ -228,9 +228,9 @@ namespace NUMCPP {
 			return Sequence<T>(m_data + row, m_data + row + m_nrows * m_ncols, m_nrows);
 		}
 
-		Sequence<T> column(int col)const {
+		ContiguousSequence<T> column(int col)const {
 			int start = col * m_nrows;
-			return Sequence<T>(m_data + start, m_data + start + m_nrows);
+			return ContiguousSequence<T>(m_data + start, m_data + start + m_nrows);
 		}
 
 		template<typename S>
@@ -351,12 +351,7 @@ namespace NUMCPP {
 
 	template<>
 	inline void Matrix<double>::rand()const {
-		std::random_device rd;
-		std::mt19937 mt(rd());
-		std::uniform_real_distribution<double> dist(1.0, 10.0);
-		int sz = size();
-		for (int u = 0; u < sz; ++u)
-			m_data[u] = dist(mt);
+		Random::next().uniform(Sequence<double>(m_data, size()), 1.0, 10.0);
 	}
 
 	template<typename T>
@@ -431,7 +426,7 @@ namespace NUMCPP {
 		if (value == NUMCPP::CONSTANTS<T>::one)
 			return;
 		if (value == NUMCPP::CONSTANTS<T>::zero) {
-			set(m, n, value, C, ldc);
+			set(C, ldc, m, n, value);
 			return;
 		}
 		T* cstart = C;
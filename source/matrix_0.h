@@ -11,6 +11,14 @@ namespace LCPP {
 		Left, Right
 	};
 
+	/// <summary>
+	/// Order of the elementary reflectors in a block reflector: H = H(1) H(2) ... H(k) (Forward)
+	/// or H = H(k) ... H(2) H(1) (Backward)
+	/// </summary>
+	enum Direction {
+		Forward, Backward
+	};
+
 }
 
 #endif
@@ -1,12 +1,16 @@
 #ifndef __lcpp_nrm2_h
 #define __lcpp_nrm2_h
 
+#include <cmath>
 #include "sequence.h"
 
 namespace LCPP {
 
     /// <summary>
     /// Computes sqrt(x'x)
+    /// The sum of squares is first accumulated without scaling (SIMD kernel for unit-stride doubles).
+    /// Only when that sum overflowed, lost accuracy to underflow or met a NaN, a second pass uses
+    /// Blue's algorithm (three accumulators for small, medium and big entries)
     /// </summary>
     template <typename T, typename S>
     class NRM2 {
@@ -24,12 +28,16 @@ namespace LCPP {
 
         S operator()(NUMCPP::Sequence<T> X) {
             int incx = X.increment(), n = X.length();
-            return apply(n, X.begin(), incx);
+            return apply(n, X.cstart(), incx);
         }
 
     private:
 
         S apply(int n, const T* X, int incx);
+
+        S ssq(int n, const T* X, int incx);
+
+        S scaled(int n, const T* X, int incx);
     };
 
 
@@ -39,6 +47,39 @@ namespace LCPP {
         S zero = NUMCPP::CONSTANTS<S>::zero;
         if (n == 0)
             return zero;
+        S sumsq = ssq(n, X, incx);
+        // each square below safe_min loses at most the smallest subnormal, i.e. eps * safe_min:
+        // the unscaled sum is accurate if it is larger than n * safe_min (and finite)
+        if (sumsq >= n * NUMCPP::CONSTANTS<S>::safe_min && sumsq <= NUMCPP::CONSTANTS<S>::huge)
+            return std::sqrt(sumsq);
+        return scaled(n, X, incx);
+    }
+
+    template <typename T, typename S>
+    S NRM2<T, S>::ssq(int n, const T* X, int incx) {
+        if constexpr (std::is_same<T, double>::value && std::is_same<S, double>::value) {
+            if (incx == 1 && n >= NUMCPP::SIMD::MIN_LENGTH)
+                return NUMCPP::SIMD::ssq(n, X);
+        }
+        // no branch on the magnitude of the entries, two accumulators
+        S s0 = NUMCPP::CONSTANTS<S>::zero, s1 = s0;
+        const T* x = X;
+        int i = 0;
+        for (; i + 1 < n; i += 2, x += 2 * incx) {
+            S a0 = std::abs(x[0]), a1 = std::abs(x[incx]);
+            s0 += a0 * a0;
+            s1 += a1 * a1;
+        }
+        if (i < n) {
+            S a0 = std::abs(*x);
+            s0 += a0 * a0;
+        }
+        return s0 + s1;
+    }
+
+    template <typename T, typename S>
+    S NRM2<T, S>::scaled(int n, const T* X, int incx) {
+        S zero = NUMCPP::CONSTANTS<S>::zero;
         bool notbig = true;
         S one = NUMCPP::CONSTANTS<S>::one;
         S maxn = NUMCPP::CONSTANTS<S>::huge;
@@ -55,7 +96,7 @@ namespace LCPP {
         const T* x = X;
         const T* const e = X + incx * n;
         while (x != e) {
-            double ax = abs(*x);
+            double ax = std::abs(*x);
             if (ax > tbig) {
                 double tmp = ax * sbig;
                 abig += tmp * tmp;
@@ -81,8 +122,8 @@ namespace LCPP {
         }
         else if (asml > zero) {
             if (amed > zero || amed > maxn || amed != amed) {
-                amed = sqrt(amed);
-                asml = sqrt(asml) / ssml;
+                amed = std::sqrt(amed);
+                asml = std::sqrt(asml) / ssml;
                 if (asml > amed) {
                     ymin = amed;
                     ymax = asml;
@@ -104,7 +145,7 @@ namespace LCPP {
             scl = one;
             sumsq = amed;
         }
-        return scl * sqrt(sumsq);
+        return scl * std::sqrt(sumsq);
     }
 
 
@@ -0,0 +1,67 @@
+#ifndef __lcpp_orghr_h
+#define __lcpp_orghr_h
+
+#include <stdexcept>
+#include "matrix.h"
+#include "matrix_0.h"
+#include "orgqr.h"
+
+namespace LCPP {
+	/// <summary>
+	/// Generates the n x n orthogonal matrix Q determined by GEHRD (or GEHD2) when reducing A to Hessenberg form:
+	///     Q = H(ilo) H(ilo+1) . . . H(ihi-1)
+	/// On entry, A contains the output of GEHRD; on exit, A contains Q.
+	/// Q is the identity outside rows and columns ilo+1:ihi; its central block is generated by ORGQR.
+	/// </summary>
+	/// <typeparam name="T"></typeparam>
+	template<typename T>
+	class ORGHR {
+	public:
+
+		ORGHR() {}
+
+		void operator()(int ilo, int ihi, NUMCPP::FastMatrix<T> A, NUMCPP::Sequence<T> tau);
+		void operator()(NUMCPP::FastMatrix<T> A, NUMCPP::Sequence<T> tau) {
+			(*this)(0, A.getNrows() - 1, A, tau);
+		}
+		void operator()(NUMCPP::Matrix<T>& A, NUMCPP::Sequence<T> tau) {
+			(*this)(A.all(), tau);
+		}
+	};
+
+	template<typename T>
+	void ORGHR<T>::operator()(int ilo, int ihi, NUMCPP::FastMatrix<T> A, NUMCPP::Sequence<T> tau) {
+		int n = A.getNrows();
+		if (!A.isSquare())
+			throw std::invalid_argument("Not square matrix in orghr");
+		if (ilo < 0 || ilo > std::max(0, n - 1) || ihi < std::min(ilo, n - 1) || ihi >= n)
+			throw std::invalid_argument("Invalid arguments in orghr");
+		if (n == 0)
+			return;
+		T zero = NUMCPP::CONSTANTS<T>::zero, one = NUMCPP::CONSTANTS<T>::one;
+		// shifts the vectors which define the reflectors one column to the right,
+		// and sets the first ilo+1 and the last n-ihi-1 rows and columns to those of the unit matrix
+		for (int j = ihi; j > ilo; --j) {
+			NUMCPP::Sequence<T> cj = A.column(j);
+			cj.left(j).set(zero);
+			for (int i = j + 1; i <= ihi; ++i)
+				cj(i) = A(i, j - 1);
+			cj.drop(ihi + 1, 0).set(zero);
+		}
+		for (int j = 0; j <= ilo; ++j) {
+			A.column(j).set(zero);
+			A(j, j) = one;
+		}
+		for (int j = ihi + 1; j < n; ++j) {
+			A.column(j).set(zero);
+			A(j, j) = one;
+		}
+		int nh = ihi - ilo;
+		if (nh > 0) {
+			ORGQR<T> orgqr;
+			orgqr(nh, A.extract(ilo + 1, nh, ilo + 1, nh), tau.extract(ilo, nh));
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,103 @@
+#ifndef __lcpp_orgqr_h
+#define __lcpp_orgqr_h
+
+#include <algorithm>
+#include <stdexcept>
+#include "matrix.h"
+#include "matrix_0.h"
+#include "laenv.h"
+#include "larf.h"
+#include "larft.h"
+#include "larfb.h"
+
+namespace LCPP {
+	/// <summary>
+	/// Generates an m by n real matrix Q with orthonormal columns (m >= n), which is defined as the first n columns
+	/// of a product of k elementary reflectors of order m (k <= n)
+	///       Q = H(1) H(2) . . . H(k)
+	/// as returned by GEQRF. On entry, the first k columns of A contain the reflectors; on exit, A contains Q.
+	/// The columns are generated by blocks of nb, from the last block to the first one: each block is
+	/// applied to the columns already generated by LARFB, then expanded in place by the unblocked code.
+	/// The last columns (beyond the crossover point given by LAENV) are generated by the unblocked code.
+	/// </summary>
+	/// <typeparam name="T"></typeparam>
+	template<typename T>
+	class ORGQR {
+	public:
+
+		ORGQR() {}
+
+		void operator()(int k, NUMCPP::FastMatrix<T> A, NUMCPP::Sequence<T> tau);
+		void operator()(int k, NUMCPP::Matrix<T>& A, NUMCPP::Sequence<T> tau) {
+			(*this)(k, A.all(), tau);
+		}
+
+	private:
+
+		// unblocked code (ORG2R)
+		void apply_unblocked(int k, NUMCPP::FastMatrix<T> A, NUMCPP::Sequence<T> tau);
+	};
+
+	template<typename T>
+	void ORGQR<T>::operator()(int k, NUMCPP::FastMatrix<T> A, NUMCPP::Sequence<T> tau) {
+		int m = A.getNrows(), n = A.getNcols();
+		if (n > m || k < 0 || k > n || tau.length() < k)
+			throw std::invalid_argument("Invalid dimensions in orgqr");
+		if (n == 0)
+			return;
+		LAENV laenv;
+		int nb = laenv(LAENV::Optimal, "ORGQR", "", m, n, k, -1);
+		int nx = std::max(nb, laenv(LAENV::CrossOver, "ORGQR", "", m, n, k, -1));
+		if (nb >= k || nx >= k) {
+			apply_unblocked(k, A, tau);
+			return;
+		}
+		T zero = NUMCPP::CONSTANTS<T>::zero;
+		// first column of the last block; the columns kk:n-1 (at least nx reflectors) are generated by the unblocked code
+		int ki = ((k - nx - 1) / nb) * nb, kk = ki + nb;
+		A.extract(0, kk, kk, n - kk).set(zero);
+		apply_unblocked(k - kk, A.extract(kk, m - kk, kk, n - kk), tau.drop(kk, 0));
+		LARFT<T> larft;
+		LARFB<T> larfb;
+		NUMCPP::Matrix<T> Tm(nb, nb);
+		for (int i = ki; i >= 0; i -= nb) {
+			int ib = std::min(nb, k - i);
+			NUMCPP::FastMatrix<T> V = A.extract(i, m - i, i, ib);
+			if (i + ib < n) {
+				// H(i) ... H(i+ib-1) applied to A(i:m-1, i+ib:n-1) from the left
+				NUMCPP::FastMatrix<T> Tf = Tm.extract(0, ib, 0, ib);
+				larft(Direction::Forward, V, tau.extract(i, ib), Tf);
+				larfb(Side::Left, false, Direction::Forward, V, Tf, A.extract(i, m - i, i + ib, n - i - ib));
+			}
+			apply_unblocked(ib, V, tau.extract(i, ib));
+			A.extract(0, i, i, ib).set(zero);
+		}
+	}
+
+	template<typename T>
+	void ORGQR<T>::apply_unblocked(int k, NUMCPP::FastMatrix<T> A, NUMCPP::Sequence<T> tau) {
+		int m = A.getNrows(), n = A.getNcols();
+		T zero = NUMCPP::CONSTANTS<T>::zero, one = NUMCPP::CONSTANTS<T>::one;
+		// columns k:n-1 are initialized to the columns of the unit matrix
+		for (int j = k; j < n; ++j) {
+			A.column(j).set(zero);
+			A(j, j) = one;
+		}
+		LARF<T> larf;
+		for (int i = k - 1; i >= 0; --i) {
+			NUMCPP::Sequence<T> v = A.column(i).drop(i, 0);
+			T taui = tau(i);
+			// applies H(i) to A(i:m-1, i+1:n-1) from the left
+			if (i < n - 1)
+				larf(Side::Left, v, taui, A.extract(i, m - i, i + 1, n - i - 1));
+			if (i < m - 1)
+				v.drop(1, 0).mul(-taui);
+			A(i, i) = one - taui;
+			// A(0:i-1, i) = 0
+			for (int l = 0; l < i; ++l)
+				A(l, i) = zero;
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,64 @@
+#ifndef __lcpp_ormqr_h
+#define __lcpp_ormqr_h
+
+#include <algorithm>
+#include <stdexcept>
+#include "matrix.h"
+#include "matrix_0.h"
+#include "laenv.h"
+#include "larft.h"
+#include "larfb.h"
+
+namespace LCPP {
+	/// <summary>
+	/// Overwrites the general real m by n matrix C with
+	///   Q * C, Q' * C (left) or C * Q, C * Q' (right)
+	/// where Q is the orthogonal matrix defined as the product of k elementary reflectors
+	///       Q = H(1) H(2) . . . H(k)
+	/// as returned by GEQRF (the reflectors are stored in the k columns of A, which has m rows (left) or n rows (right)).
+	/// Q is never formed: the reflectors are applied by blocks of nb (LARFT + LARFB).
+	/// </summary>
+	/// <typeparam name="T"></typeparam>
+	template<typename T>
+	class ORMQR {
+	public:
+
+		ORMQR() {}
+
+		void operator()(Side side, bool trans, NUMCPP::FastMatrix<T> A, NUMCPP::Sequence<T> tau, NUMCPP::FastMatrix<T> C);
+	};
+
+	template<typename T>
+	void ORMQR<T>::operator()(Side side, bool trans, NUMCPP::FastMatrix<T> A, NUMCPP::Sequence<T> tau, NUMCPP::FastMatrix<T> C) {
+		int m = C.getNrows(), n = C.getNcols(), k = A.getNcols();
+		bool left = side == Side::Left;
+		// order of Q
+		int nq = left ? m : n;
+		if (A.getNrows() != nq || k > nq || tau.length() < k)
+			throw std::invalid_argument("Invalid dimensions in ormqr");
+		if (m == 0 || n == 0 || k == 0)
+			return;
+		LAENV laenv;
+		int nb = std::min(k, laenv(LAENV::Optimal, "ORMQR", "", m, n, k, -1));
+		LARFT<T> larft;
+		LARFB<T> larfb;
+		NUMCPP::Matrix<T> Tm(nb, nb);
+		// Q' * C and C * Q: H(1) is applied first
+		bool forward = left == trans;
+		int nblocks = (k + nb - 1) / nb;
+		for (int b = 0; b < nblocks; ++b) {
+			int i = (forward ? b : nblocks - 1 - b) * nb;
+			int ib = std::min(nb, k - i);
+			NUMCPP::FastMatrix<T> V = A.extract(i, nq - i, i, ib);
+			NUMCPP::FastMatrix<T> Tf = Tm.extract(0, ib, 0, ib);
+			larft(Direction::Forward, V, tau.extract(i, ib), Tf);
+			// H or H' is applied to C(i:m-1, 0:n-1) (left) or C(0:m-1, i:n-1) (right)
+			if (left)
+				larfb(side, trans, Direction::Forward, V, Tf, C.extract(i, m - i, 0, n));
+			else
+				larfb(side, trans, Direction::Forward, V, Tf, C.extract(0, m, i, n - i));
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef __lcpp_ormtr_h
+#define __lcpp_ormtr_h
+
+#include <stdexcept>
+#include "matrix.h"
+#include "matrix_0.h"
+#include "ormqr.h"
+
+namespace LCPP {
+	/// <summary>
+	/// Overwrites the general real m by n matrix C with
+	///   Q * C, Q' * C (left) or C * Q, C * Q' (right)
+	/// where Q is the orthogonal matrix of order nq (nq = m on the left, n on the right) determined by SYTRD
+	/// when reducing a symmetric matrix A (lower triangle) to tridiagonal form:
+	///       Q = H(0) H(1) . . . H(nq-2)
+	/// Q is the identity in its first row and column; the other rows/columns of C are updated by ORMQR,
+	/// with the reflectors stored below the first subdiagonal of A.
+	/// </summary>
+	/// <typeparam name="T"></typeparam>
+	template<typename T>
+	class ORMTR {
+	public:
+
+		ORMTR() {}
+
+		void operator()(Side side, bool trans, NUMCPP::FastMatrix<T> A, NUMCPP::Sequence<T> tau, NUMCPP::FastMatrix<T> C);
+	};
+
+	template<typename T>
+	void ORMTR<T>::operator()(Side side, bool trans, NUMCPP::FastMatrix<T> A, NUMCPP::Sequence<T> tau, NUMCPP::FastMatrix<T> C) {
+		int m = C.getNrows(), n = C.getNcols();
+		bool left = side == Side::Left;
+		int nq = left ? m : n;
+		if (!A.isSquare() || A.getNrows() != nq || tau.length() < nq - 1)
+			throw std::invalid_argument("Invalid dimensions in ormtr");
+		if (m == 0 || n == 0 || nq == 1)
+			return;
+		ORMQR<T> ormqr;
+		NUMCPP::FastMatrix<T> V = A.extract(1, nq - 1, 0, nq - 1);
+		if (left)
+			ormqr(side, trans, V, tau.left(nq - 1), C.extract(1, m - 1, 0, n));
+		else
+			ormqr(side, trans, V, tau.left(nq - 1), C.extract(0, m, 1, n - 1));
+	}
+}
+
+#endif
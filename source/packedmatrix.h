@@ -0,0 +1,139 @@
+#ifndef __numcpp_packedmatrix_h
+#define __numcpp_packedmatrix_h
+
+#include <iostream>
+#include <vector>
+#include <stdexcept>
+#include "sequence.h"
+#include "matrix.h"
+#include "matrix_0.h"
+
+namespace NUMCPP {
+
+	/// <summary>
+	/// Symmetric (or triangular) n x n matrix in packed storage: only the uplo triangle is stored,
+	/// column by column, in an array of n * (n + 1) / 2 elements (LAPACK AP format).
+	/// Upper: A(i, j) (i <= j) is stored at i + j * (j + 1) / 2
+	/// Lower: A(i, j) (i >= j) is stored at i - j + j * (2 * n - j + 1) / 2
+	/// The stored part of each column is contiguous.
+	/// </summary>
+	/// <typeparam name="T"></typeparam>
+	template<typename T>
+	class PackedMatrix
+	{
+	public:
+
+		PackedMatrix(int n, LCPP::Triangular uplo);
+
+		/// <summary>
+		/// uplo triangle of a dense square matrix (LAPACK TRTTP)
+		/// </summary>
+		PackedMatrix(const FastMatrix<T>& M, LCPP::Triangular uplo);
+
+		int getNrows() const {
+			return m_n;
+		}
+
+		int getNcols() const {
+			return m_n;
+		}
+
+		LCPP::Triangular getUplo() const {
+			return m_uplo;
+		}
+
+		/// <summary>
+		/// Position in the packed array of the element (r, c) of the stored triangle
+		/// </summary>
+		int index(int r, int c) const {
+			if (m_uplo == LCPP::Triangular::Upper)
+				return r + c * (c + 1) / 2;
+			else
+				return r - c + c * (2 * m_n - c + 1) / 2;
+		}
+
+		/// <summary>
+		/// Element (r, c) of the symmetric matrix
+		/// </summary>
+		T& operator()(int r, int c) {
+			bool stored = m_uplo == LCPP::Triangular::Upper ? r <= c : r >= c;
+			return stored ? m_data[index(r, c)] : m_data[index(c, r)];
+		}
+
+		T operator()(int r, int c) const {
+			bool stored = m_uplo == LCPP::Triangular::Upper ? r <= c : r >= c;
+			return stored ? m_data[index(r, c)] : m_data[index(c, r)];
+		}
+
+		/// <summary>
+		/// Stored part of the column col (rows 0 to col for upper, col to n-1 for lower)
+		/// </summary>
+		Sequence<T> column(int col) {
+			if (m_uplo == LCPP::Triangular::Upper)
+				return Sequence<T>(m_data.data() + index(0, col), col + 1);
+			else
+				return Sequence<T>(m_data.data() + index(col, col), m_n - col);
+		}
+
+		Sequence<T> all() {
+			return Sequence<T>(m_data.data(), (int)m_data.size());
+		}
+
+		T* ptr() {
+			return m_data.data();
+		}
+
+		const T* cptr() const {
+			return m_data.data();
+		}
+
+		/// <summary>
+		/// Dense copy (LAPACK TPTTR). If symmetric is false, the other triangle is set to 0
+		/// </summary>
+		Matrix<T> toMatrix(bool symmetric = true) const;
+
+	private:
+
+		int m_n;
+		LCPP::Triangular m_uplo;
+		std::vector<T> m_data;
+	};
+
+	template<typename T>
+	PackedMatrix<T>::PackedMatrix(int n, LCPP::Triangular uplo)
+		:m_n(n), m_uplo(uplo), m_data(n * (n + 1) / 2, NUMCPP::CONSTANTS<T>::zero) {
+		if (n < 0)
+			throw std::invalid_argument("invalid dimensions in PackedMatrix");
+	}
+
+	template<typename T>
+	PackedMatrix<T>::PackedMatrix(const FastMatrix<T>& M, LCPP::Triangular uplo)
+		:PackedMatrix(M.getNrows(), uplo) {
+		if (!M.isSquare())
+			throw std::invalid_argument("invalid dimensions in PackedMatrix");
+		for (int c = 0; c < m_n; ++c) {
+			if (uplo == LCPP::Triangular::Upper)
+				column(c).copy(M.column(c).left(c + 1));
+			else
+				column(c).copy(M.column(c).right(m_n - c));
+		}
+	}
+
+	template<typename T>
+	Matrix<T> PackedMatrix<T>::toMatrix(bool symmetric) const {
+		bool upper = m_uplo == LCPP::Triangular::Upper;
+		return Matrix<T>(m_n, m_n, [&](int r, int c) {
+			if (symmetric || (upper ? r <= c : r >= c))
+				return (*this)(r, c);
+			else
+				return NUMCPP::CONSTANTS<T>::zero;
+			});
+	}
+
+	template<typename T>
+	std::ostream& operator<< (std::ostream& stream, const PackedMatrix<T>& matrix) {
+		return stream << matrix.toMatrix();
+	}
+}
+
+#endif
@@ -0,0 +1,110 @@
+#ifndef __numcpp_parallel_h
+#define __numcpp_parallel_h
+
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <exception>
+#include <algorithm>
+
+namespace NUMCPP {
+
+	/// <summary>
+	/// Minimal fork-join support for the parallel algorithms of the library.
+	/// Work items are distributed dynamically (in increasing order) on a set of std::thread,
+	/// the calling thread taking part in the work. There is no persistent pool: each call starts and
+	/// joins its own threads, so the work items should be large (tens of microseconds at least).
+	/// The first exception thrown by a work item is rethrown in the calling thread.
+	/// </summary>
+	struct Parallel {
+
+		/// <summary>
+		/// Default number of threads (hardware concurrency unless set explicitly)
+		/// </summary>
+		static int concurrency() {
+			int n = s_concurrency.load();
+			if (n > 0)
+				return n;
+			n = (int)std::thread::hardware_concurrency();
+			return n > 0 ? n : 1;
+		}
+
+		/// <summary>
+		/// Sets the default number of threads. 0 means hardware concurrency
+		/// </summary>
+		static void setConcurrency(int n) {
+			s_concurrency = n < 0 ? 0 : n;
+		}
+
+		/// <summary>
+		/// Executes fn(i) for i in [0, n[ on at most nthreads threads (0 = default concurrency)
+		/// </summary>
+		template<class Fn>
+		static void forEach(int n, Fn fn, int nthreads = 0);
+
+		/// <summary>
+		/// Reduces the partial results fn(i), i in [0, n[ (n > 0), computed on at most nthreads threads.
+		/// The partial results are combined with op in a fixed pairwise tree
+		/// (((r0 op r1) op (r2 op r3)) op ...), so that the result does not depend on the number of threads
+		/// </summary>
+		template<class Fn, class Op>
+		static auto reduce(int n, Fn fn, Op op, int nthreads = 0);
+
+	private:
+
+		inline static std::atomic<int> s_concurrency{ 0 };
+	};
+
+	template<class Fn>
+	void Parallel::forEach(int n, Fn fn, int nthreads) {
+		if (n <= 0)
+			return;
+		if (nthreads <= 0)
+			nthreads = concurrency();
+		nthreads = std::min(nthreads, n);
+		if (nthreads == 1) {
+			for (int i = 0; i < n; ++i)
+				fn(i);
+			return;
+		}
+		std::atomic<int> next(0);
+		std::exception_ptr error;
+		std::mutex mutex;
+		auto worker = [&]() {
+			try {
+				int i;
+				while ((i = next++) < n)
+					fn(i);
+			}
+			catch (...) {
+				std::lock_guard<std::mutex> lock(mutex);
+				if (!error)
+					error = std::current_exception();
+				next = n;
+			}
+		};
+		std::vector<std::thread> threads;
+		threads.reserve(nthreads - 1);
+		for (int t = 1; t < nthreads; ++t)
+			threads.emplace_back(worker);
+		worker();
+		for (std::thread& t : threads)
+			t.join();
+		if (error)
+			std::rethrow_exception(error);
+	}
+
+	template<class Fn, class Op>
+	auto Parallel::reduce(int n, Fn fn, Op op, int nthreads) {
+		typedef decltype(fn(0)) R;
+		std::vector<R> partial(n);
+		forEach(n, [&](int i) {partial[i] = fn(i); }, nthreads);
+		for (int step = 1; step < n; step *= 2)
+			for (int i = 0; i + step < n; i += 2 * step)
+				partial[i] = op(partial[i], partial[i + step]);
+		return partial[0];
+	}
+}
+
+#endif
@@ -0,0 +1,86 @@
+#ifndef __lcpp_pbtrf_h
+#define __lcpp_pbtrf_h
+
+#include "bandmatrix.h"
+#include "matrix_0.h"
+
+namespace LCPP {
+	/// <summary>
+	/// Computes the Cholesky factorization of a real symmetric positive definite band matrix A.
+	/// The factorization has the form
+	/// A = U' * U or A = L * L', where U is an upper triangular band matrix (ku = kd super-diagonals)
+	/// and L is a lower triangular band matrix (kl = kd sub-diagonals).
+	/// Only the uplo part of the band is referenced and overwritten by the factor.
+	/// The factor has the same bandwidth as A: the work is O(n * kd^2) and no additional memory is used.
+	/// info() = 0 on success, or k > 0 if the leading minor of order k is not positive definite.
+	/// </summary>
+	/// <typeparam name="T"></typeparam>
+	template<typename T>
+	class PBTRF {
+	public:
+
+		PBTRF() :m_info(0) {}
+
+		void operator()(Triangular uplo, NUMCPP::FastBandMatrix<T> A);
+		void operator()(Triangular uplo, NUMCPP::BandMatrix<T>& A) {
+			(*this)(uplo, A.all());
+		}
+
+		int info() const {
+			return m_info;
+		}
+
+	private:
+
+		int m_info;
+	};
+
+	template<typename T>
+	void PBTRF<T>::operator()(Triangular uplo, NUMCPP::FastBandMatrix<T> A) {
+		m_info = 0;
+		int n = A.getNrows();
+		T zero = NUMCPP::CONSTANTS<T>::zero, one = NUMCPP::CONSTANTS<T>::one;
+		bool lower = uplo == Triangular::Lower;
+		int kd = lower ? A.getKl() : A.getKu();
+		for (int j = 0; j < n; ++j) {
+			T ajj = A(j, j);
+			if (ajj <= zero || ajj != ajj) {
+				m_info = j + 1;
+				return;
+			}
+			ajj = std::sqrt(ajj);
+			A(j, j) = ajj;
+			int kn = std::min(kd, n - j - 1);
+			if (kn == 0)
+				continue;
+			T r = one / ajj;
+			if (lower) {
+				// L(j+1:j+kn, j) = A(j+1:j+kn, j) / L(j,j) (contiguous)
+				T* x = &A(j + 1, j);
+				for (int i = 0; i < kn; ++i)
+					x[i] *= r;
+				// A22 = A22 - x * x', lower part, by columns
+				for (int l = 0; l < kn; ++l) {
+					T xl = -x[l];
+					T* c = &A(j + 1 + l, j + 1 + l);
+					for (int i = l; i < kn; ++i)
+						c[i - l] += xl * x[i];
+				}
+			}
+			else {
+				// U(j, j+1:j+kn) = A(j, j+1:j+kn) / U(j,j)
+				NUMCPP::Sequence<T> x(&A(j, j + 1), kn, A.getColumnIncrement() - 1);
+				x.mul(r);
+				// A22 = A22 - x' * x, upper part, by columns
+				for (int l = 0; l < kn; ++l) {
+					T xl = -x(l);
+					T* c = &A(j + 1, j + 1 + l);
+					for (int i = 0; i <= l; ++i)
+						c[i] += xl * x(i);
+				}
+			}
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,79 @@
+#ifndef __lcpp_pbtrs_h
+#define __lcpp_pbtrs_h
+
+#include <stdexcept>
+#include "bandmatrix.h"
+#include "matrix_0.h"
+#include "dot.h"
+
+namespace LCPP {
+	/// <summary>
+	/// Solves a system of linear equations A * X = B with a symmetric positive definite band matrix A
+	/// using the Cholesky factorization A = U' * U or A = L * L' computed by PBTRF.
+	/// B is overwritten by the solution. The work is O(n * kd) for each right-hand side.
+	/// </summary>
+	/// <typeparam name="T"></typeparam>
+	template<typename T>
+	class PBTRS {
+	public:
+
+		PBTRS() {}
+
+		void operator()(Triangular uplo, NUMCPP::FastBandMatrix<T> A, NUMCPP::FastMatrix<T> B);
+
+	private:
+
+		void solve(Triangular uplo, NUMCPP::FastBandMatrix<T>& A, T* b);
+	};
+
+	template<typename T>
+	void PBTRS<T>::operator()(Triangular uplo, NUMCPP::FastBandMatrix<T> A, NUMCPP::FastMatrix<T> B) {
+		if (A.getNrows() != B.getNrows())
+			throw std::invalid_argument("invalid dimensions in PBTRS");
+		NUMCPP::SequenceIterator<T> cols = B.columnsIterator();
+		while (cols.hasNext())
+			solve(uplo, A, cols.next().start());
+	}
+
+	template<typename T>
+	void PBTRS<T>::solve(Triangular uplo, NUMCPP::FastBandMatrix<T>& A, T* b) {
+		int n = A.getNrows();
+		DOT<T, T> dot;
+		if (uplo == Triangular::Lower) {
+			int kd = A.getKl();
+			// L * y = b
+			for (int j = 0; j < n; ++j) {
+				T bj = b[j] / A(j, j);
+				b[j] = bj;
+				int kn = std::min(kd, n - j - 1);
+				const T* l = &A(j + 1, j);
+				for (int i = 0; i < kn; ++i)
+					b[j + 1 + i] -= bj * l[i];
+			}
+			// L' * x = y
+			for (int j = n - 1; j >= 0; --j) {
+				int kn = std::min(kd, n - j - 1);
+				b[j] = (b[j] - dot(kn, &A(j + 1, j), b + j + 1)) / A(j, j);
+			}
+		}
+		else {
+			int kd = A.getKu();
+			// U' * y = b
+			for (int j = 0; j < n; ++j) {
+				int km = std::min(kd, j);
+				b[j] = (b[j] - dot(km, &A(j - km, j), b + j - km)) / A(j, j);
+			}
+			// U * x = y
+			for (int j = n - 1; j >= 0; --j) {
+				T bj = b[j] / A(j, j);
+				b[j] = bj;
+				int km = std::min(kd, j);
+				const T* u = &A(j - km, j);
+				for (int i = 0; i < km; ++i)
+					b[j - km + i] -= bj * u[i];
+			}
+		}
+	}
+}
+
+#endif
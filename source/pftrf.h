@@ -0,0 +1,77 @@
+#ifndef __lcpp_pftrf_h
+#define __lcpp_pftrf_h
+
+#include "rfpmatrix.h"
+#include "matrix_0.h"
+#include "syrk.h"
+#include "trsm.h"
+#include "potrf.h"
+
+namespace LCPP {
+	/// <summary>
+	/// Computes the Cholesky factorization of a real symmetric positive definite matrix A stored in
+	/// Rectangular Full Packed format (see RFPMatrix).
+	/// The factorization has the form
+	/// A = U' * U or A = L * L', where U is an upper triangular matrix and L is lower triangular.
+	/// The factor overwrites A, in the same format.
+	/// All the work is done by Level 3 routines on the blocks of the RFP storage:
+	///   Lower: T1 = L11 (POTRF), S = S * inv(L11') (TRSM), T2 = T2 - S * S' (SYRK), T2 = L22' (POTRF)
+	///   Upper: T1 = U11' (POTRF), S = inv(U11') * S (TRSM), T2 = T2 - S' * S (SYRK), T2 = U22 (POTRF)
+	/// info() = 0 on success, or k > 0 if the leading minor of order k is not positive definite.
+	/// </summary>
+	/// <typeparam name="T"></typeparam>
+	template<typename T>
+	class PFTRF {
+	public:
+
+		PFTRF(int nthreads = 0) :m_nthreads(nthreads), m_info(0) {}
+
+		void operator()(NUMCPP::RFPMatrix<T>& A);
+
+		int info() const {
+			return m_info;
+		}
+
+	private:
+
+		int m_nthreads;
+		int m_info;
+	};
+
+	template<typename T>
+	void PFTRF<T>::operator()(NUMCPP::RFPMatrix<T>& A) {
+		m_info = 0;
+		if (A.getNrows() == 0)
+			return;
+		T one = NUMCPP::CONSTANTS<T>::one;
+		bool lower = A.getUplo() == Triangular::Lower;
+		NUMCPP::FastMatrix<T> t1 = A.t1(), s = A.s(), t2 = A.t2();
+		POTRF<T> potrf(POTRF<T>::RightLooking, m_nthreads);
+		if (A.getN1() > 0) {
+			potrf(Triangular::Lower, t1);
+			if (potrf.info() != 0) {
+				m_info = potrf.info();
+				return;
+			}
+		}
+		if (A.getN2() == 0)
+			return;
+		if (A.getN1() > 0) {
+			TRSM<T> trsm;
+			SYRK<T> syrk;
+			if (lower) {
+				trsm(Side::Right, Triangular::Lower, true, false, t1, one, s);
+				syrk(Triangular::Upper, false, -one, s, one, t2);
+			}
+			else {
+				trsm(Side::Left, Triangular::Lower, false, false, t1, one, s);
+				syrk(Triangular::Upper, true, -one, s, one, t2);
+			}
+		}
+		potrf(Triangular::Upper, t2);
+		if (potrf.info() != 0)
+			m_info = potrf.info() + A.getN1();
+	}
+}
+
+#endif
@@ -0,0 +1,52 @@
+#ifndef __lcpp_posv_h
+#define __lcpp_posv_h
+
+#include "matrix.h"
+#include "matrix_0.h"
+#include "potrf.h"
+#include "potrs.h"
+
+namespace LCPP {
+	/// <summary>
+	/// Computes the solution to a real system of linear equations A * X = B,
+	/// where A is an N x N symmetric positive definite matrix and X and B are N x NRHS matrices.
+	/// The Cholesky decomposition is used to factor A as
+	/// A = U' * U or A = L * L' (POTRF). The factored form of A is then used to solve the
+	/// system of equations A * X = B (POTRS).
+	/// A is overwritten by its factor and B by the solution.
+	/// info() = 0 on success, or k > 0 if the leading minor of order k of A is not positive definite
+	/// (B is then unchanged).
+	/// </summary>
+	/// <typeparam name="T"></typeparam>
+	template<typename T>
+	class POSV {
+	public:
+
+		POSV(int nthreads = 0) :m_nthreads(nthreads), m_info(0) {}
+
+		void operator()(Triangular uplo, NUMCPP::FastMatrix<T> A, NUMCPP::FastMatrix<T> B) {
+			POTRF<T> potrf(POTRF<T>::RightLooking, m_nthreads);
+			potrf(uplo, A);
+			m_info = potrf.info();
+			if (m_info != 0)
+				return;
+			POTRS<T> potrs(m_nthreads);
+			potrs(uplo, A, B);
+		}
+
+		void operator()(Triangular uplo, NUMCPP::Matrix<T>& A, NUMCPP::Matrix<T>& B) {
+			(*this)(uplo, A.all(), B.all());
+		}
+
+		int info() const {
+			return m_info;
+		}
+
+	private:
+
+		int m_nthreads, m_info;
+	};
+
+}
+
+#endif
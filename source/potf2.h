@@ -1,6 +1,7 @@
 #ifndef __lcpp_potf2_h
 #define __lcpp_potf2_h
 
+#include <stdexcept>
 #include "matrix.h"
 #include "matrix_0.h"
 
@@ -12,17 +13,20 @@ namespace LCPP {
 	/// The factorization has the form
 	/// A = U' * U or A = L * L', where U is an upper triangular matrix and L is lower triangular.
 	/// This is the unblocked version of the algorithm.
+	/// Only the uplo triangle of A is referenced and overwritten by the factor.
+	/// info() = 0 on success, or k > 0 if the leading minor of order k is not positive definite
+	/// (the factorization could not be completed).
 	/// </summary>
 	/// <typeparam name="T"></typeparam>
 	template<typename T>
 	class POTF2 {
 	public:
 
-		POTF2() {}
+		POTF2() :m_info(0) {}
 
 		void operator()(Triangular uplo, NUMCPP::FastMatrix<T> A) {
 			if (!A.isSquare())
-				throw std::exception("Not square");
+				throw std::invalid_argument("Not square matrix in Cholesky");
 			if (Triangular::Lower == uplo)
 				lcholesky(A);
 			else
@@ -31,7 +35,7 @@ namespace LCPP {
 		void operator()(Triangular uplo, NUMCPP::Matrix<T>& A) {
 			(*this)(uplo, A.all());
 		}
-		
+
 
 		int info() const{
 			return m_info;
@@ -47,6 +51,11 @@ namespace LCPP {
 
 	};
 
+	/// <summary>
+	/// Left-looking (jki) variant: A(j:n, j) -= A(j:n, 0:j) * A(j, 0:j)'.
+	/// The update is done column by column on contiguous data (axpy form of GEMV),
+	/// the only strided access being the scalars L(j, k).
+	/// </summary>
 	template<typename T>
 	void POTF2<T>::lcholesky(NUMCPP::FastMatrix<T> A) {
 		m_info = 0;
@@ -54,37 +63,63 @@ namespace LCPP {
 			return;
 		int n = A.getNrows();
 		int lda = A.getColumnIncrement();
-		T zero = NUMCPP::CONSTANTS<T>::zero;
+		T zero = NUMCPP::CONSTANTS<T>::zero, one = NUMCPP::CONSTANTS<T>::one;
 		T* a = A.ptr();
-		if (n == 1) {
-			if (*a <= zero) {
-				m_info = -1;
-			}
-			else
-				*a = std::sqrt(*a);
-			return;
-		}
-		DOT<T> dot;
-		auto diag=A.diagonal.cbegin();
 		for (int j = 0; j < n; ++j) {
-			T* aj = a + j;
-			// L(j,j) = A(j,j)-dot(A(j,[0, j-1[)
-			T ajj = *diag-dot(j, aj, lda, aj, lda);
+			T* aj = a + j * lda;
+			T* const ajend = aj + n;
+			// A(j:n, j) -= sum(k<j) L(j,k) * L(j:n, k)
+			const T* ak = a + j;
+			for (int k = 0; k < j; ++k, ak += lda) {
+				T ljk = -*ak;
+				if (ljk != zero) {
+					const T* x = ak;
+					for (T* y = aj + j; y != ajend; ++y, ++x)
+						*y += ljk * *x;
+				}
+			}
+			T ajj = aj[j];
 			if (ajj <= zero || ajj != ajj) {
-				*diag = ajj;
-				m_info = j - n;
-				return; 
+				m_info = j + 1;
+				return;
 			}
-			ajj=std::sqrt(ajj);
-			*diag++ = ajj;
+			ajj = std::sqrt(ajj);
+			aj[j] = ajj;
+			T r = one / ajj;
+			for (T* y = aj + j + 1; y != ajend; ++y)
+				*y *= r;
 		}
-	
 	}
 
+	/// <summary>
+	/// Column (dot) variant: the j-th column of U is obtained by solving U(0:j,0:j)' * u = A(0:j, j),
+	/// so that all the inner products are computed on contiguous columns.
+	/// </summary>
 	template<typename T>
 	void POTF2<T>::ucholesky(NUMCPP::FastMatrix<T> A) {
+		m_info = 0;
 		if (A.isEmpty())
 			return;
+		int n = A.getNrows();
+		int lda = A.getColumnIncrement();
+		T zero = NUMCPP::CONSTANTS<T>::zero;
+		T* a = A.ptr();
+		DOT<T, T> dot;
+		for (int j = 0; j < n; ++j) {
+			T* aj = a + j * lda;
+			// U(i,j) = (A(i,j) - U(0:i, i)' * U(0:i, j)) / U(i,i)
+			const T* ai = a;
+			for (int i = 0; i < j; ++i, ai += lda) {
+				aj[i] = (aj[i] - dot(i, ai, aj)) / ai[i];
+			}
+			T ajj = aj[j] - dot(j, aj, aj);
+			if (ajj <= zero || ajj != ajj) {
+				aj[j] = ajj;
+				m_info = j + 1;
+				return;
+			}
+			aj[j] = std::sqrt(ajj);
+		}
 	}
 }
 
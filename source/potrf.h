@@ -1,49 +1,70 @@
 #ifndef __lcpp_potrf_h
 #define __lcpp_potrf_h
 
+#include <stdexcept>
 #include "matrix.h"
 #include "matrix_0.h"
-#include "scal.h"
-#include "gemv.h"
-#include "dot.h"
+#include "laenv.h"
+#include "parallel.h"
+#include "gemm.h"
+#include "syrk.h"
+#include "trsm.h"
+#include "potrf2.h"
 
 namespace LCPP {
 	/// <summary>
 	/// Computes the Cholesky factorization of a real symmetric positive definite matrix A.
 	/// The factorization has the form
 	/// A = U' * U or A = L * L', where U is an upper triangular matrix and L is lower triangular.
-	/// This is the block version of the algorithm.
+	/// This is the block version of the algorithm. The block size is given by LAENV; the diagonal
+	/// blocks are factorized by POTRF2.
+	/// The right-looking variant updates the whole trailing matrix after each panel (SYRK + GEMM by column blocks),
+	/// the left-looking variant updates only the current panel with the previous ones (SYRK + GEMM + TRSM).
+	/// In both cases, the independent block operations are executed in parallel (nthreads = 0 means default concurrency).
+	/// info() = 0 on success, or k > 0 if the leading minor of order k is not positive definite.
 	/// </summary>
 	/// <typeparam name="T"></typeparam>
 	template<typename T>
 	class POTRF {
 	public:
 
-		POTRF() {}
+		enum Algorithm {
+			LeftLooking, RightLooking
+		};
 
-		void operator()(Triangular uplo, NUMCPP::FastMatrix<T>& A);
+		POTRF(Algorithm algorithm = Algorithm::RightLooking, int nthreads = 0)
+			:m_algorithm(algorithm), m_nthreads(nthreads), m_info(0) {}
+
+		void operator()(Triangular uplo, NUMCPP::FastMatrix<T> A);
 		void operator()(Triangular uplo, NUMCPP::Matrix<T>& A) {
-			FastMatrix<T>a = A.all();
-			(*this)(uplo, a);
+			(*this)(uplo, A.all());
 		}
 
 		int info() const {
 			return m_info;
 		}
 
-		void lcholesky(NUMCPP::FastMatrix<T>& A);
-		void ucholesky(NUMCPP::FastMatrix<T>& A);
+		void lcholesky(NUMCPP::FastMatrix<T> A);
+		void ucholesky(NUMCPP::FastMatrix<T> A);
 
 	private:
 
+		int blockSize(int n);
+
+		// factorization of the diagonal block starting at j. Returns false in case of failure
+		bool diagonal(Triangular uplo, NUMCPP::FastMatrix<T> A, int j, int jb);
+
+		Algorithm m_algorithm;
+		int m_nthreads;
 		int m_info;
 
 	};
 
 	template<typename T>
-	void POTRF<T>::operator()(Triangular uplo, NUMCPP::FastMatrix<T>& A) {
+	void POTRF<T>::operator()(Triangular uplo, NUMCPP::FastMatrix<T> A) {
 		if (!A.isSquare())
-			throw std::exception("Not square matrix in Cholesky");
+			throw std::invalid_argument("Not square matrix in Cholesky");
+		m_info = 0;
 		if (A.isEmpty())
 			return;
 		if (uplo == Triangular::Lower)
@@ -53,14 +74,142 @@ namespace LCPP {
 	}
 
 	template<typename T>
-	void POTRF<T>::lcholesky(NUMCPP::FastMatrix<T>& A) {
-		m_info = 0;
+	int POTRF<T>::blockSize(int n) {
+		LAENV laenv;
+		return laenv(LAENV::Optimal, "POTRF", "", n, -1, -1, -1);
+	}
+
+	template<typename T>
+	bool POTRF<T>::diagonal(Triangular uplo, NUMCPP::FastMatrix<T> A, int j, int jb) {
+		POTRF2<T> potrf2;
+		potrf2(uplo, A.extract(j, jb, j, jb));
+		if (potrf2.info() != 0) {
+			m_info = potrf2.info() + j;
+			return false;
+		}
+		return true;
+	}
 
+	template<typename T>
+	void POTRF<T>::lcholesky(NUMCPP::FastMatrix<T> A) {
+		m_info = 0;
+		int n = A.getNrows();
+		int nb = blockSize(n);
+		if (nb <= 1 || nb >= n) {
+			POTRF2<T> potrf2;
+			potrf2(Triangular::Lower, A);
+			m_info = potrf2.info();
+			return;
+		}
+		T one = NUMCPP::CONSTANTS<T>::one;
+		int lda = A.getColumnIncrement();
+		T* a = A.ptr();
+		for (int j = 0; j < n; j += nb) {
+			int jb = std::min(nb, n - j);
+			int j2 = j + jb, m2 = n - j2;
+			// number of row/column blocks below/right of the diagonal block
+			int nblocks = (m2 + nb - 1) / nb;
+			if (m_algorithm == Algorithm::LeftLooking) {
+				// A11 = A11 - A10 * A10'
+				SYRK<T> syrk;
+				syrk(Triangular::Lower, false, jb, j, -one, a + j, lda, one, a + j * (lda + 1), lda);
+				if (!diagonal(Triangular::Lower, A, j, jb))
+					return;
+				// A21 = (A21 - A20 * A10') * inv(L11'), by independent row blocks
+				NUMCPP::Parallel::forEach(nblocks, [&](int b) {
+					int r0 = j2 + b * nb, rb = std::min(nb, n - r0);
+					GEMM<T> gemm;
+					gemm(false, true, rb, jb, j, -one, a + r0, lda, a + j, lda, one, a + r0 + j * lda, lda);
+					TRSM<T> trsm;
+					trsm(Side::Right, Triangular::Lower, true, false, A.extract(j, jb, j, jb), one, A.extract(r0, rb, j, jb));
+					}, m_nthreads);
+			}
+			else {
+				if (!diagonal(Triangular::Lower, A, j, jb))
+					return;
+				if (m2 == 0)
+					break;
+				// A21 = A21 * inv(L11'), by independent row blocks
+				NUMCPP::Parallel::forEach(nblocks, [&](int b) {
+					int r0 = j2 + b * nb, rb = std::min(nb, n - r0);
+					TRSM<T> trsm;
+					trsm(Side::Right, Triangular::Lower, true, false, A.extract(j, jb, j, jb), one, A.extract(r0, rb, j, jb));
+					}, m_nthreads);
+				// A22 = A22 - A21 * A21', by column blocks of A22
+				NUMCPP::Parallel::forEach(nblocks, [&](int b) {
+					int c0 = j2 + b * nb, cb = std::min(nb, n - c0);
+					const T* l = a + j * lda;
+					T* c = a + c0 * (lda + 1);
+					SYRK<T> syrk;
+					syrk(Triangular::Lower, false, cb, jb, -one, l + c0, lda, one, c, lda);
+					int rb = n - c0 - cb;
+					if (rb > 0) {
+						GEMM<T> gemm;
+						gemm(false, true, rb, cb, jb, -one, l + c0 + cb, lda, l + c0, lda, one, c + cb, lda);
+					}
+					}, m_nthreads);
+			}
+		}
 	}
 
 	template<typename T>
-	void POTRF<T>::ucholesky(NUMCPP::FastMatrix<T>& A) {
+	void POTRF<T>::ucholesky(NUMCPP::FastMatrix<T> A) {
 		m_info = 0;
+		int n = A.getNrows();
+		int nb = blockSize(n);
+		if (nb <= 1 || nb >= n) {
+			POTRF2<T> potrf2;
+			potrf2(Triangular::Upper, A);
+			m_info = potrf2.info();
+			return;
+		}
+		T one = NUMCPP::CONSTANTS<T>::one;
+		int lda = A.getColumnIncrement();
+		T* a = A.ptr();
+		for (int j = 0; j < n; j += nb) {
+			int jb = std::min(nb, n - j);
+			int j2 = j + jb, m2 = n - j2;
+			int nblocks = (m2 + nb - 1) / nb;
+			if (m_algorithm == Algorithm::LeftLooking) {
+				// A11 = A11 - A01' * A01
+				SYRK<T> syrk;
+				syrk(Triangular::Upper, true, jb, j, -one, a + j * lda, lda, one, a + j * (lda + 1), lda);
+				if (!diagonal(Triangular::Upper, A, j, jb))
+					return;
+				// A12 = inv(U11') * (A12 - A01' * A02), by independent column blocks
+				NUMCPP::Parallel::forEach(nblocks, [&](int b) {
+					int c0 = j2 + b * nb, cb = std::min(nb, n - c0);
+					GEMM<T> gemm;
+					gemm(true, false, jb, cb, j, -one, a + j * lda, lda, a + c0 * lda, lda, one, a + j + c0 * lda, lda);
+					TRSM<T> trsm;
+					trsm(Side::Left, Triangular::Upper, true, false, A.extract(j, jb, j, jb), one, A.extract(j, jb, c0, cb));
+					}, m_nthreads);
+			}
+			else {
+				if (!diagonal(Triangular::Upper, A, j, jb))
+					return;
+				if (m2 == 0)
+					break;
+				// A12 = inv(U11') * A12, by independent column blocks
+				NUMCPP::Parallel::forEach(nblocks, [&](int b) {
+					int c0 = j2 + b * nb, cb = std::min(nb, n - c0);
+					TRSM<T> trsm;
+					trsm(Side::Left, Triangular::Upper, true, false, A.extract(j, jb, j, jb), one, A.extract(j, jb, c0, cb));
+					}, m_nthreads);
+				// A22 = A22 - A12' * A12, by column blocks of A22
+				NUMCPP::Parallel::forEach(nblocks, [&](int b) {
+					int c0 = j2 + b * nb, cb = std::min(nb, n - c0);
+					const T* u = a + j;
+					SYRK<T> syrk;
+					syrk(Triangular::Upper, true, cb, jb, -one, u + c0 * lda, lda, one, a + c0 * (lda + 1), lda);
+					int rb = c0 - j2;
+					if (rb > 0) {
+						GEMM<T> gemm;
+						gemm(true, false, rb, cb, jb, -one, u + j2 * lda, lda, u + c0 * lda, lda, one, a + j2 + c0 * lda, lda);
+					}
+					}, m_nthreads);
+			}
+		}
 	}
 
 }
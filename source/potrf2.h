@@ -1,8 +1,12 @@
 #ifndef __lcpp_potrf2_h
 #define __lcpp_potrf2_h
 
+#include <stdexcept>
 #include "matrix.h"
 #include "matrix_0.h"
+#include "potf2.h"
+#include "trsm.h"
+#include "syrk.h"
 
 namespace LCPP {
 	/// <summary>
@@ -13,20 +17,22 @@ namespace LCPP {
 	///     [A11|A12]  where A11 is n1 by n1 and A22 is n2 by n2
 	/// A = [---|---]  with n1 = n / 2
 	///     [A21|A22]       n2 = n - n1
-	/// 
-	/// The subroutine calls itself to factor A11, update and scale A21 or A12, 
+	///
+	/// The subroutine calls itself to factor A11, update and scale A21 or A12,
 	/// update A22 then calls itself to factor A22.
+	/// Small diagonal blocks are handled by the unblocked code (POTF2).
+	/// info() = 0 on success, or k > 0 if the leading minor of order k is not positive definite.
+	/// </summary>
 	/// <typeparam name="T"></typeparam>
 	template<typename T>
 	class POTRF2 {
 	public:
 
-		POTRF2() {}
+		POTRF2() :m_info(0) {}
 
-		void operator()(Triangular uplo, NUMCPP::FastMatrix<T>& A);
+		void operator()(Triangular uplo, NUMCPP::FastMatrix<T> A);
 		void operator()(Triangular uplo, NUMCPP::Matrix<T>& A) {
-			FastMatrix<T>a = A.all();
-			(*this)(uplo, a);
+			(*this)(uplo, A.all());
 		}
 
 
@@ -36,13 +42,58 @@ namespace LCPP {
 
 	private:
 
+		static const int BLOCKSIZE = 16;
+
+		int apply(Triangular uplo, NUMCPP::FastMatrix<T> A);
+
 		int m_info;
 
 	};
 
 	template<typename T>
-	void POTRF2<T>::operator()(Triangular uplo, NUMCPP::FastMatrix<T>& A) {
+	void POTRF2<T>::operator()(Triangular uplo, NUMCPP::FastMatrix<T> A) {
+		if (!A.isSquare())
+			throw std::invalid_argument("Not square matrix in Cholesky");
+		m_info = 0;
+		if (A.isEmpty())
+			return;
+		m_info = apply(uplo, A);
+	}
 
+	template<typename T>
+	int POTRF2<T>::apply(Triangular uplo, NUMCPP::FastMatrix<T> A) {
+		int n = A.getNrows();
+		if (n <= BLOCKSIZE) {
+			POTF2<T> potf2;
+			potf2(uplo, A);
+			return potf2.info();
+		}
+		int n1 = n / 2, n2 = n - n1;
+		NUMCPP::FastMatrix<T> A11 = A.topLeft(n1, n1), A22 = A.extract(n1, n2, n1, n2);
+		// Factor A11
+		int info = apply(uplo, A11);
+		if (info != 0)
+			return info;
+		TRSM<T> trsm;
+		SYRK<T> syrk;
+		T one = NUMCPP::CONSTANTS<T>::one;
+		if (uplo == Triangular::Lower) {
+			// A21 = A21 * inv(L11')
+			NUMCPP::FastMatrix<T> A21 = A.extract(n1, n2, 0, n1);
+			trsm(Side::Right, Triangular::Lower, true, false, A11, one, A21);
+			// A22 = A22 - A21 * A21'
+			syrk(Triangular::Lower, false, -one, A21, one, A22);
+		}
+		else {
+			// A12 = inv(U11') * A12
+			NUMCPP::FastMatrix<T> A12 = A.extract(0, n1, n1, n2);
+			trsm(Side::Left, Triangular::Upper, true, false, A11, one, A12);
+			// A22 = A22 - A12' * A12
+			syrk(Triangular::Upper, true, -one, A12, one, A22);
+		}
+		// Factor A22
+		info = apply(uplo, A22);
+		return info == 0 ? 0 : info + n1;
 	}
 
 
@@ -0,0 +1,65 @@
+#ifndef __lcpp_potrs_h
+#define __lcpp_potrs_h
+
+#include <stdexcept>
+#include "matrix.h"
+#include "matrix_0.h"
+#include "parallel.h"
+#include "trsm.h"
+
+namespace LCPP {
+	/// <summary>
+	/// Solves a system of linear equations A * X = B with a symmetric positive definite matrix A
+	/// using the Cholesky factorization A = U' * U or A = L * L' computed by POTRF, POTRF2, POTF2 or TPOTRF.
+	/// The solution is obtained by two (blocked) triangular solves and overwrites B.
+	/// The right-hand sides are processed by independent panels of columns, in parallel
+	/// (nthreads = 0 means default concurrency, 1 means sequential).
+	/// </summary>
+	/// <typeparam name="T"></typeparam>
+	template<typename T>
+	class POTRS {
+	public:
+
+		POTRS(int nthreads = 0) :m_nthreads(nthreads) {}
+
+		void operator()(Triangular uplo, NUMCPP::FastMatrix<T> A, NUMCPP::FastMatrix<T> B);
+		void operator()(Triangular uplo, NUMCPP::Matrix<T>& A, NUMCPP::Matrix<T>& B) {
+			(*this)(uplo, A.all(), B.all());
+		}
+
+	private:
+
+		static constexpr int PANEL = 32;
+
+		int m_nthreads;
+	};
+
+	template<typename T>
+	void POTRS<T>::operator()(Triangular uplo, NUMCPP::FastMatrix<T> A, NUMCPP::FastMatrix<T> B) {
+		if (!A.isSquare() || A.getNrows() != B.getNrows())
+			throw std::invalid_argument("invalid dimensions in POTRS");
+		if (B.isEmpty())
+			return;
+		int n = B.getNrows(), nrhs = B.getNcols();
+		T one = NUMCPP::CONSTANTS<T>::one;
+		int npanels = (nrhs + PANEL - 1) / PANEL;
+		NUMCPP::Parallel::forEach(npanels, [&](int p) {
+			int c0 = p * PANEL, nc = std::min(PANEL, nrhs - c0);
+			NUMCPP::FastMatrix<T> X = B.extract(0, n, c0, nc);
+			TRSM<T> trsm;
+			if (uplo == Triangular::Lower) {
+				// L * Y = B, L' * X = Y
+				trsm(Side::Left, Triangular::Lower, false, false, A, one, X);
+				trsm(Side::Left, Triangular::Lower, true, false, A, one, X);
+			}
+			else {
+				// U' * Y = B, U * X = Y
+				trsm(Side::Left, Triangular::Upper, true, false, A, one, X);
+				trsm(Side::Left, Triangular::Upper, false, false, A, one, X);
+			}
+			}, m_nthreads);
+	}
+
+}
+
+#endif
@@ -0,0 +1,99 @@
+#ifndef __lcpp_pptrf_h
+#define __lcpp_pptrf_h
+
+#include <cmath>
+#include "packedmatrix.h"
+#include "matrix_0.h"
+#include "dot.h"
+
+namespace LCPP {
+	/// <summary>
+	/// Computes the Cholesky factorization of a real symmetric positive definite matrix A stored in packed format.
+	/// The factorization has the form
+	/// A = U' * U or A = L * L', where U is an upper triangular matrix and L is lower triangular.
+	/// The factor overwrites A, in the same packed format.
+	/// Upper: each column of U is computed by a forward substitution with the previous (contiguous) columns.
+	/// Lower: each column of L is scaled, then used for a rank-1 update of the trailing (contiguous) columns.
+	/// info() = 0 on success, or k > 0 if the leading minor of order k is not positive definite.
+	/// </summary>
+	/// <typeparam name="T"></typeparam>
+	template<typename T>
+	class PPTRF {
+	public:
+
+		PPTRF() :m_info(0) {}
+
+		void operator()(NUMCPP::PackedMatrix<T>& A);
+
+		int info() const {
+			return m_info;
+		}
+
+	private:
+
+		int lcholesky(NUMCPP::PackedMatrix<T>& A);
+		int ucholesky(NUMCPP::PackedMatrix<T>& A);
+
+		int m_info;
+	};
+
+	template<typename T>
+	void PPTRF<T>::operator()(NUMCPP::PackedMatrix<T>& A) {
+		if (A.getUplo() == Triangular::Lower)
+			m_info = lcholesky(A);
+		else
+			m_info = ucholesky(A);
+	}
+
+	template<typename T>
+	int PPTRF<T>::ucholesky(NUMCPP::PackedMatrix<T>& A) {
+		int n = A.getNrows();
+		T zero = NUMCPP::CONSTANTS<T>::zero;
+		T* ap = A.ptr();
+		DOT<T, T> dot;
+		for (int j = 0, jc = 0; j < n; jc += ++j) {
+			// jc: start of the column j
+			T* x = ap + jc;
+			// solve U(0:j-1, 0:j-1)' * x = A(0:j-1, j)
+			for (int i = 0, ic = 0; i < j; ic += ++i)
+				x[i] = (x[i] - dot(i, ap + ic, x)) / ap[ic + i];
+			T ajj = x[j] - dot(j, x, x);
+			if (ajj <= zero || ajj != ajj) {
+				x[j] = ajj;
+				return j + 1;
+			}
+			x[j] = std::sqrt(ajj);
+		}
+		return 0;
+	}
+
+	template<typename T>
+	int PPTRF<T>::lcholesky(NUMCPP::PackedMatrix<T>& A) {
+		int n = A.getNrows();
+		T zero = NUMCPP::CONSTANTS<T>::zero, one = NUMCPP::CONSTANTS<T>::one;
+		T* ap = A.ptr();
+		for (int j = 0, jj = 0; j < n; jj += n - j++) {
+			// jj: position of A(j, j)
+			T ajj = ap[jj];
+			if (ajj <= zero || ajj != ajj)
+				return j + 1;
+			ajj = std::sqrt(ajj);
+			ap[jj] = ajj;
+			int m = n - j - 1;
+			T* x = ap + jj + 1;
+			T r = one / ajj;
+			for (int i = 0; i < m; ++i)
+				x[i] *= r;
+			// A(j+1:n, j+1:n) -= x * x' (lower part, column by column)
+			T* c = x + m;
+			for (int k = 0; k < m; c += m - k++) {
+				T xk = x[k];
+				for (int i = k; i < m; ++i)
+					c[i - k] -= xk * x[i];
+			}
+		}
+		return 0;
+	}
+}
+
+#endif
@@ -0,0 +1,179 @@
+#ifndef __numcpp_random_h
+#define __numcpp_random_h
+
+#include <cstdint>
+#include <cmath>
+#include <atomic>
+#include "sequence.h"
+#include "parallel.h"
+
+namespace NUMCPP {
+
+    /// <summary>
+    /// Counter-based random generator Philox4x32-10 (Salmon, Moraes, Dror, Shaw, 2011).
+    /// The i-th variate of a stream is a pure function of (seed, stream, i): the sequences are filled
+    /// in chunks, on several threads, and the output does not depend on the number of threads.
+    /// Each block of 4 x 32 bits gives two uniform doubles (53 bits) or two normal variates (Box-Muller).
+    /// </summary>
+    struct Random {
+
+        Random(uint64_t seed, uint64_t stream = 0) :m_seed(seed), m_stream(stream) {}
+
+        /// <summary>
+        /// x(i) = a + (b - a) * u(i), u uniform in [0, 1[
+        /// </summary>
+        void uniform(Sequence<double> x, double a = 0, double b = 1, int nthreads = 0)const;
+
+        /// <summary>
+        /// x(i) = mu + sigma * z(i), z standard normal
+        /// </summary>
+        void normal(Sequence<double> x, double mu = 0, double sigma = 1, int nthreads = 0)const;
+
+        /// <summary>
+        /// Philox4x32-10 block for a 128 bits counter (c[0] = low word) and a 64 bits key
+        /// </summary>
+        static void block(const uint32_t c[4], uint64_t key, uint32_t out[4]);
+
+        /// <summary>
+        /// Default generator: each call gives a new stream of the default seed, so that a program
+        /// produces the same numbers from one run to the next
+        /// </summary>
+        static Random next() {
+            return Random(s_seed.load(), s_stream++);
+        }
+
+        /// <summary>
+        /// Sets the default seed and restarts the default streams
+        /// </summary>
+        static void setSeed(uint64_t seed) {
+            s_seed = seed;
+            s_stream = 0;
+        }
+
+        /// <summary>
+        /// Number of items generated by a single task
+        /// </summary>
+        static constexpr int CHUNK = 1 << 14;
+
+    private:
+
+        // number of blocks computed together (independent lanes)
+        static constexpr int BATCH = 16;
+
+        // fills the items [i0, i0 + n[ of x; fn(out, y0, y1) maps the 4 words of a block on two variates
+        template <class Fn>
+        void fill(Sequence<double> x, int i0, int n, Fn fn)const;
+
+        template <class Fn>
+        void fill(Sequence<double> x, int nthreads, Fn fn)const;
+
+        static double toUniform(uint32_t hi, uint32_t lo) {
+            // 53 random bits in [0, 1[
+            return (double)((((uint64_t)hi << 32) | lo) >> 11) * (1.0 / 9007199254740992.0);
+        }
+
+        uint64_t m_seed, m_stream;
+
+        inline static std::atomic<uint64_t> s_seed{ 0x853c49e6748fea9bull };
+        inline static std::atomic<uint64_t> s_stream{ 0 };
+    };
+
+    inline void Random::block(const uint32_t c[4], uint64_t key, uint32_t out[4]) {
+        const uint64_t M0 = 0xD2511F53, M1 = 0xCD9E8D57;
+        uint32_t x0 = c[0], x1 = c[1], x2 = c[2], x3 = c[3];
+        uint32_t k0 = (uint32_t)key, k1 = (uint32_t)(key >> 32);
+        for (int r = 0; r < 10; ++r) {
+            uint64_t p0 = M0 * x0, p1 = M1 * x2;
+            uint32_t y0 = (uint32_t)(p1 >> 32) ^ x1 ^ k0, y2 = (uint32_t)(p0 >> 32) ^ x3 ^ k1;
+            x0 = y0;
+            x1 = (uint32_t)p1;
+            x2 = y2;
+            x3 = (uint32_t)p0;
+            k0 += 0x9E3779B9;
+            k1 += 0xBB67AE85;
+        }
+        out[0] = x0;
+        out[1] = x1;
+        out[2] = x2;
+        out[3] = x3;
+    }
+
+    template <class Fn>
+    void Random::fill(Sequence<double> x, int i0, int n, Fn fn)const {
+        const uint64_t M0 = 0xD2511F53, M1 = 0xCD9E8D57;
+        // counter: (block index, stream); i0 is even
+        uint64_t b0 = (uint64_t)(i0 / 2);
+        int nblocks = (n + 1) / 2;
+        uint32_t s0 = (uint32_t)m_stream, s1 = (uint32_t)(m_stream >> 32);
+        uint32_t x0[BATCH], x1[BATCH], x2[BATCH], x3[BATCH];
+        for (int j0 = 0; j0 < nblocks; j0 += BATCH) {
+            int nb = std::min(BATCH, nblocks - j0);
+            for (int j = 0; j < BATCH; ++j) {
+                uint64_t b = b0 + j0 + j;
+                x0[j] = (uint32_t)b;
+                x1[j] = (uint32_t)(b >> 32);
+                x2[j] = s0;
+                x3[j] = s1;
+            }
+            // the rounds of block, on BATCH independent counters (vectorizable)
+            uint32_t k0 = (uint32_t)m_seed, k1 = (uint32_t)(m_seed >> 32);
+            for (int r = 0; r < 10; ++r) {
+                for (int j = 0; j < BATCH; ++j) {
+                    uint64_t p0 = M0 * x0[j], p1 = M1 * x2[j];
+                    uint32_t y0 = (uint32_t)(p1 >> 32) ^ x1[j] ^ k0, y2 = (uint32_t)(p0 >> 32) ^ x3[j] ^ k1;
+                    x0[j] = y0;
+                    x1[j] = (uint32_t)p1;
+                    x2[j] = y2;
+                    x3[j] = (uint32_t)p0;
+                }
+                k0 += 0x9E3779B9;
+                k1 += 0xBB67AE85;
+            }
+            for (int j = 0; j < nb; ++j) {
+                uint32_t out[4] = { x0[j], x1[j], x2[j], x3[j] };
+                double y0, y1;
+                fn(out, y0, y1);
+                int i = 2 * (j0 + j);
+                x(i0 + i) = y0;
+                if (i + 1 < n)
+                    x(i0 + i + 1) = y1;
+            }
+        }
+    }
+
+    template <class Fn>
+    void Random::fill(Sequence<double> x, int nthreads, Fn fn)const {
+        int n = x.length();
+        int nchunks = (n + CHUNK - 1) / CHUNK;
+        Parallel::forEach(nchunks, [&](int k) {
+            int i0 = k * CHUNK;
+            fill(x, i0, std::min(CHUNK, n - i0), fn);
+            }, nthreads);
+    }
+
+    inline void Random::uniform(Sequence<double> x, double a, double b, int nthreads)const {
+        double del = b - a;
+        fill(x, nthreads, [a, del](const uint32_t w[4], double& y0, double& y1) {
+            y0 = a + del * toUniform(w[0], w[1]);
+            y1 = a + del * toUniform(w[2], w[3]);
+            });
+    }
+
+    inline void Random::normal(Sequence<double> x, double mu, double sigma, int nthreads)const {
+        const double twopi = 6.283185307179586476925;
+        fill(x, nthreads, [mu, sigma, twopi](const uint32_t w[4], double& y0, double& y1) {
+            // u1 in ]0, 1]
+            double u1 = 1 - toUniform(w[0], w[1]), u2 = toUniform(w[2], w[3]);
+            double r = sigma * std::sqrt(-2 * std::log(u1)), t = twopi * u2;
+            y0 = mu + r * std::cos(t);
+            y1 = mu + r * std::sin(t);
+            });
+    }
+
+    template<>
+    inline void Sequence<double>::rand() const {
+        Random::next().uniform(*this);
+    }
+}
+
+#endif
@@ -0,0 +1,234 @@
+#ifndef __numcpp_rfpmatrix_h
+#define __numcpp_rfpmatrix_h
+
+#include <iostream>
+#include <stdexcept>
+#include "sequence.h"
+#include "matrix.h"
+#include "matrix_0.h"
+#include "packedmatrix.h"
+
+namespace NUMCPP {
+
+	/// <summary>
+	/// Symmetric (or triangular) n x n matrix in Rectangular Full Packed format (LAPACK RFP, TRANSR = 'N').
+	/// The uplo triangle is split in two triangles T1 (n1 x n1), T2 (n2 x n2) and a rectangle S,
+	/// which are stored in a full rectangular array of n * (n + 1) / 2 elements:
+	///   Lower: A = [T1 0; S T2], n1 = n - n/2, n2 = n/2; T1 is stored as lower, T2 as upper (transposed)
+	///   Upper: A = [T1 S; 0 T2], n1 = n/2, n2 = n - n/2; T1 is stored as lower (transposed), T2 as upper
+	/// The storage is (n+1) x (n/2) when n is even, n x ((n+1)/2) when n is odd.
+	/// Each block is an ordinary FastMatrix view on the storage, so that Level 3 kernels (GEMM, TRSM, SYRK...)
+	/// can be applied directly on them.
+	/// </summary>
+	/// <typeparam name="T"></typeparam>
+	template<typename T>
+	class RFPMatrix
+	{
+	public:
+
+		RFPMatrix(int n, LCPP::Triangular uplo);
+
+		/// <summary>
+		/// uplo triangle of a dense square matrix (LAPACK TRTTF)
+		/// </summary>
+		RFPMatrix(const FastMatrix<T>& M, LCPP::Triangular uplo);
+
+		/// <summary>
+		/// Conversion from the packed format (LAPACK TPTTF)
+		/// </summary>
+		RFPMatrix(const PackedMatrix<T>& M);
+
+		int getNrows() const {
+			return m_n;
+		}
+
+		int getNcols() const {
+			return m_n;
+		}
+
+		LCPP::Triangular getUplo() const {
+			return m_uplo;
+		}
+
+		int getN1() const {
+			return m_n1;
+		}
+
+		int getN2() const {
+			return m_n2;
+		}
+
+		/// <summary>
+		/// First diagonal block (n1 x n1). Always stored as a lower triangle (A11 for lower, A11' for upper)
+		/// </summary>
+		FastMatrix<T> t1() const {
+			return m_storage.extract(m_r1, m_n1, 0, m_n1);
+		}
+
+		/// <summary>
+		/// Off-diagonal block: A21 (n2 x n1) for lower, A12 (n1 x n2) for upper
+		/// </summary>
+		FastMatrix<T> s() const {
+			if (m_uplo == LCPP::Triangular::Lower)
+				return m_storage.extract(m_rs, m_n2, 0, m_n1);
+			else
+				return m_storage.extract(m_rs, m_n1, 0, m_n2);
+		}
+
+		/// <summary>
+		/// Second diagonal block (n2 x n2). Always stored as an upper triangle (A22' for lower, A22 for upper)
+		/// </summary>
+		FastMatrix<T> t2() const {
+			return m_storage.extract(m_r2, m_n2, m_c2, m_n2);
+		}
+
+		/// <summary>
+		/// The rectangular storage
+		/// </summary>
+		FastMatrix<T> storage() const {
+			return m_storage.all();
+		}
+
+		/// <summary>
+		/// Element (r, c) of the symmetric matrix
+		/// </summary>
+		T& operator()(int r, int c) const;
+
+		/// <summary>
+		/// Dense copy (LAPACK TFTTR). If symmetric is false, the other triangle is set to 0
+		/// </summary>
+		Matrix<T> toMatrix(bool symmetric = true) const;
+
+		/// <summary>
+		/// Conversion to the packed format (LAPACK TFTTP)
+		/// </summary>
+		PackedMatrix<T> toPacked() const;
+
+	private:
+
+		int m_n, m_n1, m_n2;
+		LCPP::Triangular m_uplo;
+		// first row of T1, of S, first row/column of T2
+		int m_r1, m_rs, m_r2, m_c2;
+		Matrix<T> m_storage;
+	};
+
+	template<typename T>
+	RFPMatrix<T>::RFPMatrix(int n, LCPP::Triangular uplo)
+		:m_n(n), m_uplo(uplo),
+		m_storage(n % 2 == 0 ? n + 1 : n, n % 2 == 0 ? n / 2 : (n + 1) / 2)
+	{
+		if (n < 0)
+			throw std::invalid_argument("invalid dimensions in RFPMatrix");
+		bool even = n % 2 == 0;
+		int k = n / 2;
+		m_c2 = 0;
+		if (uplo == LCPP::Triangular::Lower) {
+			m_n2 = k;
+			m_n1 = n - k;
+			if (even) {
+				m_r1 = 1;
+				m_rs = k + 1;
+				m_r2 = 0;
+			}
+			else {
+				m_r1 = 0;
+				m_rs = m_n1;
+				m_r2 = 0;
+				m_c2 = 1;
+			}
+		}
+		else {
+			m_n1 = k;
+			m_n2 = n - k;
+			m_rs = 0;
+			if (even) {
+				m_r1 = k + 1;
+				m_r2 = k;
+			}
+			else {
+				m_r1 = m_n2;
+				m_r2 = m_n1;
+			}
+		}
+		m_storage = NUMCPP::CONSTANTS<T>::zero;
+	}
+
+	template<typename T>
+	RFPMatrix<T>::RFPMatrix(const FastMatrix<T>& M, LCPP::Triangular uplo)
+		:RFPMatrix(M.getNrows(), uplo) {
+		if (!M.isSquare())
+			throw std::invalid_argument("invalid dimensions in RFPMatrix");
+		bool lower = uplo == LCPP::Triangular::Lower;
+		for (int c = 0; c < m_n; ++c) {
+			int r0 = lower ? c : 0, r1 = lower ? m_n : c + 1;
+			for (int r = r0; r < r1; ++r)
+				(*this)(r, c) = M(r, c);
+		}
+	}
+
+	template<typename T>
+	RFPMatrix<T>::RFPMatrix(const PackedMatrix<T>& M)
+		:RFPMatrix(M.getNrows(), M.getUplo()) {
+		bool lower = m_uplo == LCPP::Triangular::Lower;
+		for (int c = 0; c < m_n; ++c) {
+			int r0 = lower ? c : 0, r1 = lower ? m_n : c + 1;
+			for (int r = r0; r < r1; ++r)
+				(*this)(r, c) = M(r, c);
+		}
+	}
+
+	template<typename T>
+	T& RFPMatrix<T>::operator()(int r, int c) const {
+		if (m_uplo == LCPP::Triangular::Lower) {
+			if (r < c)
+				std::swap(r, c);
+			if (r < m_n1)
+				return m_storage(m_r1 + r, c);
+			else if (c < m_n1)
+				return m_storage(m_rs + r - m_n1, c);
+			else
+				return m_storage(m_r2 + c - m_n1, m_c2 + r - m_n1);
+		}
+		else {
+			if (r > c)
+				std::swap(r, c);
+			if (c < m_n1)
+				return m_storage(m_r1 + c, r);
+			else if (r < m_n1)
+				return m_storage(m_rs + r, c - m_n1);
+			else
+				return m_storage(m_r2 + r - m_n1, c - m_n1);
+		}
+	}
+
+	template<typename T>
+	Matrix<T> RFPMatrix<T>::toMatrix(bool symmetric) const {
+		bool upper = m_uplo == LCPP::Triangular::Upper;
+		return Matrix<T>(m_n, m_n, [&](int r, int c) {
+			if (symmetric || (upper ? r <= c : r >= c))
+				return (*this)(r, c);
+			else
+				return NUMCPP::CONSTANTS<T>::zero;
+			});
+	}
+
+	template<typename T>
+	PackedMatrix<T> RFPMatrix<T>::toPacked() const {
+		PackedMatrix<T> P(m_n, m_uplo);
+		bool lower = m_uplo == LCPP::Triangular::Lower;
+		for (int c = 0; c < m_n; ++c) {
+			int r0 = lower ? c : 0, r1 = lower ? m_n : c + 1;
+			for (int r = r0; r < r1; ++r)
+				P(r, c) = (*this)(r, c);
+		}
+		return P;
+	}
+
+	template<typename T>
+	std::ostream& operator<< (std::ostream& stream, const RFPMatrix<T>& matrix) {
+		return stream << matrix.toMatrix();
+	}
+}
+
+#endif
@@ -5,7 +5,7 @@
 
 namespace LCPP {
 
-    // ROT applies a plane rotation.
+    // ROT applies a plane rotation: x = c * x + s * y, y = c * y - s * x.
     template <typename T>
     class ROT {
     public:
@@ -13,23 +13,37 @@ namespace LCPP {
         ROT() {}
 
         void operator()(int n, T* X, T* Y, T c, T s) {
-            apply(n, X, 1, Y, 1, c, s);
+            apply(n, X, Y, c, s);
         }
 
         void operator()(int n, T* X, int incx, T* Y, int incy, T c, T s) {
-            apply(n, X, incx, Y, incy, c, s);
+            if (incx == 1 && incy == 1)
+                apply(n, X, Y, c, s);
+            else
+                apply(n, X, incx, Y, incy, c, s);
         }
 
         void operator()(NUMCPP::Sequence<T> X, NUMCPP::Sequence<T> Y, T c, T s) {
             int incx = X.increment(), incy = Y.increment(), n = Y.length();
-            apply(incx, X.begin(), incx, Y.begin(), incy, c, s);
+            (*this)(n, X.start(), incx, Y.start(), incy, c, s);
         }
 
     private:
 
         void apply(int n, T* X, int incx, T* Y, int incy, T c, T s);
+        void apply(int n, T* X, T* Y, T c, T s);
     };
 
+    template <typename T>
+    void ROT<T>::apply(int n, T* X, T* Y, T c, T s) {
+        // unit strides: simple indexed loop, which can be vectorized
+        for (int i = 0; i < n; ++i) {
+            T xcur = X[i], ycur = Y[i];
+            X[i] = c * xcur + s * ycur;
+            Y[i] = c * ycur - s * xcur;
+        }
+    }
+
     template <typename T>
     void ROT<T>::apply(int n, T* X, int incx, T* Y, int incy, T c, T s) {
         if (n == 0)
@@ -38,7 +52,7 @@ namespace LCPP {
         T* x = X;
         T* const e = X + incx * n;
         while (x != e) {
-            double xcur = *x, ycur = *y;
+            T xcur = *x, ycur = *y;
             (*x) = c * xcur + s * ycur;
             (*y) = c * ycur - s * xcur;
             y += incy;
@@ -29,6 +29,15 @@ namespace LCPP {
         // Quick return if possible
         if (n == 0 || a == 1)
             return;
+        if constexpr (std::is_same<T, double>::value) {
+            if (incx == 1 && n >= NUMCPP::SIMD::MIN_LENGTH) {
+                if (a == 0)
+                    NUMCPP::SIMD::set(n, a, X);
+                else
+                    NUMCPP::SIMD::scal(n, a, X);
+                return;
+            }
+        }
         T* x = X;
         const T* const e = x + incx * n;
         if (a == 0) {
@@ -7,7 +7,10 @@
 #include <stdexcept>
 #include <iterator>
 #include <cstddef>  
+#include <type_traits>
 #include "constants.h"
+#include "simd.h"
+#include "parallel.h"
 
 namespace NUMCPP {
 
@@ -18,6 +21,9 @@ namespace NUMCPP {
     template <typename T>
     struct SequenceIterator;
 
+    template <class E>
+    struct Expr;
+
     /// <summary>
     /// Sequence of elements of type T that cannot be modified
     /// To be noted that the sequence itself can be modified (not its items)
@@ -177,7 +183,7 @@ namespace NUMCPP {
 
         Sequence<T> extract(int start, int n)const {
             int nc = start + n;
-            if (nc >= m_n)
+            if (nc > m_n)
                 return Sequence();
             return Sequence<T>(m_data + m_inc * start, n, m_inc);
         }
@@ -240,6 +246,20 @@ namespace NUMCPP {
             return *this;
         }
 
+        /// <summary>
+        /// Evaluates an expression of sequences (see expression.h) into the items, in a single loop.
+        /// To be noted that the assignment of a sequence changes the view, while the assignment of
+        /// an expression changes the items
+        /// </summary>
+        template <class E>
+        const Sequence<T>& operator =(const Expr<E>& expr)const;
+
+        template <class E>
+        const Sequence<T>& operator +=(const Expr<E>& expr)const;
+
+        template <class E>
+        const Sequence<T>& operator -=(const Expr<E>& expr)const;
+
         void addAY(T a, Sequence<T> Y)const;
 
         void set(T value)const;
@@ -252,17 +272,49 @@ namespace NUMCPP {
 
         T ssq()const;
 
+        /// <summary>
+        /// Index of the first largest item (-1 if the sequence is empty)
+        /// </summary>
         int imax()const;
 
         T max()const;
 
+        /// <summary>
+        /// Index of the first smallest item (-1 if the sequence is empty)
+        /// </summary>
         int imin()const;
 
+        /// <summary>
+        /// Index of the first item with the largest absolute value (-1 if the sequence is empty)
+        /// </summary>
+        int iamax()const;
+
         T min()const;
 
         template <class Fn>
         T accumulate(Fn fn)const;
 
+        /// <summary>
+        /// Parallel reductions, for very long sequences. The sequence is split in chunks of CHUNK items,
+        /// which are reduced independently on at most nthreads threads (0 = default concurrency). The partial
+        /// results are combined in a fixed pairwise tree: the result does not depend on the number of threads
+        /// </summary>
+        T parallelSum(int nthreads = 0)const;
+
+        T parallelAsum(int nthreads = 0)const;
+
+        T parallelSsq(int nthreads = 0)const;
+
+        T parallelDot(Sequence<T> Y, int nthreads = 0)const;
+
+        /// <summary>
+        /// Parallel version of accumulate. op combines the results of two chunks
+        /// </summary>
+        template <class Fn, class Op>
+        T parallelAccumulate(Fn fn, Op op, int nthreads = 0)const;
+
+        static constexpr int CHUNK = 1 << 16;
+
         Sequence<T>& slide(int del);
 
         Sequence<T>& bexpand() {
@@ -327,6 +379,17 @@ namespace NUMCPP {
 
     private:
 
+        template <class Op, class E>
+        void evaluate(const E& e)const;
+
+        // index of the first largest key(item)
+        template <class Fn>
+        int iext(Fn key)const;
+
+        // reduction of fn(start, length) on the chunks
+        template <class Fn, class Op>
+        T reduceChunks(Fn fn, Op op, int nthreads)const;
+
         T* m_data;
         int m_inc;
         int m_n;
@@ -378,6 +441,85 @@ namespace NUMCPP {
     };
 
 
+    /// <summary>
+    /// Sequence of contiguous elements (increment 1), like the columns of a matrix or a DataBlock.
+    /// The increment is known at compile time: the operations below are plain indexed loops, without
+    /// test on the increment. Converts to Sequence<T> wherever a (possibly strided) sequence is expected
+    /// </summary>
+    /// <typeparam name="T"></typeparam>
+    template <typename T>
+    struct ContiguousSequence : public Sequence<T>
+    {
+        ContiguousSequence() {}
+
+        ContiguousSequence(T* p0, T* p1) :Sequence<T>(p0, p1) {}
+
+        ContiguousSequence(T* p0, int n) :Sequence<T>(p0, n) {}
+
+        int increment() const {
+            return 1;
+        }
+
+        T& operator()(int idx)const {
+            return this->start()[idx];
+        }
+
+        ContiguousSequence<T> left(int n)const {
+            return ContiguousSequence<T>(this->start(), n);
+        }
+
+        ContiguousSequence<T> right(int n)const {
+            return ContiguousSequence<T>(this->start() + this->length() - n, n);
+        }
+
+        ContiguousSequence<T> drop(int nl, int nr)const {
+            int nc = nl + nr;
+            if (nc >= this->length())
+                return ContiguousSequence();
+            return ContiguousSequence<T>(this->start() + nl, this->length() - nc);
+        }
+
+        ContiguousSequence<T> extract(int start, int n)const {
+            if (start + n > this->length())
+                return ContiguousSequence();
+            return ContiguousSequence<T>(this->start() + start, n);
+        }
+
+        template <class E>
+        const ContiguousSequence<T>& operator =(const Expr<E>& expr)const {
+            Sequence<T>::operator=(expr);
+            return *this;
+        }
+
+        void copy(Sequence<T> src)const;
+
+        T dot(Sequence<T> src)const;
+
+        void mul(T value) const;
+
+        void div(T value, bool fast = true) const;
+
+        void add(T value)const;
+
+        void addAY(T a, Sequence<T> Y)const;
+
+        void set(T value)const;
+
+        void chs()const;
+
+        T asum()const;
+
+        T sum()const;
+
+        T ssq()const;
+
+        template <class Fn>
+        T accumulate(Fn fn)const;
+
+        template <class Fn>
+        void apply(Fn fn)const;
+    };
+
     template <typename T>
     class DataBlock
     {
@@ -396,8 +538,8 @@ namespace NUMCPP {
 
         DataBlock<T>& operator=(const DataBlock<T>& x);
 
-        Sequence<T> all() {
-            return Sequence<T>(m_data, m_size);
+        ContiguousSequence<T> all() {
+            return ContiguousSequence<T>(m_data, m_size);
         }
 
         int length() {
@@ -469,6 +611,12 @@ namespace NUMCPP {
     {
         if (m_n == 0)
             return;
+        if constexpr (std::is_same<T, double>::value) {
+            if (m_inc == 1 && src.m_inc == 1 && m_n >= SIMD::MIN_LENGTH) {
+                SIMD::copy(m_n, src.m_data, m_data);
+                return;
+            }
+        }
         T* x = m_data;
         T* y = src.m_data;
         T* const e = x + m_inc * m_n;
@@ -527,17 +675,9 @@ namespace NUMCPP {
     }
 
  
+    // uniform in [0, 1[ (see random.h)
     template<>
-    inline void Sequence<double>::rand() const{
-        std::random_device rd;
-        std::mt19937 mt(rd());
-        std::uniform_real_distribution<double> dist(0, 1);
-        double* x = m_data, * const e = x + m_inc * m_n;
-        while (e != x) {
-            *x = dist(mt);
-            x += m_inc;
-        }
-    }
+    inline void Sequence<double>::rand() const;
 
     template<>
     inline void DataBlock<double>::rand() {
@@ -552,6 +692,12 @@ namespace NUMCPP {
             set(n, value, x, incx);
             return;
         }
+        if constexpr (std::is_same<T, double>::value) {
+            if (incx == 1 && n >= SIMD::MIN_LENGTH) {
+                SIMD::scal(n, value, x);
+                return;
+            }
+        }
         int imax = incx * n;
         for (int i = 0; i != imax; i += incx)
             x[i] *= value;
@@ -565,6 +711,12 @@ namespace NUMCPP {
             set(value);
             return;
         }
+        if constexpr (std::is_same<T, double>::value) {
+            if (m_inc == 1 && m_n >= SIMD::MIN_LENGTH) {
+                SIMD::scal(m_n, value, m_data);
+                return;
+            }
+        }
         T* x = m_data, * const e = x + m_inc * m_n;
         while (e != x) {
             *x *= value;
@@ -594,6 +746,12 @@ namespace NUMCPP {
 
     template<typename T>
     void Sequence<T>::set(int n, T value, T* x, int incx) {
+        if constexpr (std::is_same<T, double>::value) {
+            if (incx == 1 && n >= SIMD::MIN_LENGTH) {
+                SIMD::set(n, value, x);
+                return;
+            }
+        }
         int imax = incx * n;
         for (int i = 0; i != imax; i += incx)
             x[i] = value;
@@ -601,6 +759,12 @@ namespace NUMCPP {
 
     template<typename T>
     void Sequence<T>::set(T value)const {
+        if constexpr (std::is_same<T, double>::value) {
+            if (m_inc == 1 && m_n >= SIMD::MIN_LENGTH) {
+                SIMD::set(m_n, value, m_data);
+                return;
+            }
+        }
         int imax = m_inc * m_n;
         for (int i = 0; i != imax; i += m_inc)
             m_data[i] = value;
@@ -610,6 +774,12 @@ namespace NUMCPP {
     void Sequence<T>::addAY(T a, Sequence<T> Y) const{
         if (a == NUMCPP::CONSTANTS<T>::zero)
             return;
+        if constexpr (std::is_same<T, double>::value) {
+            if (m_inc == 1 && Y.m_inc == 1 && m_n >= SIMD::MIN_LENGTH) {
+                SIMD::axpy(m_n, a, Y.m_data, m_data);
+                return;
+            }
+        }
         int imax = m_inc * m_n;
         for (int i = 0, j=0; i != imax; i += m_inc, j+=Y.m_inc) {
             m_data[i]+=a*Y.m_data[j];
@@ -618,11 +788,19 @@ namespace NUMCPP {
 
     template<typename T>
     inline T Sequence<T>::asum()const {
+        if constexpr (std::is_same<T, double>::value) {
+            if (m_inc == 1 && m_n >= SIMD::MIN_LENGTH)
+                return SIMD::asum(m_n, m_data);
+        }
         return accumulate([](T s, T cur) {return s + std::abs(cur); });
     }
 
     template<typename T>
     inline T Sequence<T>::sum()const {
+        if constexpr (std::is_same<T, double>::value) {
+            if (m_inc == 1 && m_n >= SIMD::MIN_LENGTH)
+                return SIMD::sum(m_n, m_data);
+        }
         T s = NUMCPP::CONSTANTS<T>::zero;
         int imax = m_inc * m_n;
         for (int i = 0; i != imax; i += m_inc) {
@@ -633,6 +811,10 @@ namespace NUMCPP {
 
     template<typename T>
     T Sequence<T>::ssq()const {
+        if constexpr (std::is_same<T, double>::value) {
+            if (m_inc == 1 && m_n >= SIMD::MIN_LENGTH)
+                return SIMD::ssq(m_n, m_data);
+        }
         T s = NUMCPP::CONSTANTS<T>::zero;
         int imax = m_inc * m_n;
         for (int i = 0; i != imax; i += m_inc) {
@@ -644,6 +826,10 @@ namespace NUMCPP {
 
     template<typename T>
     T Sequence<T>::dot(Sequence<T> Y)const {
+        if constexpr (std::is_same<T, double>::value) {
+            if (m_inc == 1 && Y.m_inc == 1 && m_n >= SIMD::MIN_LENGTH)
+                return SIMD::dot(m_n, m_data, Y.m_data);
+        }
         T s = NUMCPP::CONSTANTS<T>::zero;
         T* x = m_data, * y = Y.m_data, * const e = x + m_inc * m_n;
         while (e != x) {
@@ -667,6 +853,49 @@ namespace NUMCPP {
         return s;
     }
 
+    template<typename T>
+    template<class Fn, class Op>
+    T Sequence<T>::reduceChunks(Fn fn, Op op, int nthreads)const {
+        int nchunks = (m_n + CHUNK - 1) / CHUNK;
+        if (nchunks <= 1)
+            return fn(0, m_n);
+        return Parallel::reduce(nchunks, [&](int i) {
+            int start = i * CHUNK;
+            return fn(start, std::min(CHUNK, m_n - start));
+            }, op, nthreads);
+    }
+
+    template<typename T>
+    T Sequence<T>::parallelSum(int nthreads)const {
+        return reduceChunks([this](int start, int n) {return extract(start, n).sum(); },
+            [](T a, T b) {return a + b; }, nthreads);
+    }
+
+    template<typename T>
+    T Sequence<T>::parallelAsum(int nthreads)const {
+        return reduceChunks([this](int start, int n) {return extract(start, n).asum(); },
+            [](T a, T b) {return a + b; }, nthreads);
+    }
+
+    template<typename T>
+    T Sequence<T>::parallelSsq(int nthreads)const {
+        return reduceChunks([this](int start, int n) {return extract(start, n).ssq(); },
+            [](T a, T b) {return a + b; }, nthreads);
+    }
+
+    template<typename T>
+    T Sequence<T>::parallelDot(Sequence<T> Y, int nthreads)const {
+        return reduceChunks([this, Y](int start, int n) {return extract(start, n).dot(Y.extract(start, n)); },
+            [](T a, T b) {return a + b; }, nthreads);
+    }
+
+    template<typename T>
+    template<class Fn, class Op>
+    T Sequence<T>::parallelAccumulate(Fn fn, Op op, int nthreads)const {
+        return reduceChunks([this, &fn](int start, int n) {return extract(start, n).accumulate(fn); },
+            op, nthreads);
+    }
+
     template<typename T>
     void Sequence<T>::div(T value, bool fast)const {
         T one = NUMCPP::CONSTANTS<T>::one;
@@ -676,6 +905,12 @@ namespace NUMCPP {
         T* x = m_data, * const e = x + incx * m_n;
         if (fast) {
             T inv = one / value;
+            if constexpr (std::is_same<T, double>::value) {
+                if (incx == 1 && m_n >= SIMD::MIN_LENGTH) {
+                    SIMD::scal(m_n, inv, m_data);
+                    return;
+                }
+            }
             while (e != x) {
                 *x *= inv;
                 x += incx;
@@ -706,16 +941,14 @@ namespace NUMCPP {
     }
 
     template<typename T>
-    int Sequence<T>::imax() const {
+    template<class Fn>
+    int Sequence<T>::iext(Fn key) const {
         if (isEmpty())
             return -1;
-        if (m_n == 1)
-            return 0;
-        int nmax = m_inc * m_n;
-        T cmax = m_data[0];
+        T cmax = key(m_data[0]);
         int imax = 0;
-        for (int i = 1; i != nmax; i += m_inc) {
-            T cur = m_data[i];
+        for (int i = 1, j = m_inc; i < m_n; ++i, j += m_inc) {
+            T cur = key(m_data[j]);
             if (cur > cmax) {
                 cmax = cur;
                 imax = i;
@@ -724,6 +957,24 @@ namespace NUMCPP {
         return imax;
     }
 
+    template<typename T>
+    int Sequence<T>::imax() const {
+        if constexpr (std::is_same<T, double>::value) {
+            if (m_inc == 1 && m_n >= SIMD::MIN_LENGTH)
+                return SIMD::imax(m_n, m_data);
+        }
+        return iext([](T x) {return x; });
+    }
+
+    template<typename T>
+    int Sequence<T>::iamax() const {
+        if constexpr (std::is_same<T, double>::value) {
+            if (m_inc == 1 && m_n >= SIMD::MIN_LENGTH)
+                return SIMD::iamax(m_n, m_data);
+        }
+        return iext([](T x) {return std::abs(x); });
+    }
+
     template<typename T>
     T Sequence<T>::max() const {
         if (isEmpty())
@@ -743,21 +994,11 @@ namespace NUMCPP {
 
     template<typename T>
     int Sequence<T>::imin() const {
-        if (isEmpty())
-            return -1;
-        if (m_n == 1)
-            return 0;
-        int nmax = m_inc * m_n;
-        T cmin = m_data[0];
-        int imin = 0;
-        for (int i = 1; i != nmax; i += m_inc) {
-            T cur = m_data[i];
-            if (cur > cmin) {
-                cmin = cur;
-                imin = i;
-            }
+        if constexpr (std::is_same<T, double>::value) {
+            if (m_inc == 1 && m_n >= SIMD::MIN_LENGTH)
+                return SIMD::imin(m_n, m_data);
         }
-        return imin;
+        return iext([](T x) {return -x; });
     }
 
     template<typename T>
@@ -776,5 +1017,203 @@ namespace NUMCPP {
         }
         return cmin;
     }
+
+    template<typename T>
+    void ContiguousSequence<T>::copy(Sequence<T> src)const {
+        if (src.increment() != 1) {
+            Sequence<T>::copy(src);
+            return;
+        }
+        T* x = this->start();
+        const T* y = src.cstart();
+        int n = this->length();
+        if constexpr (std::is_same<T, double>::value) {
+            if (n >= SIMD::MIN_LENGTH) {
+                SIMD::copy(n, y, x);
+                return;
+            }
+        }
+        for (int i = 0; i < n; ++i)
+            x[i] = y[i];
+    }
+
+    template<typename T>
+    T ContiguousSequence<T>::dot(Sequence<T> Y)const {
+        if (Y.increment() != 1)
+            return Sequence<T>::dot(Y);
+        const T* x = this->cstart(), * y = Y.cstart();
+        int n = this->length();
+        if constexpr (std::is_same<T, double>::value) {
+            if (n >= SIMD::MIN_LENGTH)
+                return SIMD::dot(n, x, y);
+        }
+        T s = NUMCPP::CONSTANTS<T>::zero;
+        for (int i = 0; i < n; ++i)
+            s += x[i] * y[i];
+        return s;
+    }
+
+    template<typename T>
+    void ContiguousSequence<T>::mul(T value)const {
+        if (value == NUMCPP::CONSTANTS<T>::one)
+            return;
+        if (value == NUMCPP::CONSTANTS<T>::zero) {
+            set(value);
+            return;
+        }
+        T* x = this->start();
+        int n = this->length();
+        if constexpr (std::is_same<T, double>::value) {
+            if (n >= SIMD::MIN_LENGTH) {
+                SIMD::scal(n, value, x);
+                return;
+            }
+        }
+        for (int i = 0; i < n; ++i)
+            x[i] *= value;
+    }
+
+    template<typename T>
+    void ContiguousSequence<T>::div(T value, bool fast)const {
+        T one = NUMCPP::CONSTANTS<T>::one;
+        if (one == value)
+            return;
+        T* x = this->start();
+        int n = this->length();
+        if (fast) {
+            T inv = one / value;
+            if constexpr (std::is_same<T, double>::value) {
+                if (n >= SIMD::MIN_LENGTH) {
+                    SIMD::scal(n, inv, x);
+                    return;
+                }
+            }
+            for (int i = 0; i < n; ++i)
+                x[i] *= inv;
+        }
+        else {
+            for (int i = 0; i < n; ++i)
+                x[i] /= value;
+        }
+    }
+
+    template<typename T>
+    void ContiguousSequence<T>::add(T value)const {
+        if (value == NUMCPP::CONSTANTS<T>::zero)
+            return;
+        T* x = this->start();
+        int n = this->length();
+        for (int i = 0; i < n; ++i)
+            x[i] += value;
+    }
+
+    template<typename T>
+    void ContiguousSequence<T>::addAY(T a, Sequence<T> Y)const {
+        if (Y.increment() != 1) {
+            Sequence<T>::addAY(a, Y);
+            return;
+        }
+        if (a == NUMCPP::CONSTANTS<T>::zero)
+            return;
+        T* x = this->start();
+        const T* y = Y.cstart();
+        int n = this->length();
+        if constexpr (std::is_same<T, double>::value) {
+            if (n >= SIMD::MIN_LENGTH) {
+                SIMD::axpy(n, a, y, x);
+                return;
+            }
+        }
+        for (int i = 0; i < n; ++i)
+            x[i] += a * y[i];
+    }
+
+    template<typename T>
+    void ContiguousSequence<T>::set(T value)const {
+        T* x = this->start();
+        int n = this->length();
+        if constexpr (std::is_same<T, double>::value) {
+            if (n >= SIMD::MIN_LENGTH) {
+                SIMD::set(n, value, x);
+                return;
+            }
+        }
+        for (int i = 0; i < n; ++i)
+            x[i] = value;
+    }
+
+    template<typename T>
+    void ContiguousSequence<T>::chs()const {
+        T* x = this->start();
+        int n = this->length();
+        for (int i = 0; i < n; ++i)
+            x[i] = -x[i];
+    }
+
+    template<typename T>
+    T ContiguousSequence<T>::asum()const {
+        const T* x = this->cstart();
+        int n = this->length();
+        if constexpr (std::is_same<T, double>::value) {
+            if (n >= SIMD::MIN_LENGTH)
+                return SIMD::asum(n, x);
+        }
+        T s = NUMCPP::CONSTANTS<T>::zero;
+        for (int i = 0; i < n; ++i)
+            s += std::abs(x[i]);
+        return s;
+    }
+
+    template<typename T>
+    T ContiguousSequence<T>::sum()const {
+        const T* x = this->cstart();
+        int n = this->length();
+        if constexpr (std::is_same<T, double>::value) {
+            if (n >= SIMD::MIN_LENGTH)
+                return SIMD::sum(n, x);
+        }
+        T s = NUMCPP::CONSTANTS<T>::zero;
+        for (int i = 0; i < n; ++i)
+            s += x[i];
+        return s;
+    }
+
+    template<typename T>
+    T ContiguousSequence<T>::ssq()const {
+        const T* x = this->cstart();
+        int n = this->length();
+        if constexpr (std::is_same<T, double>::value) {
+            if (n >= SIMD::MIN_LENGTH)
+                return SIMD::ssq(n, x);
+        }
+        T s = NUMCPP::CONSTANTS<T>::zero;
+        for (int i = 0; i < n; ++i)
+            s += x[i] * x[i];
+        return s;
+    }
+
+    template<typename T>
+    template<class Fn>
+    T ContiguousSequence<T>::accumulate(Fn fn)const {
+        const T* x = this->cstart();
+        int n = this->length();
+        T s = NUMCPP::CONSTANTS<T>::zero;
+        for (int i = 0; i < n; ++i)
+            s = fn(s, x[i]);
+        return s;
+    }
+
+    template<typename T>
+    template<class Fn>
+    void ContiguousSequence<T>::apply(Fn fn)const {
+        T* x = this->start();
+        int n = this->length();
+        for (int i = 0; i < n; ++i)
+            x[i] = fn(x[i]);
+    }
 }
+
+#include "expression.h"
+#include "random.h"
+
 #endif
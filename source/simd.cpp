@@ -0,0 +1,863 @@
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include "simd.h"
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define NUMCPP_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+// MSVC accepts the intrinsics of any instruction set; gcc and clang need them enabled per function
+#if defined(_MSC_VER) && !defined(__clang__)
+#define NUMCPP_TARGET(isa)
+#else
+#define NUMCPP_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+using namespace NUMCPP;
+
+namespace {
+
+    struct Kernels {
+        double (*dot)(int, const double*, const double*);
+        double (*sum)(int, const double*);
+        double (*ssq)(int, const double*);
+        double (*asum)(int, const double*);
+        void (*axpy)(int, double, const double*, double*);
+        void (*scal)(int, double, double*);
+        void (*copy)(int, const double*, double*);
+        void (*set)(int, double, double*);
+        int (*iamax)(int, const double*);
+        int (*imax)(int, const double*);
+        int (*imin)(int, const double*);
+        // micro-kernel of the matrix product and its number of rows (the number of columns is GEMM_NR)
+        void (*gemm)(int, const double*, const double*, double, double*, int);
+        int mr;
+    };
+
+    // Matrix product. op(A) is packed by blocks of GEMM_MC x GEMM_KC (L2 cache) and op(B) by blocks of
+    // GEMM_KC x GEMM_NC (L3 cache), in micro-panels of mr rows and GEMM_NR columns. The micro-kernel
+    // computes c = beta * c + a * b on an mr x GEMM_NR block of C, in registers:
+    // a(p * mr + i) = op(A)(i, p), b(p * GEMM_NR + j) = op(B)(p, j). If beta is 0, c is not read
+    const int GEMM_NR = 6, GEMM_KC = 256, GEMM_MC = 128, GEMM_NC = 3072;
+
+    // Index reductions. M = 0: max |x(i)|, M = 1: max x(i), M = 2: min x(i) (max -x(i)).
+    // As in the reference IDAMAX, the first index of the extremum is returned, and NaNs are skipped
+    // (unless x(0) is NaN, which gives 0)
+
+    template <int M>
+    inline double key(double x) {
+        return M == 0 ? std::abs(x) : M == 1 ? x : -x;
+    }
+
+    template <int M>
+    int iext_scalar(int n, const double* x) {
+        int imax = 0;
+        double cmax = key<M>(x[0]);
+        for (int i = 1; i < n; ++i) {
+            double cur = key<M>(x[i]);
+            if (cur > cmax) {
+                cmax = cur;
+                imax = i;
+            }
+        }
+        return imax;
+    }
+
+    // combines the maxima of the lanes (lane 0 contains x(0)) and the scalar tail x(i0:n)
+    template <int M>
+    int iext_lanes(const double* vmax, const double* vidx, int nlanes, int i0, int n, const double* x) {
+        double cmax = vmax[0];
+        int imax = (int)vidx[0];
+        for (int l = 1; l < nlanes; ++l) {
+            int il = (int)vidx[l];
+            if (vmax[l] > cmax || (vmax[l] == cmax && il < imax)) {
+                cmax = vmax[l];
+                imax = il;
+            }
+        }
+        for (int i = i0; i < n; ++i) {
+            double cur = key<M>(x[i]);
+            if (cur > cmax) {
+                cmax = cur;
+                imax = i;
+            }
+        }
+        return imax;
+    }
+
+    // Scalar kernels (4 accumulators for the reductions)
+
+    double dot_scalar(int n, const double* x, const double* y) {
+        double s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+        int i = 0;
+        for (; i + 4 <= n; i += 4) {
+            s0 += x[i] * y[i];
+            s1 += x[i + 1] * y[i + 1];
+            s2 += x[i + 2] * y[i + 2];
+            s3 += x[i + 3] * y[i + 3];
+        }
+        for (; i < n; ++i)
+            s0 += x[i] * y[i];
+        return (s0 + s1) + (s2 + s3);
+    }
+
+    double sum_scalar(int n, const double* x) {
+        double s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+        int i = 0;
+        for (; i + 4 <= n; i += 4) {
+            s0 += x[i];
+            s1 += x[i + 1];
+            s2 += x[i + 2];
+            s3 += x[i + 3];
+        }
+        for (; i < n; ++i)
+            s0 += x[i];
+        return (s0 + s1) + (s2 + s3);
+    }
+
+    double ssq_scalar(int n, const double* x) {
+        return dot_scalar(n, x, x);
+    }
+
+    double asum_scalar(int n, const double* x) {
+        double s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+        int i = 0;
+        for (; i + 4 <= n; i += 4) {
+            s0 += std::abs(x[i]);
+            s1 += std::abs(x[i + 1]);
+            s2 += std::abs(x[i + 2]);
+            s3 += std::abs(x[i + 3]);
+        }
+        for (; i < n; ++i)
+            s0 += std::abs(x[i]);
+        return (s0 + s1) + (s2 + s3);
+    }
+
+    void axpy_scalar(int n, double a, const double* x, double* y) {
+        for (int i = 0; i < n; ++i)
+            y[i] += a * x[i];
+    }
+
+    void scal_scalar(int n, double a, double* x) {
+        for (int i = 0; i < n; ++i)
+            x[i] *= a;
+    }
+
+    void copy_scalar(int n, const double* x, double* y) {
+        for (int i = 0; i < n; ++i)
+            y[i] = x[i];
+    }
+
+    void set_scalar(int n, double a, double* x) {
+        for (int i = 0; i < n; ++i)
+            x[i] = a;
+    }
+
+    void gemm_scalar(int k, const double* a, const double* b, double beta, double* c, int ldc) {
+        const int MR = 8;
+        double acc[MR * GEMM_NR] = {};
+        for (int p = 0; p < k; ++p, a += MR, b += GEMM_NR) {
+            for (int j = 0; j < GEMM_NR; ++j) {
+                double bj = b[j];
+                for (int i = 0; i < MR; ++i)
+                    acc[j * MR + i] += a[i] * bj;
+            }
+        }
+        for (int j = 0; j < GEMM_NR; ++j, c += ldc) {
+            for (int i = 0; i < MR; ++i)
+                c[i] = beta == 0 ? acc[j * MR + i] : beta * c[i] + acc[j * MR + i];
+        }
+    }
+
+    const Kernels SCALAR = { dot_scalar, sum_scalar, ssq_scalar, asum_scalar, axpy_scalar, scal_scalar, copy_scalar, set_scalar,
+        iext_scalar<0>, iext_scalar<1>, iext_scalar<2>, gemm_scalar, 8 };
+
+#ifdef NUMCPP_X86
+
+    // AVX2 kernels (4 x 4 doubles per iteration, scalar tail)
+
+    NUMCPP_TARGET("avx2,fma")
+    inline double hsum_avx2(__m256d a0, __m256d a1, __m256d a2, __m256d a3) {
+        __m256d s = _mm256_add_pd(_mm256_add_pd(a0, a1), _mm256_add_pd(a2, a3));
+        __m128d h = _mm_add_pd(_mm256_castpd256_pd128(s), _mm256_extractf128_pd(s, 1));
+        return _mm_cvtsd_f64(_mm_add_sd(h, _mm_unpackhi_pd(h, h)));
+    }
+
+    NUMCPP_TARGET("avx2,fma")
+    double dot_avx2(int n, const double* x, const double* y) {
+        __m256d a0 = _mm256_setzero_pd(), a1 = a0, a2 = a0, a3 = a0;
+        int i = 0;
+        for (; i + 16 <= n; i += 16) {
+            a0 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i), a0);
+            a1 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i + 4), _mm256_loadu_pd(y + i + 4), a1);
+            a2 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i + 8), _mm256_loadu_pd(y + i + 8), a2);
+            a3 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i + 12), _mm256_loadu_pd(y + i + 12), a3);
+        }
+        for (; i + 4 <= n; i += 4)
+            a0 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i), a0);
+        double s = hsum_avx2(a0, a1, a2, a3);
+        for (; i < n; ++i)
+            s += x[i] * y[i];
+        return s;
+    }
+
+    NUMCPP_TARGET("avx2,fma")
+    double sum_avx2(int n, const double* x) {
+        __m256d a0 = _mm256_setzero_pd(), a1 = a0, a2 = a0, a3 = a0;
+        int i = 0;
+        for (; i + 16 <= n; i += 16) {
+            a0 = _mm256_add_pd(_mm256_loadu_pd(x + i), a0);
+            a1 = _mm256_add_pd(_mm256_loadu_pd(x + i + 4), a1);
+            a2 = _mm256_add_pd(_mm256_loadu_pd(x + i + 8), a2);
+            a3 = _mm256_add_pd(_mm256_loadu_pd(x + i + 12), a3);
+        }
+        for (; i + 4 <= n; i += 4)
+            a0 = _mm256_add_pd(_mm256_loadu_pd(x + i), a0);
+        double s = hsum_avx2(a0, a1, a2, a3);
+        for (; i < n; ++i)
+            s += x[i];
+        return s;
+    }
+
+    NUMCPP_TARGET("avx2,fma")
+    double ssq_avx2(int n, const double* x) {
+        __m256d a0 = _mm256_setzero_pd(), a1 = a0, a2 = a0, a3 = a0;
+        int i = 0;
+        for (; i + 16 <= n; i += 16) {
+            __m256d x0 = _mm256_loadu_pd(x + i), x1 = _mm256_loadu_pd(x + i + 4),
+                x2 = _mm256_loadu_pd(x + i + 8), x3 = _mm256_loadu_pd(x + i + 12);
+            a0 = _mm256_fmadd_pd(x0, x0, a0);
+            a1 = _mm256_fmadd_pd(x1, x1, a1);
+            a2 = _mm256_fmadd_pd(x2, x2, a2);
+            a3 = _mm256_fmadd_pd(x3, x3, a3);
+        }
+        for (; i + 4 <= n; i += 4) {
+            __m256d x0 = _mm256_loadu_pd(x + i);
+            a0 = _mm256_fmadd_pd(x0, x0, a0);
+        }
+        double s = hsum_avx2(a0, a1, a2, a3);
+        for (; i < n; ++i)
+            s += x[i] * x[i];
+        return s;
+    }
+
+    NUMCPP_TARGET("avx2,fma")
+    double asum_avx2(int n, const double* x) {
+        const __m256d sign = _mm256_set1_pd(-0.0);
+        __m256d a0 = _mm256_setzero_pd(), a1 = a0, a2 = a0, a3 = a0;
+        int i = 0;
+        for (; i + 16 <= n; i += 16) {
+            a0 = _mm256_add_pd(_mm256_andnot_pd(sign, _mm256_loadu_pd(x + i)), a0);
+            a1 = _mm256_add_pd(_mm256_andnot_pd(sign, _mm256_loadu_pd(x + i + 4)), a1);
+            a2 = _mm256_add_pd(_mm256_andnot_pd(sign, _mm256_loadu_pd(x + i + 8)), a2);
+            a3 = _mm256_add_pd(_mm256_andnot_pd(sign, _mm256_loadu_pd(x + i + 12)), a3);
+        }
+        for (; i + 4 <= n; i += 4)
+            a0 = _mm256_add_pd(_mm256_andnot_pd(sign, _mm256_loadu_pd(x + i)), a0);
+        double s = hsum_avx2(a0, a1, a2, a3);
+        for (; i < n; ++i)
+            s += std::abs(x[i]);
+        return s;
+    }
+
+    NUMCPP_TARGET("avx2,fma")
+    void axpy_avx2(int n, double a, const double* x, double* y) {
+        __m256d va = _mm256_set1_pd(a);
+        int i = 0;
+        for (; i + 8 <= n; i += 8) {
+            _mm256_storeu_pd(y + i, _mm256_fmadd_pd(va, _mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i)));
+            _mm256_storeu_pd(y + i + 4, _mm256_fmadd_pd(va, _mm256_loadu_pd(x + i + 4), _mm256_loadu_pd(y + i + 4)));
+        }
+        for (; i < n; ++i)
+            y[i] += a * x[i];
+    }
+
+    NUMCPP_TARGET("avx2,fma")
+    void scal_avx2(int n, double a, double* x) {
+        __m256d va = _mm256_set1_pd(a);
+        int i = 0;
+        for (; i + 8 <= n; i += 8) {
+            _mm256_storeu_pd(x + i, _mm256_mul_pd(va, _mm256_loadu_pd(x + i)));
+            _mm256_storeu_pd(x + i + 4, _mm256_mul_pd(va, _mm256_loadu_pd(x + i + 4)));
+        }
+        for (; i < n; ++i)
+            x[i] *= a;
+    }
+
+    NUMCPP_TARGET("avx2,fma")
+    void copy_avx2(int n, const double* x, double* y) {
+        int i = 0;
+        for (; i + 8 <= n; i += 8) {
+            _mm256_storeu_pd(y + i, _mm256_loadu_pd(x + i));
+            _mm256_storeu_pd(y + i + 4, _mm256_loadu_pd(x + i + 4));
+        }
+        for (; i < n; ++i)
+            y[i] = x[i];
+    }
+
+    NUMCPP_TARGET("avx2,fma")
+    void set_avx2(int n, double a, double* x) {
+        __m256d va = _mm256_set1_pd(a);
+        int i = 0;
+        for (; i + 8 <= n; i += 8) {
+            _mm256_storeu_pd(x + i, va);
+            _mm256_storeu_pd(x + i + 4, va);
+        }
+        for (; i < n; ++i)
+            x[i] = a;
+    }
+
+    template <int M>
+    NUMCPP_TARGET("avx2,fma")
+    inline __m256d key_avx2(__m256d x) {
+        const __m256d sign = _mm256_set1_pd(-0.0);
+        if (M == 0)
+            return _mm256_andnot_pd(sign, x);
+        if (M == 2)
+            return _mm256_xor_pd(sign, x);
+        return x;
+    }
+
+    // running maxima and their indices (as doubles) in two sets of 4 lanes; a lane holding a NaN
+    // is replaced by the next value
+    template <int M>
+    NUMCPP_TARGET("avx2,fma")
+    int iext_avx2(int n, const double* x) {
+        if (n < 8 || key<M>(x[0]) != key<M>(x[0]))
+            return iext_scalar<M>(n, x);
+        __m256d m0 = key_avx2<M>(_mm256_loadu_pd(x)), m1 = key_avx2<M>(_mm256_loadu_pd(x + 4));
+        __m256d i0 = _mm256_set_pd(3, 2, 1, 0), i1 = _mm256_set_pd(7, 6, 5, 4);
+        __m256d c0 = _mm256_add_pd(i0, _mm256_set1_pd(8)), c1 = _mm256_add_pd(i1, _mm256_set1_pd(8)), step = _mm256_set1_pd(8);
+        int i = 8;
+        for (; i + 8 <= n; i += 8) {
+            __m256d v0 = key_avx2<M>(_mm256_loadu_pd(x + i)), v1 = key_avx2<M>(_mm256_loadu_pd(x + i + 4));
+            __m256d g0 = _mm256_or_pd(_mm256_cmp_pd(v0, m0, _CMP_GT_OQ), _mm256_cmp_pd(m0, m0, _CMP_UNORD_Q));
+            __m256d g1 = _mm256_or_pd(_mm256_cmp_pd(v1, m1, _CMP_GT_OQ), _mm256_cmp_pd(m1, m1, _CMP_UNORD_Q));
+            m0 = _mm256_blendv_pd(m0, v0, g0);
+            i0 = _mm256_blendv_pd(i0, c0, g0);
+            m1 = _mm256_blendv_pd(m1, v1, g1);
+            i1 = _mm256_blendv_pd(i1, c1, g1);
+            c0 = _mm256_add_pd(c0, step);
+            c1 = _mm256_add_pd(c1, step);
+        }
+        double vmax[8], vidx[8];
+        _mm256_storeu_pd(vmax, m0);
+        _mm256_storeu_pd(vmax + 4, m1);
+        _mm256_storeu_pd(vidx, i0);
+        _mm256_storeu_pd(vidx + 4, i1);
+        return iext_lanes<M>(vmax, vidx, 8, i, n, x);
+    }
+
+    // 8 x 6 block: 12 accumulators
+    NUMCPP_TARGET("avx2,fma")
+    void gemm_avx2(int k, const double* a, const double* b, double beta, double* c, int ldc) {
+        __m256d c00 = _mm256_setzero_pd(), c01 = c00, c02 = c00, c03 = c00, c04 = c00, c05 = c00;
+        __m256d c10 = c00, c11 = c00, c12 = c00, c13 = c00, c14 = c00, c15 = c00;
+        for (int p = 0; p < k; ++p, a += 8, b += GEMM_NR) {
+            __m256d a0 = _mm256_loadu_pd(a), a1 = _mm256_loadu_pd(a + 4), bj;
+            bj = _mm256_broadcast_sd(b);
+            c00 = _mm256_fmadd_pd(a0, bj, c00);
+            c10 = _mm256_fmadd_pd(a1, bj, c10);
+            bj = _mm256_broadcast_sd(b + 1);
+            c01 = _mm256_fmadd_pd(a0, bj, c01);
+            c11 = _mm256_fmadd_pd(a1, bj, c11);
+            bj = _mm256_broadcast_sd(b + 2);
+            c02 = _mm256_fmadd_pd(a0, bj, c02);
+            c12 = _mm256_fmadd_pd(a1, bj, c12);
+            bj = _mm256_broadcast_sd(b + 3);
+            c03 = _mm256_fmadd_pd(a0, bj, c03);
+            c13 = _mm256_fmadd_pd(a1, bj, c13);
+            bj = _mm256_broadcast_sd(b + 4);
+            c04 = _mm256_fmadd_pd(a0, bj, c04);
+            c14 = _mm256_fmadd_pd(a1, bj, c14);
+            bj = _mm256_broadcast_sd(b + 5);
+            c05 = _mm256_fmadd_pd(a0, bj, c05);
+            c15 = _mm256_fmadd_pd(a1, bj, c15);
+        }
+        __m256d acc[2 * GEMM_NR] = { c00, c10, c01, c11, c02, c12, c03, c13, c04, c14, c05, c15 };
+        __m256d vb = _mm256_set1_pd(beta);
+        for (int j = 0; j < GEMM_NR; ++j, c += ldc) {
+            if (beta == 0) {
+                _mm256_storeu_pd(c, acc[2 * j]);
+                _mm256_storeu_pd(c + 4, acc[2 * j + 1]);
+            }
+            else {
+                _mm256_storeu_pd(c, _mm256_fmadd_pd(vb, _mm256_loadu_pd(c), acc[2 * j]));
+                _mm256_storeu_pd(c + 4, _mm256_fmadd_pd(vb, _mm256_loadu_pd(c + 4), acc[2 * j + 1]));
+            }
+        }
+    }
+
+    const Kernels AVX2 = { dot_avx2, sum_avx2, ssq_avx2, asum_avx2, axpy_avx2, scal_avx2, copy_avx2, set_avx2,
+        iext_avx2<0>, iext_avx2<1>, iext_avx2<2>, gemm_avx2, 8 };
+
+    // AVX-512 kernels (4 x 8 doubles per iteration, masked tail)
+
+    NUMCPP_TARGET("avx512f")
+    inline __mmask8 tail512(int r) {
+        return (__mmask8)((1u << r) - 1);
+    }
+
+    NUMCPP_TARGET("avx512f")
+    double dot_avx512(int n, const double* x, const double* y) {
+        __m512d a0 = _mm512_setzero_pd(), a1 = a0, a2 = a0, a3 = a0;
+        int i = 0;
+        for (; i + 32 <= n; i += 32) {
+            a0 = _mm512_fmadd_pd(_mm512_loadu_pd(x + i), _mm512_loadu_pd(y + i), a0);
+            a1 = _mm512_fmadd_pd(_mm512_loadu_pd(x + i + 8), _mm512_loadu_pd(y + i + 8), a1);
+            a2 = _mm512_fmadd_pd(_mm512_loadu_pd(x + i + 16), _mm512_loadu_pd(y + i + 16), a2);
+            a3 = _mm512_fmadd_pd(_mm512_loadu_pd(x + i + 24), _mm512_loadu_pd(y + i + 24), a3);
+        }
+        for (; i + 8 <= n; i += 8)
+            a0 = _mm512_fmadd_pd(_mm512_loadu_pd(x + i), _mm512_loadu_pd(y + i), a0);
+        if (i < n) {
+            __mmask8 m = tail512(n - i);
+            a1 = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(m, x + i), _mm512_maskz_loadu_pd(m, y + i), a1);
+        }
+        return _mm512_reduce_add_pd(_mm512_add_pd(_mm512_add_pd(a0, a1), _mm512_add_pd(a2, a3)));
+    }
+
+    NUMCPP_TARGET("avx512f")
+    double sum_avx512(int n, const double* x) {
+        __m512d a0 = _mm512_setzero_pd(), a1 = a0, a2 = a0, a3 = a0;
+        int i = 0;
+        for (; i + 32 <= n; i += 32) {
+            a0 = _mm512_add_pd(_mm512_loadu_pd(x + i), a0);
+            a1 = _mm512_add_pd(_mm512_loadu_pd(x + i + 8), a1);
+            a2 = _mm512_add_pd(_mm512_loadu_pd(x + i + 16), a2);
+            a3 = _mm512_add_pd(_mm512_loadu_pd(x + i + 24), a3);
+        }
+        for (; i + 8 <= n; i += 8)
+            a0 = _mm512_add_pd(_mm512_loadu_pd(x + i), a0);
+        if (i < n)
+            a1 = _mm512_add_pd(_mm512_maskz_loadu_pd(tail512(n - i), x + i), a1);
+        return _mm512_reduce_add_pd(_mm512_add_pd(_mm512_add_pd(a0, a1), _mm512_add_pd(a2, a3)));
+    }
+
+    NUMCPP_TARGET("avx512f")
+    double ssq_avx512(int n, const double* x) {
+        __m512d a0 = _mm512_setzero_pd(), a1 = a0, a2 = a0, a3 = a0;
+        int i = 0;
+        for (; i + 32 <= n; i += 32) {
+            __m512d x0 = _mm512_loadu_pd(x + i), x1 = _mm512_loadu_pd(x + i + 8),
+                x2 = _mm512_loadu_pd(x + i + 16), x3 = _mm512_loadu_pd(x + i + 24);
+            a0 = _mm512_fmadd_pd(x0, x0, a0);
+            a1 = _mm512_fmadd_pd(x1, x1, a1);
+            a2 = _mm512_fmadd_pd(x2, x2, a2);
+            a3 = _mm512_fmadd_pd(x3, x3, a3);
+        }
+        for (; i + 8 <= n; i += 8) {
+            __m512d x0 = _mm512_loadu_pd(x + i);
+            a0 = _mm512_fmadd_pd(x0, x0, a0);
+        }
+        if (i < n) {
+            __m512d x0 = _mm512_maskz_loadu_pd(tail512(n - i), x + i);
+            a1 = _mm512_fmadd_pd(x0, x0, a1);
+        }
+        return _mm512_reduce_add_pd(_mm512_add_pd(_mm512_add_pd(a0, a1), _mm512_add_pd(a2, a3)));
+    }
+
+    NUMCPP_TARGET("avx512f")
+    double asum_avx512(int n, const double* x) {
+        __m512d a0 = _mm512_setzero_pd(), a1 = a0, a2 = a0, a3 = a0;
+        int i = 0;
+        for (; i + 32 <= n; i += 32) {
+            a0 = _mm512_add_pd(_mm512_abs_pd(_mm512_loadu_pd(x + i)), a0);
+            a1 = _mm512_add_pd(_mm512_abs_pd(_mm512_loadu_pd(x + i + 8)), a1);
+            a2 = _mm512_add_pd(_mm512_abs_pd(_mm512_loadu_pd(x + i + 16)), a2);
+            a3 = _mm512_add_pd(_mm512_abs_pd(_mm512_loadu_pd(x + i + 24)), a3);
+        }
+        for (; i + 8 <= n; i += 8)
+            a0 = _mm512_add_pd(_mm512_abs_pd(_mm512_loadu_pd(x + i)), a0);
+        if (i < n)
+            a1 = _mm512_add_pd(_mm512_abs_pd(_mm512_maskz_loadu_pd(tail512(n - i), x + i)), a1);
+        return _mm512_reduce_add_pd(_mm512_add_pd(_mm512_add_pd(a0, a1), _mm512_add_pd(a2, a3)));
+    }
+
+    NUMCPP_TARGET("avx512f")
+    void axpy_avx512(int n, double a, const double* x, double* y) {
+        __m512d va = _mm512_set1_pd(a);
+        int i = 0;
+        for (; i + 16 <= n; i += 16) {
+            _mm512_storeu_pd(y + i, _mm512_fmadd_pd(va, _mm512_loadu_pd(x + i), _mm512_loadu_pd(y + i)));
+            _mm512_storeu_pd(y + i + 8, _mm512_fmadd_pd(va, _mm512_loadu_pd(x + i + 8), _mm512_loadu_pd(y + i + 8)));
+        }
+        for (; i + 8 <= n; i += 8)
+            _mm512_storeu_pd(y + i, _mm512_fmadd_pd(va, _mm512_loadu_pd(x + i), _mm512_loadu_pd(y + i)));
+        if (i < n) {
+            __mmask8 m = tail512(n - i);
+            _mm512_mask_storeu_pd(y + i, m, _mm512_fmadd_pd(va, _mm512_maskz_loadu_pd(m, x + i), _mm512_maskz_loadu_pd(m, y + i)));
+        }
+    }
+
+    NUMCPP_TARGET("avx512f")
+    void scal_avx512(int n, double a, double* x) {
+        __m512d va = _mm512_set1_pd(a);
+        int i = 0;
+        for (; i + 16 <= n; i += 16) {
+            _mm512_storeu_pd(x + i, _mm512_mul_pd(va, _mm512_loadu_pd(x + i)));
+            _mm512_storeu_pd(x + i + 8, _mm512_mul_pd(va, _mm512_loadu_pd(x + i + 8)));
+        }
+        for (; i + 8 <= n; i += 8)
+            _mm512_storeu_pd(x + i, _mm512_mul_pd(va, _mm512_loadu_pd(x + i)));
+        if (i < n) {
+            __mmask8 m = tail512(n - i);
+            _mm512_mask_storeu_pd(x + i, m, _mm512_mul_pd(va, _mm512_maskz_loadu_pd(m, x + i)));
+        }
+    }
+
+    NUMCPP_TARGET("avx512f")
+    void copy_avx512(int n, const double* x, double* y) {
+        int i = 0;
+        for (; i + 16 <= n; i += 16) {
+            _mm512_storeu_pd(y + i, _mm512_loadu_pd(x + i));
+            _mm512_storeu_pd(y + i + 8, _mm512_loadu_pd(x + i + 8));
+        }
+        for (; i + 8 <= n; i += 8)
+            _mm512_storeu_pd(y + i, _mm512_loadu_pd(x + i));
+        if (i < n) {
+            __mmask8 m = tail512(n - i);
+            _mm512_mask_storeu_pd(y + i, m, _mm512_maskz_loadu_pd(m, x + i));
+        }
+    }
+
+    NUMCPP_TARGET("avx512f")
+    void set_avx512(int n, double a, double* x) {
+        __m512d va = _mm512_set1_pd(a);
+        int i = 0;
+        for (; i + 16 <= n; i += 16) {
+            _mm512_storeu_pd(x + i, va);
+            _mm512_storeu_pd(x + i + 8, va);
+        }
+        for (; i + 8 <= n; i += 8)
+            _mm512_storeu_pd(x + i, va);
+        if (i < n)
+            _mm512_mask_storeu_pd(x + i, tail512(n - i), va);
+    }
+
+    template <int M>
+    NUMCPP_TARGET("avx512f")
+    inline __m512d key_avx512(__m512d x) {
+        if (M == 0)
+            return _mm512_abs_pd(x);
+        if (M == 2)
+            return _mm512_castsi512_pd(_mm512_xor_si512(_mm512_castpd_si512(x), _mm512_set1_epi64((long long)0x8000000000000000ull)));
+        return x;
+    }
+
+    template <int M>
+    NUMCPP_TARGET("avx512f")
+    int iext_avx512(int n, const double* x) {
+        if (n < 16 || key<M>(x[0]) != key<M>(x[0]))
+            return iext_scalar<M>(n, x);
+        __m512d m0 = key_avx512<M>(_mm512_loadu_pd(x)), m1 = key_avx512<M>(_mm512_loadu_pd(x + 8));
+        __m512d i0 = _mm512_set_pd(7, 6, 5, 4, 3, 2, 1, 0), step = _mm512_set1_pd(8);
+        __m512d i1 = _mm512_add_pd(i0, step);
+        step = _mm512_add_pd(step, step);
+        __m512d c0 = _mm512_add_pd(i0, step), c1 = _mm512_add_pd(i1, step);
+        int i = 16;
+        for (; i + 16 <= n; i += 16) {
+            __m512d v0 = key_avx512<M>(_mm512_loadu_pd(x + i)), v1 = key_avx512<M>(_mm512_loadu_pd(x + i + 8));
+            __mmask8 g0 = _mm512_cmp_pd_mask(v0, m0, _CMP_GT_OQ) | _mm512_cmp_pd_mask(m0, m0, _CMP_UNORD_Q);
+            __mmask8 g1 = _mm512_cmp_pd_mask(v1, m1, _CMP_GT_OQ) | _mm512_cmp_pd_mask(m1, m1, _CMP_UNORD_Q);
+            m0 = _mm512_mask_blend_pd(g0, m0, v0);
+            i0 = _mm512_mask_blend_pd(g0, i0, c0);
+            m1 = _mm512_mask_blend_pd(g1, m1, v1);
+            i1 = _mm512_mask_blend_pd(g1, i1, c1);
+            c0 = _mm512_add_pd(c0, step);
+            c1 = _mm512_add_pd(c1, step);
+        }
+        double vmax[16], vidx[16];
+        _mm512_storeu_pd(vmax, m0);
+        _mm512_storeu_pd(vmax + 8, m1);
+        _mm512_storeu_pd(vidx, i0);
+        _mm512_storeu_pd(vidx + 8, i1);
+        return iext_lanes<M>(vmax, vidx, 16, i, n, x);
+    }
+
+    // 16 x 6 block: 12 accumulators
+    NUMCPP_TARGET("avx512f")
+    void gemm_avx512(int k, const double* a, const double* b, double beta, double* c, int ldc) {
+        __m512d c00 = _mm512_setzero_pd(), c01 = c00, c02 = c00, c03 = c00, c04 = c00, c05 = c00;
+        __m512d c10 = c00, c11 = c00, c12 = c00, c13 = c00, c14 = c00, c15 = c00;
+        for (int p = 0; p < k; ++p, a += 16, b += GEMM_NR) {
+            __m512d a0 = _mm512_loadu_pd(a), a1 = _mm512_loadu_pd(a + 8), bj;
+            bj = _mm512_set1_pd(b[0]);
+            c00 = _mm512_fmadd_pd(a0, bj, c00);
+            c10 = _mm512_fmadd_pd(a1, bj, c10);
+            bj = _mm512_set1_pd(b[1]);
+            c01 = _mm512_fmadd_pd(a0, bj, c01);
+            c11 = _mm512_fmadd_pd(a1, bj, c11);
+            bj = _mm512_set1_pd(b[2]);
+            c02 = _mm512_fmadd_pd(a0, bj, c02);
+            c12 = _mm512_fmadd_pd(a1, bj, c12);
+            bj = _mm512_set1_pd(b[3]);
+            c03 = _mm512_fmadd_pd(a0, bj, c03);
+            c13 = _mm512_fmadd_pd(a1, bj, c13);
+            bj = _mm512_set1_pd(b[4]);
+            c04 = _mm512_fmadd_pd(a0, bj, c04);
+            c14 = _mm512_fmadd_pd(a1, bj, c14);
+            bj = _mm512_set1_pd(b[5]);
+            c05 = _mm512_fmadd_pd(a0, bj, c05);
+            c15 = _mm512_fmadd_pd(a1, bj, c15);
+        }
+        __m512d acc[2 * GEMM_NR] = { c00, c10, c01, c11, c02, c12, c03, c13, c04, c14, c05, c15 };
+        __m512d vb = _mm512_set1_pd(beta);
+        for (int j = 0; j < GEMM_NR; ++j, c += ldc) {
+            if (beta == 0) {
+                _mm512_storeu_pd(c, acc[2 * j]);
+                _mm512_storeu_pd(c + 8, acc[2 * j + 1]);
+            }
+            else {
+                _mm512_storeu_pd(c, _mm512_fmadd_pd(vb, _mm512_loadu_pd(c), acc[2 * j]));
+                _mm512_storeu_pd(c + 8, _mm512_fmadd_pd(vb, _mm512_loadu_pd(c + 8), acc[2 * j + 1]));
+            }
+        }
+    }
+
+    const Kernels AVX512 = { dot_avx512, sum_avx512, ssq_avx512, asum_avx512, axpy_avx512, scal_avx512, copy_avx512, set_avx512,
+        iext_avx512<0>, iext_avx512<1>, iext_avx512<2>, gemm_avx512, 16 };
+
+    SIMD::ISA detect() {
+#if defined(_MSC_VER) && !defined(__clang__)
+        int regs[4];
+        __cpuid(regs, 0);
+        int nids = regs[0];
+        __cpuid(regs, 1);
+        bool osxsave = (regs[2] & (1 << 27)) != 0, avx = (regs[2] & (1 << 28)) != 0, fma = (regs[2] & (1 << 12)) != 0;
+        if (!osxsave || !avx || nids < 7)
+            return SIMD::ISA::Scalar;
+        unsigned long long xcr0 = _xgetbv(0);
+        __cpuidex(regs, 7, 0);
+        bool avx2 = (regs[1] & (1 << 5)) != 0, avx512 = (regs[1] & (1 << 16)) != 0;
+        // the OS must save the ymm (and zmm) registers
+        if (avx512 && (xcr0 & 0xe6) == 0xe6)
+            return SIMD::ISA::AVX512;
+        if (avx2 && fma && (xcr0 & 0x6) == 0x6)
+            return SIMD::ISA::AVX2;
+        return SIMD::ISA::Scalar;
+#else
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f"))
+            return SIMD::ISA::AVX512;
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+            return SIMD::ISA::AVX2;
+        return SIMD::ISA::Scalar;
+#endif
+    }
+
+#else
+
+    SIMD::ISA detect() {
+        return SIMD::ISA::Scalar;
+    }
+
+#endif
+
+    const Kernels& kernels(SIMD::ISA isa) {
+#ifdef NUMCPP_X86
+        switch (isa) {
+        case SIMD::ISA::AVX512:
+            return AVX512;
+        case SIMD::ISA::AVX2:
+            return AVX2;
+        default:
+            break;
+        }
+#endif
+        return SCALAR;
+    }
+
+    struct Dispatch {
+        SIMD::ISA supported, current;
+        const Kernels* k;
+
+        Dispatch() : supported(detect()) {
+            current = supported;
+            k = &kernels(current);
+        }
+    };
+
+    // initialized once, on the first call
+    Dispatch& dispatch() {
+        static Dispatch d;
+        return d;
+    }
+
+    // packs op(A)(i0:i0+mc-1, p0:p0+kc-1) in micro-panels of mr rows (the last one padded with zeros)
+    void packA(bool tA, const double* A, int lda, int i0, int mc, int p0, int kc, int mr, double* buf) {
+        for (int ir = 0; ir < mc; ir += mr, buf += mr * kc) {
+            int nr = std::min(mr, mc - ir);
+            if (!tA) {
+                const double* a = A + i0 + ir + p0 * lda;
+                for (int p = 0; p < kc; ++p, a += lda) {
+                    double* dst = buf + p * mr;
+                    for (int i = 0; i < nr; ++i)
+                        dst[i] = a[i];
+                    for (int i = nr; i < mr; ++i)
+                        dst[i] = 0;
+                }
+            }
+            else {
+                for (int i = 0; i < nr; ++i) {
+                    const double* a = A + p0 + (i0 + ir + i) * lda;
+                    for (int p = 0; p < kc; ++p)
+                        buf[p * mr + i] = a[p];
+                }
+                for (int i = nr; i < mr; ++i) {
+                    for (int p = 0; p < kc; ++p)
+                        buf[p * mr + i] = 0;
+                }
+            }
+        }
+    }
+
+    // packs alpha * op(B)(p0:p0+kc-1, j0:j0+nc-1) in micro-panels of GEMM_NR columns
+    void packB(bool tB, const double* B, int ldb, int p0, int kc, int j0, int nc, double alpha, double* buf) {
+        for (int jr = 0; jr < nc; jr += GEMM_NR, buf += GEMM_NR * kc) {
+            int nr = std::min(GEMM_NR, nc - jr);
+            for (int j = 0; j < GEMM_NR; ++j) {
+                if (j >= nr) {
+                    for (int p = 0; p < kc; ++p)
+                        buf[p * GEMM_NR + j] = 0;
+                }
+                else if (!tB) {
+                    const double* b = B + p0 + (j0 + jr + j) * ldb;
+                    for (int p = 0; p < kc; ++p)
+                        buf[p * GEMM_NR + j] = alpha * b[p];
+                }
+                else {
+                    const double* b = B + j0 + jr + j + p0 * ldb;
+                    for (int p = 0; p < kc; ++p, b += ldb)
+                        buf[p * GEMM_NR + j] = alpha * *b;
+                }
+            }
+        }
+    }
+
+    void gemm_blocked(const Kernels& kr, bool tA, bool tB, int m, int n, int k, double alpha, const double* A, int lda,
+        const double* B, int ldb, double beta, double* C, int ldc) {
+        int mr = kr.mr;
+        int kcmax = std::min(k, GEMM_KC), mcmax = std::min(m, GEMM_MC), ncmax = std::min(n, GEMM_NC);
+        // one set of buffers per thread (GEMM may be called concurrently)
+        thread_local std::vector<double> abuf, bbuf;
+        size_t asize = (size_t)(mcmax + mr - 1) / mr * mr * kcmax, bsize = (size_t)(ncmax + GEMM_NR - 1) / GEMM_NR * GEMM_NR * kcmax;
+        if (abuf.size() < asize)
+            abuf.resize(asize);
+        if (bbuf.size() < bsize)
+            bbuf.resize(bsize);
+        double tmp[16 * GEMM_NR];
+        for (int jc = 0; jc < n; jc += GEMM_NC) {
+            int nc = std::min(GEMM_NC, n - jc);
+            for (int pc = 0; pc < k; pc += GEMM_KC) {
+                int kc = std::min(GEMM_KC, k - pc);
+                // beta is applied with the first block of op(A) * op(B)
+                double bc = pc == 0 ? beta : 1;
+                packB(tB, B, ldb, pc, kc, jc, nc, alpha, bbuf.data());
+                for (int ic = 0; ic < m; ic += GEMM_MC) {
+                    int mc = std::min(GEMM_MC, m - ic);
+                    packA(tA, A, lda, ic, mc, pc, kc, mr, abuf.data());
+                    for (int jr = 0; jr < nc; jr += GEMM_NR) {
+                        int nr = std::min(GEMM_NR, nc - jr);
+                        const double* b = bbuf.data() + jr * kc;
+                        for (int ir = 0; ir < mc; ir += mr) {
+                            int ni = std::min(mr, mc - ir);
+                            const double* a = abuf.data() + ir * kc;
+                            double* c = C + ic + ir + (jc + jr) * ldc;
+                            if (ni == mr && nr == GEMM_NR) {
+                                kr.gemm(kc, a, b, bc, c, ldc);
+                                continue;
+                            }
+                            // partial block
+                            kr.gemm(kc, a, b, 0, tmp, mr);
+                            for (int j = 0; j < nr; ++j) {
+                                for (int i = 0; i < ni; ++i)
+                                    c[i + j * ldc] = bc == 0 ? tmp[i + j * mr] : bc * c[i + j * ldc] + tmp[i + j * mr];
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+SIMD::ISA SIMD::isa() {
+    return dispatch().current;
+}
+
+SIMD::ISA SIMD::supported() {
+    return dispatch().supported;
+}
+
+SIMD::ISA SIMD::select(ISA isa) {
+    Dispatch& d = dispatch();
+    d.current = (int)isa <= (int)d.supported ? isa : d.supported;
+    d.k = &kernels(d.current);
+    return d.current;
+}
+
+double SIMD::dot(int n, const double* x, const double* y) {
+    return dispatch().k->dot(n, x, y);
+}
+
+double SIMD::sum(int n, const double* x) {
+    return dispatch().k->sum(n, x);
+}
+
+double SIMD::ssq(int n, const double* x) {
+    return dispatch().k->ssq(n, x);
+}
+
+double SIMD::asum(int n, const double* x) {
+    return dispatch().k->asum(n, x);
+}
+
+void SIMD::axpy(int n, double a, const double* x, double* y) {
+    dispatch().k->axpy(n, a, x, y);
+}
+
+void SIMD::scal(int n, double a, double* x) {
+    dispatch().k->scal(n, a, x);
+}
+
+void SIMD::copy(int n, const double* x, double* y) {
+    dispatch().k->copy(n, x, y);
+}
+
+void SIMD::set(int n, double a, double* x) {
+    dispatch().k->set(n, a, x);
+}
+
+int SIMD::iamax(int n, const double* x) {
+    return n <= 0 ? -1 : dispatch().k->iamax(n, x);
+}
+
+int SIMD::imax(int n, const double* x) {
+    return n <= 0 ? -1 : dispatch().k->imax(n, x);
+}
+
+int SIMD::imin(int n, const double* x) {
+    return n <= 0 ? -1 : dispatch().k->imin(n, x);
+}
+
+void SIMD::gemm(bool tA, bool tB, int m, int n, int k, double alpha, const double* A, int lda, const double* B, int ldb,
+    double beta, double* C, int ldc) {
+    if (m <= 0 || n <= 0)
+        return;
+    if (k <= 0 || alpha == 0) {
+        for (int j = 0; j < n; ++j) {
+            if (beta == 0)
+                SIMD::set(m, 0, C + j * ldc);
+            else
+                SIMD::scal(m, beta, C + j * ldc);
+        }
+        return;
+    }
+    gemm_blocked(*dispatch().k, tA, tB, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc);
+}
@@ -0,0 +1,86 @@
+#ifndef __numcpp_simd_h
+#define __numcpp_simd_h
+
+namespace NUMCPP {
+
+    /// <summary>
+    /// Unit-stride BLAS-1 kernels (and a matrix product) on doubles, with explicit AVX2 and AVX-512 code paths.
+    /// The instruction set is detected once (on the first call) and the corresponding kernels
+    /// are used afterwards. The reductions use several independent accumulators, so that their
+    /// results may differ from a sequential summation in the last bits.
+    /// </summary>
+    struct SIMD {
+
+        enum class ISA {
+            Scalar, AVX2, AVX512
+        };
+
+        /// <summary>
+        /// Instruction set currently in use
+        /// </summary>
+        static ISA isa();
+
+        /// <summary>
+        /// Best instruction set supported by the processor
+        /// </summary>
+        static ISA supported();
+
+        /// <summary>
+        /// Forces the instruction set (bounded by the supported one). Mainly for testing
+        /// </summary>
+        /// <returns>The instruction set actually selected</returns>
+        static ISA select(ISA isa);
+
+        static double dot(int n, const double* x, const double* y);
+
+        static double sum(int n, const double* x);
+
+        static double ssq(int n, const double* x);
+
+        static double asum(int n, const double* x);
+
+        /// <summary>
+        /// y += a * x
+        /// </summary>
+        static void axpy(int n, double a, const double* x, double* y);
+
+        /// <summary>
+        /// x *= a
+        /// </summary>
+        static void scal(int n, double a, double* x);
+
+        static void copy(int n, const double* x, double* y);
+
+        static void set(int n, double a, double* x);
+
+        /// <summary>
+        /// Index of the first largest |x(i)| (-1 if n == 0)
+        /// </summary>
+        static int iamax(int n, const double* x);
+
+        /// <summary>
+        /// Index of the first largest x(i) (-1 if n == 0)
+        /// </summary>
+        static int imax(int n, const double* x);
+
+        /// <summary>
+        /// Index of the first smallest x(i) (-1 if n == 0)
+        /// </summary>
+        static int imin(int n, const double* x);
+
+        /// <summary>
+        /// C = alpha * op(A) * op(B) + beta * C, with op(X) = X or X' (column major matrices, C is m x n).
+        /// Cache-blocked product on packed copies of op(A) and op(B), computed by register blocks.
+        /// C is not read when beta is 0
+        /// </summary>
+        static void gemm(bool tA, bool tB, int m, int n, int k, double alpha, const double* A, int lda, const double* B, int ldb,
+            double beta, double* C, int ldc);
+
+        /// <summary>
+        /// Below that length, the kernels are not worth the indirect call
+        /// </summary>
+        static const int MIN_LENGTH = 16;
+    };
+}
+
+#endif
@@ -0,0 +1,191 @@
+#ifndef __lcpp_stedc_h
+#define __lcpp_stedc_h
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <stdexcept>
+#include "matrix.h"
+#include "matrix_0.h"
+#include "parallel.h"
+#include "laenv.h"
+#include "steqr.h"
+#include "laed1.h"
+
+namespace LCPP {
+	/// <summary>
+	/// Computes all the eigenvalues and, optionally, the eigenvectors of a symmetric tridiagonal matrix
+	/// (diagonal d, n elements, off-diagonal e, n-1 elements) by the divide-and-conquer method.
+	/// On exit, d contains the eigenvalues in ascending order, e is destroyed and, if wantz, Z (n x n) contains
+	/// the orthonormal eigenvectors of the tridiagonal matrix.
+	/// The matrix is split in its unreduced blocks. Each block larger than LAENV(DCLeaf) is torn by rank one
+	/// modifications into a balanced tree of subproblems of at most LAENV(DCLeaf) rows, which are solved by STEQR;
+	/// the subproblems are then merged by pairs (LAED1), level by level, up to the root of the tree.
+	/// The leaves and the merges of a level are independent: they are distributed on the threads, the
+	/// remaining threads being used inside the merges (secular equations and GEMM). nthreads = 0 means default
+	/// concurrency. Without the eigenvectors, STEQR is used directly.
+	/// info() = 0 on success, or a positive value if the computation failed.
+	/// </summary>
+	/// <typeparam name="T"></typeparam>
+	template<typename T>
+	class STEDC {
+	public:
+
+		STEDC(int nthreads = 0) :m_nthreads(nthreads), m_info(0) {}
+
+		void operator()(bool wantz, NUMCPP::Sequence<T> d, NUMCPP::Sequence<T> e, NUMCPP::FastMatrix<T> Z);
+
+		int info() const {
+			return m_info;
+		}
+
+	private:
+
+		void divide(int smlsiz, NUMCPP::Sequence<T> d, NUMCPP::Sequence<T> e, NUMCPP::FastMatrix<T> Z);
+
+		int m_nthreads, m_info;
+	};
+
+	template<typename T>
+	void STEDC<T>::operator()(bool wantz, NUMCPP::Sequence<T> d, NUMCPP::Sequence<T> e, NUMCPP::FastMatrix<T> Z) {
+		int n = d.length();
+		if (e.length() < n - 1 || (wantz && (!Z.isSquare() || Z.getNrows() != n)))
+			throw std::invalid_argument("Invalid arguments in stedc");
+		m_info = 0;
+		if (n == 0)
+			return;
+		T zero = NUMCPP::CONSTANTS<T>::zero, one = NUMCPP::CONSTANTS<T>::one;
+		LAENV laenv;
+		int smlsiz = laenv(LAENV::DCLeaf, "STEDC", "", n, -1, -1, -1);
+		if (wantz) {
+			for (int j = 0; j < n; ++j) {
+				Z.column(j).set(zero);
+				Z(j, j) = one;
+			}
+		}
+		if (!wantz || n <= smlsiz) {
+			STEQR<T> steqr;
+			steqr(wantz, d, e, Z);
+			m_info = steqr.info();
+			return;
+		}
+		// scaling
+		T orgnrm = zero;
+		for (int i = 0; i < n; ++i)
+			orgnrm = std::max(orgnrm, std::abs(d(i)));
+		for (int i = 0; i < n - 1; ++i)
+			orgnrm = std::max(orgnrm, std::abs(e(i)));
+		if (orgnrm == zero)
+			return;
+		d.mul(one / orgnrm);
+		e.left(n - 1).mul(one / orgnrm);
+
+		T eps = std::numeric_limits<T>::epsilon();
+		int nblocks = 0;
+		for (int start = 0; start < n; ) {
+			// unreduced block start:end
+			int end = start;
+			while (end < n - 1) {
+				T tiny = eps * std::sqrt(std::abs(d(end))) * std::sqrt(std::abs(d(end + 1)));
+				if (std::abs(e(end)) <= tiny) {
+					e(end) = zero;
+					break;
+				}
+				++end;
+			}
+			int m = end - start + 1;
+			++nblocks;
+			if (m > smlsiz) {
+				divide(smlsiz, d.extract(start, m), e.extract(start, m - 1), Z.extract(start, m, start, m));
+			}
+			else if (m > 1) {
+				STEQR<T> steqr;
+				steqr(true, d.extract(start, m), e.extract(start, m - 1), Z.extract(start, m, start, m));
+				if (steqr.info() != 0)
+					m_info = start + 1;
+			}
+			if (m_info != 0)
+				return;
+			start = end + 1;
+		}
+		d.mul(orgnrm);
+
+		// sorts the eigenvalues of the different blocks
+		if (nblocks > 1) {
+			for (int ii = 1; ii < n; ++ii) {
+				int i = ii - 1, k = i;
+				T p = d(i);
+				for (int j = ii; j < n; ++j) {
+					if (d(j) < p) {
+						k = j;
+						p = d(j);
+					}
+				}
+				if (k != i) {
+					d(k) = d(i);
+					d(i) = p;
+					Z.column(i).swap(Z.column(k));
+				}
+			}
+		}
+	}
+
+	template<typename T>
+	void STEDC<T>::divide(int smlsiz, NUMCPP::Sequence<T> d, NUMCPP::Sequence<T> e, NUMCPP::FastMatrix<T> Z) {
+		int n = d.length();
+		int nthreads = m_nthreads > 0 ? m_nthreads : NUMCPP::Parallel::concurrency();
+		// sizes of the subproblems (leaves of a balanced binary tree)
+		std::vector<int> sizes(1, n);
+		while (*std::max_element(sizes.begin(), sizes.end()) > smlsiz) {
+			std::vector<int> next;
+			for (int s : sizes) {
+				next.push_back(s / 2);
+				next.push_back(s - s / 2);
+			}
+			sizes.swap(next);
+		}
+		std::vector<int> offsets(sizes.size());
+		for (size_t b = 1; b < sizes.size(); ++b)
+			offsets[b] = offsets[b - 1] + sizes[b - 1];
+		// rank one tearing
+		for (size_t b = 1; b < sizes.size(); ++b) {
+			int c = offsets[b];
+			T r = std::abs(e(c - 1));
+			d(c - 1) -= r;
+			d(c) -= r;
+		}
+		std::atomic<int> failed(0);
+		NUMCPP::Parallel::forEach((int)sizes.size(), [&](int b) {
+			int o = offsets[b], m = sizes[b];
+			STEQR<T> steqr;
+			steqr(true, d.extract(o, m), e.extract(o, m - 1), Z.extract(o, m, o, m));
+			if (steqr.info() != 0)
+				failed = 1;
+			}, nthreads);
+		// merges, level by level
+		while (sizes.size() > 1 && !failed) {
+			int npairs = (int)sizes.size() / 2;
+			int inner = std::max(1, nthreads / npairs);
+			NUMCPP::Parallel::forEach(npairs, [&](int p) {
+				int o = offsets[2 * p], n1 = sizes[2 * p], m = n1 + sizes[2 * p + 1];
+				LAED1<T> laed1;
+				laed1(d.extract(o, m), Z.extract(o, m, o, m), e(o + n1 - 1), n1, inner);
+				if (laed1.info() != 0)
+					failed = 1;
+				}, nthreads);
+			std::vector<int> nsizes(npairs), noffsets(npairs);
+			for (int p = 0; p < npairs; ++p) {
+				nsizes[p] = sizes[2 * p] + sizes[2 * p + 1];
+				noffsets[p] = offsets[2 * p];
+			}
+			sizes.swap(nsizes);
+			offsets.swap(noffsets);
+		}
+		if (failed)
+			m_info = 1;
+	}
+}
+
+#endif
@@ -0,0 +1,321 @@
+#ifndef __lcpp_steqr_h
+#define __lcpp_steqr_h
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <stdexcept>
+#include "matrix.h"
+#include "matrix_0.h"
+#include "laev2.h"
+#include "lartg.h"
+#include "lasr.h"
+
+namespace LCPP {
+	/// <summary>
+	/// Computes all the eigenvalues and, optionally, the eigenvectors of a symmetric tridiagonal matrix
+	/// (diagonal d, n elements, off-diagonal e, n-1 elements) by the implicit QL or QR method.
+	/// The method is chosen for each unreduced block, depending on which end of the block has the largest
+	/// diagonal element; the blocks are scaled when their norm is close to underflow or overflow.
+	/// On exit, d contains the eigenvalues in ascending order and e is destroyed.
+	/// If wantz, the rotations are applied to the columns of Z (m x n): Z = Z * Q. Z must be the identity
+	/// to get the eigenvectors of the tridiagonal matrix, or the orthogonal matrix used to reduce a
+	/// symmetric matrix to tridiagonal form (SYTRD/ORGTR) to get the eigenvectors of that matrix.
+	/// The rotations of the successive iterations on a block are not applied one sweep at a time: they are
+	/// accumulated (up to BATCH sequences) and applied together to Z by LASR, which keeps the active columns
+	/// of Z in cache across the sequences.
+	/// info() = 0 on success, or the number of off-diagonal elements that have not converged to zero
+	/// after 30 * n iterations.
+	/// </summary>
+	/// <typeparam name="T"></typeparam>
+	template<typename T>
+	class STEQR {
+	public:
+
+		STEQR() :m_info(0), m_ld(0), m_nseq(0), m_jmin(0), m_jmax(-1) {}
+
+		void operator()(bool wantz, NUMCPP::Sequence<T> d, NUMCPP::Sequence<T> e, NUMCPP::FastMatrix<T> Z);
+
+		int info() const {
+			return m_info;
+		}
+
+	private:
+
+		static const int BATCH = 16;
+
+		// the current sequence of rotations (c(j), s(j) for the columns j, j+1 of Z)
+		T* cseq() {
+			return m_c.data() + m_nseq * m_ld;
+		}
+		T* sseq() {
+			return m_s.data() + m_nseq * m_ld;
+		}
+		// closes the current sequence, which uses the rotations j0 to j1
+		void push(NUMCPP::FastMatrix<T> Z, int j0, int j1, bool forward);
+		// applies the pending sequences to Z
+		void flush(NUMCPP::FastMatrix<T> Z, bool forward);
+
+		int m_info, m_ld, m_nseq, m_jmin, m_jmax;
+		// BATCH sequences of n-1 rotations, identity when not used
+		std::vector<T> m_c, m_s;
+	};
+
+	template<typename T>
+	void STEQR<T>::push(NUMCPP::FastMatrix<T> Z, int j0, int j1, bool forward) {
+		m_jmin = std::min(m_jmin, j0);
+		m_jmax = std::max(m_jmax, j1);
+		if (++m_nseq == BATCH)
+			flush(Z, forward);
+	}
+
+	template<typename T>
+	void STEQR<T>::flush(NUMCPP::FastMatrix<T> Z, bool forward) {
+		if (m_nseq == 0)
+			return;
+		T zero = NUMCPP::CONSTANTS<T>::zero, one = NUMCPP::CONSTANTS<T>::one;
+		int j0 = m_jmin, nr = m_jmax - m_jmin + 1;
+		LASR<T> lasr;
+		lasr(Side::Right, forward ? Direction::Forward : Direction::Backward, Z.getNrows(), nr + 1, m_nseq,
+			m_c.data() + j0, m_s.data() + j0, m_ld, &Z(0, j0), Z.getColumnIncrement());
+		for (int l = 0; l < m_nseq; ++l) {
+			std::fill(m_c.begin() + l * m_ld + j0, m_c.begin() + l * m_ld + j0 + nr, one);
+			std::fill(m_s.begin() + l * m_ld + j0, m_s.begin() + l * m_ld + j0 + nr, zero);
+		}
+		m_nseq = 0;
+		m_jmin = m_ld;
+		m_jmax = -1;
+	}
+
+	template<typename T>
+	void STEQR<T>::operator()(bool wantz, NUMCPP::Sequence<T> d, NUMCPP::Sequence<T> e, NUMCPP::FastMatrix<T> Z) {
+		int n = d.length();
+		if (e.length() < n - 1 || (wantz && Z.getNcols() != n))
+			throw std::invalid_argument("Invalid arguments in steqr");
+		m_info = 0;
+		if (n <= 1)
+			return;
+		T zero = NUMCPP::CONSTANTS<T>::zero, one = NUMCPP::CONSTANTS<T>::one, two = NUMCPP::CONSTANTS<T>::two;
+		T eps = std::numeric_limits<T>::epsilon(), eps2 = eps * eps;
+		T safmin = NUMCPP::CONSTANTS<T>::safe_min, safmax = one / safmin;
+		T ssfmax = std::sqrt(safmax) / 3, ssfmin = std::sqrt(safmin) / eps2;
+		auto sign = [=](T x, T y) {return y >= zero ? std::abs(x) : -std::abs(x); };
+		LAEV2<T> laev2;
+		LARTG<T> lartg;
+		if (wantz) {
+			m_ld = n - 1;
+			m_c.assign(m_ld * BATCH, one);
+			m_s.assign(m_ld * BATCH, zero);
+			m_nseq = 0;
+			m_jmin = m_ld;
+			m_jmax = -1;
+		}
+
+		int nmaxit = n * 30, jtot = 0;
+		// l1 is the first row of the next block
+		int l1 = 0;
+		while (l1 < n) {
+			if (l1 > 0)
+				e(l1 - 1) = zero;
+			// looks for a small off-diagonal element
+			int m = l1;
+			for (; m < n - 1; ++m) {
+				T tst = std::abs(e(m));
+				if (tst == zero)
+					break;
+				if (tst <= std::sqrt(std::abs(d(m))) * std::sqrt(std::abs(d(m + 1))) * eps) {
+					e(m) = zero;
+					break;
+				}
+			}
+			int l = l1, lsv = l, lend = m, lendsv = lend;
+			l1 = m + 1;
+			if (lend == l)
+				continue;
+
+			// scales the submatrix in rows and columns l to lend
+			T anorm = zero;
+			for (int i = l; i <= lend; ++i)
+				anorm = std::max(anorm, std::abs(d(i)));
+			for (int i = l; i < lend; ++i)
+				anorm = std::max(anorm, std::abs(e(i)));
+			if (anorm == zero)
+				continue;
+			T factor = one;
+			if (anorm > ssfmax)
+				factor = ssfmax / anorm;
+			else if (anorm < ssfmin)
+				factor = ssfmin / anorm;
+			if (factor != one) {
+				d.extract(l, lend - l + 1).mul(factor);
+				e.extract(l, lend - l).mul(factor);
+			}
+
+			// chooses between QL and QR iteration
+			if (std::abs(d(lend)) < std::abs(d(l))) {
+				lend = lsv;
+				l = lendsv;
+			}
+			bool ql = lend > l;
+			if (ql) {
+				// QL iteration
+				while (l <= lend) {
+					// looks for a small subdiagonal element
+					int m = l;
+					for (; m < lend; ++m) {
+						T tst = std::abs(e(m));
+						if (tst * tst <= (eps2 * std::abs(d(m))) * std::abs(d(m + 1)) + safmin)
+							break;
+					}
+					if (m < lend)
+						e(m) = zero;
+					T p = d(l);
+					if (m == l) {
+						// eigenvalue found
+						d(l) = p;
+						++l;
+						continue;
+					}
+					if (m == l + 1) {
+						// 2 x 2 block
+						T rt1, rt2, c, s;
+						laev2(d(l), e(l), d(l + 1), rt1, rt2, c, s);
+						if (wantz) {
+							cseq()[l] = c;
+							sseq()[l] = s;
+							push(Z, l, l, false);
+						}
+						d(l) = rt1;
+						d(l + 1) = rt2;
+						e(l) = zero;
+						l += 2;
+						continue;
+					}
+					if (jtot == nmaxit)
+						break;
+					++jtot;
+					// shift
+					T g = (d(l + 1) - p) / (two * e(l));
+					T r = std::hypot(g, one);
+					g = d(m) - p + (e(l) / (g + sign(r, g)));
+					T s = one, c = one;
+					p = zero;
+					for (int i = m - 1; i >= l; --i) {
+						T f = s * e(i), b = c * e(i);
+						lartg(g, f, c, s, r);
+						if (i != m - 1)
+							e(i + 1) = r;
+						g = d(i + 1) - p;
+						r = (d(i) - g) * s + two * c * b;
+						p = s * r;
+						d(i + 1) = g + p;
+						g = c * r - b;
+						if (wantz) {
+							cseq()[i] = c;
+							sseq()[i] = -s;
+						}
+					}
+					if (wantz)
+						push(Z, l, m - 1, false);
+					d(l) = d(l) - p;
+					e(l) = g;
+				}
+			}
+			else {
+				// QR iteration
+				while (l >= lend) {
+					int m = l;
+					for (; m > lend; --m) {
+						T tst = std::abs(e(m - 1));
+						if (tst * tst <= (eps2 * std::abs(d(m))) * std::abs(d(m - 1)) + safmin)
+							break;
+					}
+					if (m > lend)
+						e(m - 1) = zero;
+					T p = d(l);
+					if (m == l) {
+						d(l) = p;
+						--l;
+						continue;
+					}
+					if (m == l - 1) {
+						T rt1, rt2, c, s;
+						laev2(d(l - 1), e(l - 1), d(l), rt1, rt2, c, s);
+						if (wantz) {
+							cseq()[m] = c;
+							sseq()[m] = s;
+							push(Z, m, m, true);
+						}
+						d(l - 1) = rt1;
+						d(l) = rt2;
+						e(l - 1) = zero;
+						l -= 2;
+						continue;
+					}
+					if (jtot == nmaxit)
+						break;
+					++jtot;
+					T g = (d(l - 1) - p) / (two * e(l - 1));
+					T r = std::hypot(g, one);
+					g = d(m) - p + (e(l - 1) / (g + sign(r, g)));
+					T s = one, c = one;
+					p = zero;
+					for (int i = m; i < l; ++i) {
+						T f = s * e(i), b = c * e(i);
+						lartg(g, f, c, s, r);
+						if (i != m)
+							e(i - 1) = r;
+						g = d(i) - p;
+						r = (d(i + 1) - g) * s + two * c * b;
+						p = s * r;
+						d(i) = g + p;
+						g = c * r - b;
+						if (wantz) {
+							cseq()[i] = c;
+							sseq()[i] = s;
+						}
+					}
+					if (wantz)
+						push(Z, m, l - 1, true);
+					d(l) = d(l) - p;
+					e(l - 1) = g;
+				}
+			}
+
+			if (wantz)
+				flush(Z, !ql);
+			// undoes the scaling
+			if (factor != one) {
+				d.extract(lsv, lendsv - lsv + 1).mul(one / factor);
+				e.extract(lsv, lendsv - lsv).mul(one / factor);
+			}
+			if (jtot == nmaxit) {
+				for (int i = 0; i < n - 1; ++i)
+					if (e(i) != zero)
+						++m_info;
+				return;
+			}
+		}
+
+		// sorts the eigenvalues (and the eigenvectors) in increasing order
+		for (int ii = 1; ii < n; ++ii) {
+			int i = ii - 1, k = i;
+			T p = d(i);
+			for (int j = ii; j < n; ++j) {
+				if (d(j) < p) {
+					k = j;
+					p = d(j);
+				}
+			}
+			if (k != i) {
+				d(k) = d(i);
+				d(i) = p;
+				if (wantz)
+					Z.column(i).swap(Z.column(k));
+			}
+		}
+	}
+}
+
+#endif
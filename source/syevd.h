@@ -0,0 +1,101 @@
+#ifndef __lcpp_syevd_h
+#define __lcpp_syevd_h
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include "matrix.h"
+#include "matrix_0.h"
+#include "sytrd.h"
+#include "stedc.h"
+#include "ormtr.h"
+
+namespace LCPP {
+	/// <summary>
+	/// Computes all the eigenvalues and, optionally, the eigenvectors of a real symmetric matrix A:
+	///     A = Z * diag(w) * Z'
+	/// Only the lower triangle of A is referenced. The eigenvalues are returned in w in ascending order and,
+	/// if wantz, A is overwritten by the orthonormal eigenvectors (otherwise A is destroyed).
+	/// A is reduced to tridiagonal form by SYTRD, the tridiagonal eigenproblem is solved by divide-and-conquer
+	/// (STEDC, on nthreads threads, 0 = default concurrency) and the eigenvectors are transformed back by ORMTR.
+	/// The matrix is scaled when its elements are close to underflow or overflow.
+	/// info() = 0 on success, or a positive value if the tridiagonal solver failed.
+	/// </summary>
+	/// <typeparam name="T"></typeparam>
+	template<typename T>
+	class SYEVD {
+	public:
+
+		SYEVD(int nthreads = 0) :m_nthreads(nthreads), m_info(0) {}
+
+		void operator()(bool wantz, NUMCPP::FastMatrix<T> A, NUMCPP::Sequence<T> w);
+		void operator()(bool wantz, NUMCPP::Matrix<T>& A, NUMCPP::Sequence<T> w) {
+			(*this)(wantz, A.all(), w);
+		}
+
+		int info() const {
+			return m_info;
+		}
+
+	private:
+
+		int m_nthreads, m_info;
+	};
+
+	template<typename T>
+	void SYEVD<T>::operator()(bool wantz, NUMCPP::FastMatrix<T> A, NUMCPP::Sequence<T> w) {
+		int n = A.getNrows();
+		if (!A.isSquare())
+			throw std::invalid_argument("Not square matrix in syevd");
+		if (w.length() < n)
+			throw std::invalid_argument("Invalid arguments in syevd");
+		m_info = 0;
+		if (n == 0)
+			return;
+		T zero = NUMCPP::CONSTANTS<T>::zero, one = NUMCPP::CONSTANTS<T>::one;
+		if (n == 1) {
+			w(0) = A(0, 0);
+			if (wantz)
+				A(0, 0) = one;
+			return;
+		}
+		// scaling
+		T smlnum = NUMCPP::CONSTANTS<T>::safe_min / std::numeric_limits<T>::epsilon();
+		T rmin = std::sqrt(smlnum), rmax = std::sqrt(one / smlnum);
+		T anrm = zero;
+		for (int c = 0; c < n; ++c)
+			for (int r = c; r < n; ++r)
+				anrm = std::max(anrm, std::abs(A(r, c)));
+		T sigma = one;
+		if (anrm > zero && anrm < rmin)
+			sigma = rmin / anrm;
+		else if (anrm > rmax)
+			sigma = rmax / anrm;
+		if (sigma != one) {
+			for (int c = 0; c < n; ++c)
+				A.column(c).drop(c, 0).mul(sigma);
+		}
+
+		NUMCPP::DataBlock<T> e(n - 1), tau(n - 1);
+		SYTRD<T> sytrd;
+		sytrd(A, w, e.all(), tau.all());
+		STEDC<T> stedc(m_nthreads);
+		if (!wantz) {
+			stedc(false, w.left(n), e.all(), A);
+		}
+		else {
+			NUMCPP::Matrix<T> Z(n, n);
+			stedc(true, w.left(n), e.all(), Z.all());
+			ORMTR<T> ormtr;
+			ormtr(Side::Left, false, A, tau.all(), Z.all());
+			for (int c = 0; c < n; ++c)
+				A.column(c).copy(Z.column(c));
+		}
+		m_info = stedc.info();
+		if (sigma != one)
+			w.left(n).mul(one / sigma);
+	}
+}
+
+#endif
@@ -0,0 +1,77 @@
+#ifndef __lcpp_symv_h
+#define __lcpp_symv_h
+
+#include <stdexcept>
+#include "matrix.h"
+#include "matrix_0.h"
+
+namespace LCPP {
+    /// <summary>
+    /// Computes y := alpha * A * x + beta * y, where A is an n by n symmetric matrix.
+    /// Only the uplo triangle of A is referenced. A is read once, column by column: each column
+    /// contributes to y by an axpy (its stored part) and by a dot product (the symmetric part).
+    /// </summary>
+    /// <typeparam name="T"></typeparam>
+    template <typename T>
+    class SYMV {
+    public:
+
+        SYMV() {}
+
+        void operator()(Triangular uplo, T alpha, NUMCPP::FastMatrix<T> A, NUMCPP::Sequence<T> x, T beta, NUMCPP::Sequence<T> y) {
+            int n = A.getNrows();
+            if (!A.isSquare() || x.length() != n || y.length() != n)
+                throw std::invalid_argument("invalid dimensions in SYMV");
+            apply(uplo, n, alpha, A.cptr(), A.getColumnIncrement(), x.cstart(), x.increment(), beta, y.start(), y.increment());
+        }
+
+        void operator()(Triangular uplo, int n, T alpha, const T* A, int lda, const T* x, int incx, T beta, T* y, int incy) {
+            apply(uplo, n, alpha, A, lda, x, incx, beta, y, incy);
+        }
+
+    private:
+
+        void apply(Triangular uplo, int n, T alpha, const T* A, int lda, const T* x, int incx, T beta, T* y, int incy);
+    };
+
+    template <typename T>
+    void SYMV<T>::apply(Triangular uplo, int n, T alpha, const T* A, int lda, const T* x, int incx, T beta, T* y, int incy) {
+        if (n == 0)
+            return;
+        T zero = NUMCPP::CONSTANTS<T>::zero, one = NUMCPP::CONSTANTS<T>::one;
+        if (beta == zero) {
+            for (int i = 0; i < n; ++i)
+                y[i * incy] = zero;
+        }
+        else if (beta != one) {
+            for (int i = 0; i < n; ++i)
+                y[i * incy] *= beta;
+        }
+        if (alpha == zero)
+            return;
+        const T* a = A;
+        if (uplo == Triangular::Lower) {
+            for (int j = 0; j < n; ++j, a += lda) {
+                T temp1 = alpha * x[j * incx], temp2 = zero;
+                y[j * incy] += temp1 * a[j];
+                for (int i = j + 1; i < n; ++i) {
+                    y[i * incy] += temp1 * a[i];
+                    temp2 += a[i] * x[i * incx];
+                }
+                y[j * incy] += alpha * temp2;
+            }
+        }
+        else {
+            for (int j = 0; j < n; ++j, a += lda) {
+                T temp1 = alpha * x[j * incx], temp2 = zero;
+                for (int i = 0; i < j; ++i) {
+                    y[i * incy] += temp1 * a[i];
+                    temp2 += a[i] * x[i * incx];
+                }
+                y[j * incy] += temp1 * a[j] + alpha * temp2;
+            }
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,125 @@
+#ifndef __lcpp_syr2k_h
+#define __lcpp_syr2k_h
+
+#include <stdexcept>
+#include "matrix.h"
+#include "matrix_0.h"
+#include "dot.h"
+#include "gemm.h"
+
+namespace LCPP {
+    /// <summary>
+    /// Performs one of the symmetric rank 2k operations
+    /// C := alpha * A * B' + alpha * B * A' + beta * C, or C := alpha * A' * B + alpha * B' * A + beta * C,
+    /// where C is an n by n symmetric matrix and A and B are n by k matrices in the first case
+    /// and k by n matrices in the second case.
+    /// Only the uplo triangle of C is referenced and updated.
+    /// The matrix is split recursively in diagonal blocks (SYR2K) and off-diagonal blocks (two GEMM).
+    /// </summary>
+    /// <typeparam name="T"></typeparam>
+    template <typename T>
+    class SYR2K {
+    public:
+
+        SYR2K() {}
+
+        void operator()(Triangular uplo, bool tA, T alpha, NUMCPP::FastMatrix<T> A, NUMCPP::FastMatrix<T> B, T beta, NUMCPP::FastMatrix<T> C);
+
+        void operator()(Triangular uplo, bool tA, int n, int k, T alpha, const T* A, int lda, const T* B, int ldb, T beta, T* C, int ldc) {
+            apply(uplo, tA, n, k, alpha, A, lda, B, ldb, beta, C, ldc);
+        }
+
+    private:
+
+        static const int BLOCKSIZE = 32;
+
+        void apply(Triangular uplo, bool tA, int n, int k, T alpha, const T* A, int lda, const T* B, int ldb, T beta, T* C, int ldc);
+        void apply_unblocked(Triangular uplo, bool tA, int n, int k, T alpha, const T* A, int lda, const T* B, int ldb, T beta, T* C, int ldc);
+    };
+
+    template <typename T>
+    void SYR2K<T>::operator()(Triangular uplo, bool tA, T alpha, NUMCPP::FastMatrix<T> A, NUMCPP::FastMatrix<T> B, T beta, NUMCPP::FastMatrix<T> C) {
+        if (!C.isSquare())
+            throw std::invalid_argument("invalid dimensions in SYR2K");
+        int n = C.getNrows();
+        int k = tA ? A.getNrows() : A.getNcols();
+        if ((tA ? A.getNcols() : A.getNrows()) != n || B.getNrows() != A.getNrows() || B.getNcols() != A.getNcols())
+            throw std::invalid_argument("invalid dimensions in SYR2K");
+        apply(uplo, tA, n, k, alpha, A.cptr(), A.getColumnIncrement(), B.cptr(), B.getColumnIncrement(), beta, C.ptr(), C.getColumnIncrement());
+    }
+
+    template <typename T>
+    void SYR2K<T>::apply(Triangular uplo, bool tA, int n, int k, T alpha, const T* A, int lda, const T* B, int ldb, T beta, T* C, int ldc) {
+        if (n == 0)
+            return;
+        if (n <= BLOCKSIZE) {
+            apply_unblocked(uplo, tA, n, k, alpha, A, lda, B, ldb, beta, C, ldc);
+            return;
+        }
+        int n1 = n / 2, n2 = n - n1;
+        // A1, B1 and A2, B2 are the parts of A, B corresponding to the first n1 and the last n2 rows/columns of C
+        const T* A1 = A;
+        const T* A2 = tA ? A + n1 * lda : A + n1;
+        const T* B1 = B;
+        const T* B2 = tA ? B + n1 * ldb : B + n1;
+        T one = NUMCPP::CONSTANTS<T>::one;
+        apply(uplo, tA, n1, k, alpha, A1, lda, B1, ldb, beta, C, ldc);
+        GEMM<T> gemm;
+        if (uplo == Triangular::Lower) {
+            // C21 = alpha * op(A2) * op(B1)' + alpha * op(B2) * op(A1)' + beta * C21
+            gemm(tA, !tA, n2, n1, k, alpha, A2, lda, B1, ldb, beta, C + n1, ldc);
+            gemm(tA, !tA, n2, n1, k, alpha, B2, ldb, A1, lda, one, C + n1, ldc);
+        }
+        else {
+            // C12 = alpha * op(A1) * op(B2)' + alpha * op(B1) * op(A2)' + beta * C12
+            gemm(tA, !tA, n1, n2, k, alpha, A1, lda, B2, ldb, beta, C + n1 * ldc, ldc);
+            gemm(tA, !tA, n1, n2, k, alpha, B1, ldb, A2, lda, one, C + n1 * ldc, ldc);
+        }
+        apply(uplo, tA, n2, k, alpha, A2, lda, B2, ldb, beta, C + n1 * (ldc + 1), ldc);
+    }
+
+    template <typename T>
+    void SYR2K<T>::apply_unblocked(Triangular uplo, bool tA, int n, int k, T alpha, const T* A, int lda, const T* B, int ldb, T beta, T* C, int ldc) {
+        T zero = NUMCPP::CONSTANTS<T>::zero, one = NUMCPP::CONSTANTS<T>::one;
+        bool lower = uplo == Triangular::Lower;
+        T* c = C;
+        for (int j = 0; j < n; ++j, c += ldc) {
+            // rows [i0, i1[ of the j-th column of C
+            int i0 = lower ? j : 0, i1 = lower ? n : j + 1;
+            if (beta == zero) {
+                for (int i = i0; i < i1; ++i)
+                    c[i] = zero;
+            }
+            else if (beta != one) {
+                for (int i = i0; i < i1; ++i)
+                    c[i] *= beta;
+            }
+            if (alpha == zero || k == 0)
+                continue;
+            if (!tA) {
+                // C(i0:i1, j) += alpha * (A(i0:i1, l) * B(j, l) + B(i0:i1, l) * A(j, l))
+                const T* a = A;
+                const T* b = B;
+                for (int l = 0; l < k; ++l, a += lda, b += ldb) {
+                    T temp1 = alpha * b[j], temp2 = alpha * a[j];
+                    if (temp1 != zero || temp2 != zero) {
+                        for (int i = i0; i < i1; ++i)
+                            c[i] += temp1 * a[i] + temp2 * b[i];
+                    }
+                }
+            }
+            else {
+                // C(i, j) += alpha * (A(:, i)' * B(:, j) + B(:, i)' * A(:, j))
+                DOT<T, T> dot;
+                const T* aj = A + j * lda;
+                const T* bj = B + j * ldb;
+                const T* ai = A + i0 * lda;
+                const T* bi = B + i0 * ldb;
+                for (int i = i0; i < i1; ++i, ai += lda, bi += ldb)
+                    c[i] += alpha * (dot(k, ai, bj) + dot(k, bi, aj));
+            }
+        }
+    }
+}
+
+#endif
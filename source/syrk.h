@@ -0,0 +1,117 @@
+#ifndef __lcpp_syrk_h
+#define __lcpp_syrk_h
+
+#include <stdexcept>
+#include "matrix.h"
+#include "matrix_0.h"
+#include "dot.h"
+#include "gemm.h"
+
+namespace LCPP {
+    /// <summary>
+    /// Performs one of the symmetric rank k operations
+    /// C := alpha * A * A' + beta * C, or C := alpha * A' * A + beta * C,
+    /// where C is an n by n symmetric matrix and A is an n by k matrix in the first case
+    /// and a k by n matrix in the second case.
+    /// Only the uplo triangle of C is referenced and updated.
+    /// The matrix is split recursively in diagonal blocks (SYRK) and off-diagonal blocks (GEMM).
+    /// </summary>
+    /// <typeparam name="T"></typeparam>
+    template <typename T>
+    class SYRK {
+    public:
+
+        SYRK() {}
+
+        void operator()(Triangular uplo, bool tA, T alpha, NUMCPP::FastMatrix<T> A, T beta, NUMCPP::FastMatrix<T> C);
+
+        void operator()(Triangular uplo, bool tA, int n, int k, T alpha, const T* A, int lda, T beta, T* C, int ldc) {
+            apply(uplo, tA, n, k, alpha, A, lda, beta, C, ldc);
+        }
+
+    private:
+
+        static const int BLOCKSIZE = 32;
+
+        void apply(Triangular uplo, bool tA, int n, int k, T alpha, const T* A, int lda, T beta, T* C, int ldc);
+        void apply_unblocked(Triangular uplo, bool tA, int n, int k, T alpha, const T* A, int lda, T beta, T* C, int ldc);
+    };
+
+    template <typename T>
+    void SYRK<T>::operator()(Triangular uplo, bool tA, T alpha, NUMCPP::FastMatrix<T> A, T beta, NUMCPP::FastMatrix<T> C) {
+        if (!C.isSquare())
+            throw std::invalid_argument("invalid dimensions in SYRK");
+        int n = C.getNrows();
+        int k = tA ? A.getNrows() : A.getNcols();
+        if ((tA ? A.getNcols() : A.getNrows()) != n)
+            throw std::invalid_argument("invalid dimensions in SYRK");
+        apply(uplo, tA, n, k, alpha, A.cptr(), A.getColumnIncrement(), beta, C.ptr(), C.getColumnIncrement());
+    }
+
+    template <typename T>
+    void SYRK<T>::apply(Triangular uplo, bool tA, int n, int k, T alpha, const T* A, int lda, T beta, T* C, int ldc) {
+        if (n == 0)
+            return;
+        if (n <= BLOCKSIZE) {
+            apply_unblocked(uplo, tA, n, k, alpha, A, lda, beta, C, ldc);
+            return;
+        }
+        int n1 = n / 2, n2 = n - n1;
+        // A1 and A2 are the parts of A corresponding to the first n1 and the last n2 rows/columns of C
+        const T* A1 = A;
+        const T* A2 = tA ? A + n1 * lda : A + n1;
+        apply(uplo, tA, n1, k, alpha, A1, lda, beta, C, ldc);
+        GEMM<T> gemm;
+        if (uplo == Triangular::Lower) {
+            // C21 = alpha * op(A2) * op(A1)' + beta * C21
+            gemm(tA, !tA, n2, n1, k, alpha, A2, lda, A1, lda, beta, C + n1, ldc);
+        }
+        else {
+            // C12 = alpha * op(A1) * op(A2)' + beta * C12
+            gemm(tA, !tA, n1, n2, k, alpha, A1, lda, A2, lda, beta, C + n1 * ldc, ldc);
+        }
+        apply(uplo, tA, n2, k, alpha, A2, lda, beta, C + n1 * (ldc + 1), ldc);
+    }
+
+    template <typename T>
+    void SYRK<T>::apply_unblocked(Triangular uplo, bool tA, int n, int k, T alpha, const T* A, int lda, T beta, T* C, int ldc) {
+        T zero = NUMCPP::CONSTANTS<T>::zero, one = NUMCPP::CONSTANTS<T>::one;
+        bool lower = uplo == Triangular::Lower;
+        T* c = C;
+        for (int j = 0; j < n; ++j, c += ldc) {
+            // rows [i0, i1[ of the j-th column of C
+            int i0 = lower ? j : 0, i1 = lower ? n : j + 1;
+            if (beta == zero) {
+                for (int i = i0; i < i1; ++i)
+                    c[i] = zero;
+            }
+            else if (beta != one) {
+                for (int i = i0; i < i1; ++i)
+                    c[i] *= beta;
+            }
+            if (alpha == zero || k == 0)
+                continue;
+            if (!tA) {
+                // C(i0:i1, j) += alpha * A(i0:i1, l) * A(j, l)
+                const T* a = A;
+                for (int l = 0; l < k; ++l, a += lda) {
+                    T temp = alpha * a[j];
+                    if (temp != zero) {
+                        for (int i = i0; i < i1; ++i)
+                            c[i] += temp * a[i];
+                    }
+                }
+            }
+            else {
+                // C(i, j) += alpha * A(:, i)' * A(:, j)
+                DOT<T, T> dot;
+                const T* aj = A + j * lda;
+                const T* ai = A + i0 * lda;
+                for (int i = i0; i < i1; ++i, ai += lda)
+                    c[i] += alpha * dot(k, ai, aj);
+            }
+        }
+    }
+}
+
+#endif
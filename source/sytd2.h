@@ -0,0 +1,83 @@
+#ifndef __lcpp_sytd2_h
+#define __lcpp_sytd2_h
+
+#include <algorithm>
+#include <vector>
+#include <stdexcept>
+#include "matrix.h"
+#include "matrix_0.h"
+#include "larfg.h"
+#include "symv.h"
+#include "syr2k.h"
+#include "dot.h"
+
+namespace LCPP {
+	/// <summary>
+	/// Reduces a real symmetric matrix A to symmetric tridiagonal form T by an orthogonal similarity
+	/// transformation: Q' * A * Q = T (unblocked algorithm). Only the lower triangle of A is referenced.
+	/// On exit, the diagonal and the first subdiagonal of A are overwritten with the diagonal d (n elements)
+	/// and the off-diagonal e (n-1 elements) of T, and the elements below the first subdiagonal, with tau
+	/// (n-1 elements), represent Q as a product of elementary reflectors
+	///     Q = H(0) H(1) . . . H(n-2)
+	/// where H(i) = I - tau(i) * v * v', v(0:i) = 0, v(i+1) = 1 and v(i+2:n-1) is stored in A(i+2:n-1, i).
+	/// Each step is a symmetric rank 2 update of the trailing matrix: A = A - v * w' - w * v', with
+	/// w = tau * A * v - (tau^2 / 2) * (v' * A * v) * v.
+	/// </summary>
+	/// <typeparam name="T"></typeparam>
+	template<typename T>
+	class SYTD2 {
+	public:
+
+		SYTD2() {}
+
+		void operator()(NUMCPP::FastMatrix<T> A, NUMCPP::Sequence<T> d, NUMCPP::Sequence<T> e, NUMCPP::Sequence<T> tau);
+
+	private:
+
+		std::vector<T> m_w;
+	};
+
+	template<typename T>
+	void SYTD2<T>::operator()(NUMCPP::FastMatrix<T> A, NUMCPP::Sequence<T> d, NUMCPP::Sequence<T> e, NUMCPP::Sequence<T> tau) {
+		int n = A.getNrows();
+		if (!A.isSquare())
+			throw std::invalid_argument("Not square matrix in sytd2");
+		if (d.length() < n || e.length() < n - 1 || tau.length() < n - 1)
+			throw std::invalid_argument("Invalid arguments in sytd2");
+		if (n == 0)
+			return;
+		T zero = NUMCPP::CONSTANTS<T>::zero, one = NUMCPP::CONSTANTS<T>::one, half = NUMCPP::CONSTANTS<T>::half;
+		int lda = A.getColumnIncrement();
+		LARFG<T> larfg;
+		SYMV<T> symv;
+		SYR2K<T> syr2k;
+		DOT<T, T> dot;
+		m_w.resize(n);
+		T* x = m_w.data();
+		for (int i = 0; i < n - 1; ++i) {
+			// H(i) annihilates A(i+2:n-1, i)
+			int m = n - i - 1;
+			T* v = &A(i + 1, i);
+			T taui = larfg(m, *v, &A(std::min(i + 2, n - 1), i), 1);
+			e(i) = *v;
+			if (taui != zero) {
+				*v = one;
+				// x = tau * A(i+1:n-1, i+1:n-1) * v
+				T* a22 = &A(i + 1, i + 1);
+				symv(Triangular::Lower, m, taui, a22, lda, v, 1, zero, x, 1);
+				// w = x - 1/2 * tau * (x' * v) * v
+				T alpha = -half * taui * dot(m, x, v);
+				for (int r = 0; r < m; ++r)
+					x[r] += alpha * v[r];
+				// A = A - v * w' - w * v'
+				syr2k(Triangular::Lower, false, m, 1, -one, v, m, x, m, one, a22, lda);
+				*v = e(i);
+			}
+			d(i) = A(i, i);
+			tau(i) = taui;
+		}
+		d(n - 1) = A(n - 1, n - 1);
+	}
+}
+
+#endif
@@ -0,0 +1,75 @@
+#ifndef __lcpp_sytrd_h
+#define __lcpp_sytrd_h
+
+#include <algorithm>
+#include <stdexcept>
+#include "matrix.h"
+#include "matrix_0.h"
+#include "laenv.h"
+#include "latrd.h"
+#include "syr2k.h"
+#include "sytd2.h"
+
+namespace LCPP {
+	/// <summary>
+	/// Reduces a real symmetric matrix A to symmetric tridiagonal form T by an orthogonal similarity
+	/// transformation: Q' * A * Q = T (blocked algorithm). Only the lower triangle of A is referenced.
+	/// The arguments and the output are the same as for SYTD2.
+	/// The columns are reduced by panels of nb (LAENV) columns: LATRD reduces the panel and computes W;
+	/// the trailing matrix is then updated by SYR2K (A = A - V * W' - W * V'), so that half of the
+	/// operations are done in level 3 BLAS. The other half (SYMV in LATRD) is level 2, as in SYTD2, which
+	/// bounds the gain (about 1.5 on large matrices). The last nx (LAENV crossover) columns are reduced by SYTD2.
+	/// </summary>
+	/// <typeparam name="T"></typeparam>
+	template<typename T>
+	class SYTRD {
+	public:
+
+		SYTRD() {}
+
+		void operator()(NUMCPP::FastMatrix<T> A, NUMCPP::Sequence<T> d, NUMCPP::Sequence<T> e, NUMCPP::Sequence<T> tau);
+		void operator()(NUMCPP::Matrix<T>& A, NUMCPP::Sequence<T> d, NUMCPP::Sequence<T> e, NUMCPP::Sequence<T> tau) {
+			(*this)(A.all(), d, e, tau);
+		}
+	};
+
+	template<typename T>
+	void SYTRD<T>::operator()(NUMCPP::FastMatrix<T> A, NUMCPP::Sequence<T> d, NUMCPP::Sequence<T> e, NUMCPP::Sequence<T> tau) {
+		int n = A.getNrows();
+		if (!A.isSquare())
+			throw std::invalid_argument("Not square matrix in sytrd");
+		if (d.length() < n || e.length() < n - 1 || tau.length() < n - 1)
+			throw std::invalid_argument("Invalid arguments in sytrd");
+		if (n == 0)
+			return;
+		T one = NUMCPP::CONSTANTS<T>::one;
+		LAENV laenv;
+		int nb = laenv(LAENV::Optimal, "SYTRD", "", n, -1, -1, -1);
+		int nx = std::max(nb, laenv(LAENV::CrossOver, "SYTRD", "", n, -1, -1, -1));
+		int i = 0;
+		if (nb < n && nx < n) {
+			NUMCPP::Matrix<T> Wm(n, nb);
+			int lda = A.getColumnIncrement(), ldw = Wm.getNrows();
+			T* a = A.ptr();
+			T* w = Wm.all().ptr();
+			LATRD<T> latrd;
+			SYR2K<T> syr2k;
+			for (; i < n - nx; i += nb) {
+				int ni = n - i;
+				latrd(nb, A.extract(i, ni, i, ni), e.extract(i, nb), tau.extract(i, nb), Wm.extract(0, ni, 0, nb));
+				// A(i+nb:n-1, i+nb:n-1) = A(i+nb:n-1, i+nb:n-1) - V * W' - W * V'
+				syr2k(Triangular::Lower, false, ni - nb, nb, -one, a + i + nb + i * lda, lda, w + nb, ldw, one, a + (i + nb) * (lda + 1), lda);
+				// restores the subdiagonal elements
+				for (int j = i; j < i + nb; ++j) {
+					A(j + 1, j) = e(j);
+					d(j) = A(j, j);
+				}
+			}
+		}
+		// remaining columns
+		SYTD2<T> sytd2;
+		sytd2(A.extract(i, n - i, i, n - i), d.drop(i, 0), e.drop(i, 0), tau.drop(i, 0));
+	}
+}
+
+#endif
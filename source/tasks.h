@@ -0,0 +1,172 @@
+#ifndef __numcpp_tasks_h
+#define __numcpp_tasks_h
+
+#include <functional>
+#include <vector>
+#include <map>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <algorithm>
+#include "parallel.h"
+
+namespace NUMCPP {
+
+	/// <summary>
+	/// Directed acyclic graph of tasks executed by a pool of threads.
+	/// The dependencies are derived from the data accessed by the tasks (read-after-write,
+	/// write-after-write and write-after-read hazards on opaque data handles), in the order
+	/// of insertion. A task becomes ready as soon as all its predecessors are completed;
+	/// among the ready tasks, the one with the longest (cost-weighted) path to the end of the
+	/// graph is executed first (critical path priority), so that the tasks of the next steps
+	/// of an algorithm are started as soon as possible (lookahead).
+	/// </summary>
+	class TaskGraph {
+	public:
+
+		TaskGraph() {}
+
+		/// <summary>
+		/// Adds a task. in: data read by the task; inout: data modified by the task.
+		/// Returns the identifier of the task
+		/// </summary>
+		int add(std::function<void()> fn, double cost, const std::vector<const void*>& in, const std::vector<const void*>& inout);
+
+		int size() const {
+			return (int)m_tasks.size();
+		}
+
+		/// <summary>
+		/// Executes all the tasks on nthreads threads (0 = default concurrency).
+		/// The first exception thrown by a task stops the scheduling of new tasks and is rethrown.
+		/// The graph is left empty
+		/// </summary>
+		void run(int nthreads = 0);
+
+	private:
+
+		struct Task {
+			std::function<void()> fn;
+			double cost, priority;
+			int npredecessors;
+			std::vector<int> successors;
+		};
+
+		struct Access {
+			int writer = -1;
+			std::vector<int> readers;
+		};
+
+		void link(int from, int to);
+
+		std::vector<Task> m_tasks;
+		std::map<const void*, Access> m_data;
+	};
+
+	inline void TaskGraph::link(int from, int to) {
+		if (from < 0 || from == to)
+			return;
+		std::vector<int>& s = m_tasks[from].successors;
+		if (std::find(s.begin(), s.end(), to) == s.end()) {
+			s.push_back(to);
+			++m_tasks[to].npredecessors;
+		}
+	}
+
+	inline int TaskGraph::add(std::function<void()> fn, double cost, const std::vector<const void*>& in, const std::vector<const void*>& inout) {
+		int id = (int)m_tasks.size();
+		m_tasks.push_back(Task{ fn, cost, 0, 0, {} });
+		for (const void* d : in) {
+			Access& access = m_data[d];
+			link(access.writer, id);
+			access.readers.push_back(id);
+		}
+		for (const void* d : inout) {
+			Access& access = m_data[d];
+			link(access.writer, id);
+			for (int r : access.readers)
+				link(r, id);
+			access.writer = id;
+			access.readers.clear();
+		}
+		return id;
+	}
+
+	inline void TaskGraph::run(int nthreads) {
+		int n = (int)m_tasks.size();
+		if (n == 0)
+			return;
+		// bottom levels (tasks are stored in a topological order)
+		for (int i = n - 1; i >= 0; --i) {
+			Task& t = m_tasks[i];
+			double p = 0;
+			for (int s : t.successors)
+				p = std::max(p, m_tasks[s].priority);
+			t.priority = p + t.cost;
+		}
+		auto cmp = [this](int l, int r) {
+			double pl = m_tasks[l].priority, pr = m_tasks[r].priority;
+			return pl < pr || (pl == pr && l > r);
+		};
+		std::priority_queue<int, std::vector<int>, decltype(cmp)> ready(cmp);
+		for (int i = 0; i < n; ++i)
+			if (m_tasks[i].npredecessors == 0)
+				ready.push(i);
+
+		std::mutex mutex;
+		std::condition_variable cv;
+		int completed = 0, running = 0;
+		bool stop = false;
+		std::exception_ptr error;
+
+		auto worker = [&]() {
+			std::unique_lock<std::mutex> lock(mutex);
+			while (true) {
+				cv.wait(lock, [&]() {return stop || !ready.empty() || completed == n || (running == 0 && ready.empty()); });
+				if (stop || completed == n || ready.empty())
+					break;
+				int id = ready.top();
+				ready.pop();
+				++running;
+				lock.unlock();
+				try {
+					m_tasks[id].fn();
+				}
+				catch (...) {
+					lock.lock();
+					if (!error)
+						error = std::current_exception();
+					stop = true;
+					--running;
+					cv.notify_all();
+					break;
+				}
+				lock.lock();
+				--running;
+				++completed;
+				for (int s : m_tasks[id].successors) {
+					if (--m_tasks[s].npredecessors == 0)
+						ready.push(s);
+				}
+				cv.notify_all();
+			}
+		};
+
+		if (nthreads <= 0)
+			nthreads = Parallel::concurrency();
+		std::vector<std::thread> threads;
+		for (int t = 1; t < nthreads; ++t)
+			threads.emplace_back(worker);
+		worker();
+		for (std::thread& t : threads)
+			t.join();
+		m_tasks.clear();
+		m_data.clear();
+		if (error)
+			std::rethrow_exception(error);
+	}
+}
+
+#endif
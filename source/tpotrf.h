@@ -0,0 +1,154 @@
+#ifndef __lcpp_tpotrf_h
+#define __lcpp_tpotrf_h
+
+#include <stdexcept>
+#include <atomic>
+#include "matrix.h"
+#include "matrix_0.h"
+#include "laenv.h"
+#include "tasks.h"
+#include "gemm.h"
+#include "syrk.h"
+#include "trsm.h"
+#include "potrf2.h"
+
+namespace LCPP {
+	/// <summary>
+	/// Computes the Cholesky factorization of a real symmetric positive definite matrix A.
+	/// The factorization has the form
+	/// A = U' * U or A = L * L', where U is an upper triangular matrix and L is lower triangular.
+	/// This is the tiled version of the algorithm: the matrix is divided in nb x nb tiles and the
+	/// tile kernels (POTRF2 on the diagonal tiles, TRSM on the panel tiles, SYRK and GEMM on the
+	/// trailing tiles) are executed as tasks by a dependency-driven scheduler (see TaskGraph).
+	/// The factorization of the diagonal tile k+1 can start as soon as its own updates are done,
+	/// before the end of the whole trailing update of step k.
+	/// The tiles are views on A (no copy). nb = 0 means the block size given by LAENV.
+	/// info() = 0 on success, or k > 0 if the leading minor of order k is not positive definite.
+	/// </summary>
+	/// <typeparam name="T"></typeparam>
+	template<typename T>
+	class TPOTRF {
+	public:
+
+		TPOTRF(int nb = 0, int nthreads = 0) :m_nb(nb), m_nthreads(nthreads), m_info(0) {}
+
+		void operator()(Triangular uplo, NUMCPP::FastMatrix<T> A);
+		void operator()(Triangular uplo, NUMCPP::Matrix<T>& A) {
+			(*this)(uplo, A.all());
+		}
+
+		int info() const {
+			return m_info;
+		}
+
+	private:
+
+		int m_nb, m_nthreads, m_info;
+
+	};
+
+	template<typename T>
+	void TPOTRF<T>::operator()(Triangular uplo, NUMCPP::FastMatrix<T> A) {
+		if (!A.isSquare())
+			throw std::invalid_argument("Not square matrix in Cholesky");
+		m_info = 0;
+		if (A.isEmpty())
+			return;
+		int n = A.getNrows();
+		int nb = m_nb;
+		if (nb <= 0) {
+			LAENV laenv;
+			nb = laenv(LAENV::Optimal, "POTRF", "", n, -1, -1, -1);
+		}
+		if (nb >= n) {
+			POTRF2<T> potrf2;
+			potrf2(uplo, A);
+			m_info = potrf2.info();
+			return;
+		}
+		int nt = (n + nb - 1) / nb;
+		int lda = A.getColumnIncrement();
+		T* a = A.ptr();
+		T one = NUMCPP::CONSTANTS<T>::one;
+		bool lower = uplo == Triangular::Lower;
+		// tiles are identified by their first element
+		auto tile = [=](int i, int j) {return a + i * nb + j * nb * lda; };
+		auto size = [=](int i) {return std::min(nb, n - i * nb); };
+		// position of the first failure (0 if none). Once set, the remaining tasks are skipped
+		std::atomic<int> info(0);
+		double c3 = (double)nb * nb * nb;
+
+		NUMCPP::TaskGraph graph;
+		for (int k = 0; k < nt; ++k) {
+			int kb = size(k);
+			T* akk = tile(k, k);
+			graph.add([=, &info]() {
+				if (info != 0)
+					return;
+				POTRF2<T> potrf2;
+				potrf2(uplo, A.extract(k * nb, kb, k * nb, kb));
+				if (potrf2.info() != 0)
+					info = potrf2.info() + k * nb;
+				}, c3 / 3, {}, { akk });
+			for (int i = k + 1; i < nt; ++i) {
+				int ib = size(i);
+				if (lower) {
+					// A(i,k) = A(i,k) * inv(L(k,k)')
+					graph.add([=, &info]() {
+						if (info != 0)
+							return;
+						TRSM<T> trsm;
+						trsm(Side::Right, Triangular::Lower, true, false, A.extract(k * nb, kb, k * nb, kb), one, A.extract(i * nb, ib, k * nb, kb));
+						}, c3, { akk }, { tile(i, k) });
+				}
+				else {
+					// A(k,i) = inv(U(k,k)') * A(k,i)
+					graph.add([=, &info]() {
+						if (info != 0)
+							return;
+						TRSM<T> trsm;
+						trsm(Side::Left, Triangular::Upper, true, false, A.extract(k * nb, kb, k * nb, kb), one, A.extract(k * nb, kb, i * nb, ib));
+						}, c3, { akk }, { tile(k, i) });
+				}
+			}
+			for (int i = k + 1; i < nt; ++i) {
+				int ib = size(i);
+				T* aik = lower ? tile(i, k) : tile(k, i);
+				// A(i,i) = A(i,i) - A(i,k) * A(i,k)'  (or A(k,i)' * A(k,i))
+				graph.add([=, &info]() {
+					if (info != 0)
+						return;
+					SYRK<T> syrk;
+					syrk(uplo, !lower, ib, kb, -one, aik, lda, one, tile(i, i), lda);
+					}, c3, { aik }, { tile(i, i) });
+				for (int j = k + 1; j < i; ++j) {
+					int jb = size(j);
+					T* ajk = lower ? tile(j, k) : tile(k, j);
+					if (lower) {
+						// A(i,j) = A(i,j) - A(i,k) * A(j,k)'
+						graph.add([=, &info]() {
+							if (info != 0)
+								return;
+							GEMM<T> gemm;
+							gemm(false, true, ib, jb, kb, -one, aik, lda, ajk, lda, one, tile(i, j), lda);
+							}, 2 * c3, { aik, ajk }, { tile(i, j) });
+					}
+					else {
+						// A(j,i) = A(j,i) - A(k,j)' * A(k,i)
+						graph.add([=, &info]() {
+							if (info != 0)
+								return;
+							GEMM<T> gemm;
+							gemm(true, false, jb, ib, kb, -one, ajk, lda, aik, lda, one, tile(j, i), lda);
+							}, 2 * c3, { aik, ajk }, { tile(j, i) });
+					}
+				}
+			}
+		}
+		graph.run(m_nthreads);
+		m_info = info;
+	}
+
+}
+
+#endif
@@ -0,0 +1,166 @@
+#ifndef __lcpp_trexc_h
+#define __lcpp_trexc_h
+
+#include "matrix.h"
+#include "laexc.h"
+
+namespace LCPP {
+	/// <summary>
+	/// Reorders the real Schur factorization of a real matrix A = Q * T * Q', so that the diagonal block of T
+	/// with row index ifst is moved to the row ilst (0-based), by a sequence of swaps of adjacent blocks (LAEXC).
+	/// If wantq, Q is updated (Q = Q * U). ifst and ilst are adjusted to the first row of their 2 x 2 block.
+	/// On exit, ilst points to the first row of the block in its final position.
+	/// info() = 1 if a swap was rejected (the blocks are too close): T and Q are then partially reordered
+	/// and ilst points to the current position of the block.
+	/// </summary>
+	/// <typeparam name="T"></typeparam>
+	template<typename T>
+	class TREXC {
+	public:
+
+		TREXC() :m_info(0) {}
+
+		void operator()(bool wantq, NUMCPP::FastMatrix<T> A, NUMCPP::FastMatrix<T> Q, int& ifst, int& ilst);
+
+		int info() const {
+			return m_info;
+		}
+
+	private:
+
+		int m_info;
+	};
+
+	template<typename T>
+	void TREXC<T>::operator()(bool wantq, NUMCPP::FastMatrix<T> A, NUMCPP::FastMatrix<T> Q, int& ifst, int& ilst) {
+		m_info = 0;
+		int n = A.getNrows();
+		if (n <= 1)
+			return;
+		T zero = NUMCPP::CONSTANTS<T>::zero;
+		LAEXC<T> laexc;
+		// first row of the block to move, and its size
+		if (ifst > 0 && A(ifst, ifst - 1) != zero)
+			--ifst;
+		int nbf = 1;
+		if (ifst < n - 1 && A(ifst + 1, ifst) != zero)
+			nbf = 2;
+		// first row of the final block, and its size
+		if (ilst > 0 && A(ilst, ilst - 1) != zero)
+			--ilst;
+		int nbl = 1;
+		if (ilst < n - 1 && A(ilst + 1, ilst) != zero)
+			nbl = 2;
+		if (ifst == ilst)
+			return;
+
+		// swap with the next block; nbf = 3 means that a 2 x 2 block has split in two 1 x 1 blocks
+		auto swap = [&](int j1, int n1, int n2) {
+			laexc(wantq, A, Q, j1, n1, n2);
+			m_info = laexc.info();
+			return m_info == 0;
+		};
+		int here = ifst;
+		if (ifst < ilst) {
+			// moves the block down
+			if (nbf == 2 && nbl == 1)
+				--ilst;
+			if (nbf == 1 && nbl == 2)
+				++ilst;
+			do {
+				if (nbf == 1 || nbf == 2) {
+					// the current block is 1 x 1 or 2 x 2
+					int nbnext = 1;
+					if (here + nbf + 1 < n && A(here + nbf + 1, here + nbf) != zero)
+						nbnext = 2;
+					if (!swap(here, nbf, nbnext)) {
+						ilst = here;
+						return;
+					}
+					here += nbnext;
+					// tests if the 2 x 2 block has split
+					if (nbf == 2 && A(here + 1, here) == zero)
+						nbf = 3;
+				}
+				else {
+					// the current block is made of two 1 x 1 blocks, which must be swapped individually
+					int nbnext = 1;
+					if (here + 3 < n && A(here + 3, here + 2) != zero)
+						nbnext = 2;
+					if (!swap(here + 1, 1, nbnext)) {
+						ilst = here;
+						return;
+					}
+					if (nbnext == 1) {
+						swap(here, 1, nbnext);
+						++here;
+					}
+					else {
+						// the next 2 x 2 block may have split
+						if (A(here + 2, here + 1) == zero)
+							nbnext = 1;
+						if (nbnext == 2) {
+							if (!swap(here, 1, nbnext)) {
+								ilst = here;
+								return;
+							}
+						}
+						else {
+							swap(here, 1, 1);
+							swap(here + 1, 1, 1);
+						}
+						here += 2;
+					}
+				}
+			} while (here < ilst);
+		}
+		else {
+			// moves the block up
+			do {
+				if (nbf == 1 || nbf == 2) {
+					int nbnext = 1;
+					if (here >= 2 && A(here - 1, here - 2) != zero)
+						nbnext = 2;
+					if (!swap(here - nbnext, nbnext, nbf)) {
+						ilst = here;
+						return;
+					}
+					here -= nbnext;
+					if (nbf == 2 && A(here + 1, here) == zero)
+						nbf = 3;
+				}
+				else {
+					int nbnext = 1;
+					if (here >= 2 && A(here - 1, here - 2) != zero)
+						nbnext = 2;
+					if (!swap(here - nbnext, nbnext, 1)) {
+						ilst = here;
+						return;
+					}
+					if (nbnext == 1) {
+						swap(here, nbnext, 1);
+						--here;
+					}
+					else {
+						if (A(here, here - 1) == zero)
+							nbnext = 1;
+						if (nbnext == 2) {
+							if (!swap(here - 1, 2, 1)) {
+								ilst = here;
+								return;
+							}
+						}
+						else {
+							swap(here, 1, 1);
+							swap(here - 1, 1, 1);
+						}
+						here -= 2;
+					}
+				}
+			} while (here > ilst);
+		}
+		ilst = here;
+	}
+}
+
+#endif
@@ -1,6 +1,7 @@
 #ifndef __lcpp_trmm_h
 #define __lcpp_trmm_h
 
+#include <stdexcept>
 #include "matrix.h"
 #include "matrix_0.h"
 
@@ -11,6 +12,7 @@ namespace LCPP {
     /// where  alpha  is a scalar, B  is an m by n matrix, A  is a unit, or
     /// non - unit, upper or lower triangular matrix and op(A)  is one  of
     /// op(A) = A or op(A) = A'.
+    /// When unitdiag is true, the diagonal of A is not referenced and assumed to be 1.
     /// </summary>
     /// <typeparam name="T"></typeparam>
     template <typename T>
@@ -19,11 +21,142 @@ namespace LCPP {
 
         TRMM() {}
         
-        void operator()(Side side, Triangular uplo, bool transa, bool diag, T alpha, NUMCPP::FastMatrix<T> A, NUMCPP::FastMatrix<T> B);
+        void operator()(Side side, Triangular uplo, bool transa, bool unitdiag, T alpha, NUMCPP::FastMatrix<T> A, NUMCPP::FastMatrix<T> B);
+
+    private:
+
+        void left(Triangular uplo, bool transa, bool unitdiag, T alpha, int m, int n, const T* a, int lda, T* b, int ldb);
+        void right(Triangular uplo, bool transa, bool unitdiag, T alpha, int m, int n, const T* a, int lda, T* b, int ldb);
     };
 
     template <typename T>
-    void TRMM<T>::operator()(Side side, Triangular uplo, bool transa, bool diag, T alpha, NUMCPP::FastMatrix<T> A, NUMCPP::FastMatrix<T> B){
+    void TRMM<T>::operator()(Side side, Triangular uplo, bool transa, bool unitdiag, T alpha, NUMCPP::FastMatrix<T> A, NUMCPP::FastMatrix<T> B){
+        if (B.isEmpty())
+            return;
+        int m = B.getNrows(), n = B.getNcols();
+        if (!A.isSquare() || A.getNrows() != (side == Side::Left ? m : n))
+            throw std::invalid_argument("Invalid matrix in trmm");
+        if (alpha == NUMCPP::CONSTANTS<T>::zero) {
+            B.set(NUMCPP::CONSTANTS<T>::zero);
+            return;
+        }
+        if (side == Side::Left)
+            left(uplo, transa, unitdiag, alpha, m, n, A.cptr(), A.getColumnIncrement(), B.ptr(), B.getColumnIncrement());
+        else
+            right(uplo, transa, unitdiag, alpha, m, n, A.cptr(), A.getColumnIncrement(), B.ptr(), B.getColumnIncrement());
+    }
+
+    template <typename T>
+    void TRMM<T>::left(Triangular uplo, bool transa, bool unitdiag, T alpha, int m, int n, const T* a, int lda, T* b, int ldb) {
+        T zero = NUMCPP::CONSTANTS<T>::zero;
+        for (int j = 0; j < n; ++j, b += ldb) {
+            if (!transa) {
+                // B(:,j) = alpha * A * B(:,j)
+                if (uplo == Triangular::Upper) {
+                    for (int k = 0; k < m; ++k) {
+                        if (b[k] == zero)
+                            continue;
+                        const T* ak = a + k * lda;
+                        T tmp = alpha * b[k];
+                        for (int i = 0; i < k; ++i)
+                            b[i] += tmp * ak[i];
+                        b[k] = unitdiag ? tmp : tmp * ak[k];
+                    }
+                }
+                else {
+                    for (int k = m - 1; k >= 0; --k) {
+                        if (b[k] == zero)
+                            continue;
+                        const T* ak = a + k * lda;
+                        T tmp = alpha * b[k];
+                        b[k] = unitdiag ? tmp : tmp * ak[k];
+                        for (int i = k + 1; i < m; ++i)
+                            b[i] += tmp * ak[i];
+                    }
+                }
+            }
+            else {
+                // B(:,j) = alpha * A' * B(:,j)
+                if (uplo == Triangular::Upper) {
+                    for (int i = m - 1; i >= 0; --i) {
+                        const T* ai = a + i * lda;
+                        T tmp = unitdiag ? b[i] : b[i] * ai[i];
+                        for (int k = 0; k < i; ++k)
+                            tmp += ai[k] * b[k];
+                        b[i] = alpha * tmp;
+                    }
+                }
+                else {
+                    for (int i = 0; i < m; ++i) {
+                        const T* ai = a + i * lda;
+                        T tmp = unitdiag ? b[i] : b[i] * ai[i];
+                        for (int k = i + 1; k < m; ++k)
+                            tmp += ai[k] * b[k];
+                        b[i] = alpha * tmp;
+                    }
+                }
+            }
+        }
+    }
+
+    template <typename T>
+    void TRMM<T>::right(Triangular uplo, bool transa, bool unitdiag, T alpha, int m, int n, const T* a, int lda, T* b, int ldb) {
+        T zero = NUMCPP::CONSTANTS<T>::zero, one = NUMCPP::CONSTANTS<T>::one;
+        // B(:,j) = s * B(:,j)
+        auto scale = [=](int j, T s) {
+            if (s == one)
+                return;
+            T* bj = b + j * ldb;
+            for (int i = 0; i < m; ++i)
+                bj[i] *= s;
+        };
+        // B(:,j) += s * B(:,k)
+        auto update = [=](int j, int k, T s) {
+            if (s == zero)
+                return;
+            T* bj = b + j * ldb;
+            const T* bk = b + k * ldb;
+            for (int i = 0; i < m; ++i)
+                bj[i] += s * bk[i];
+        };
+        if (!transa) {
+            // B = alpha * B * A
+            if (uplo == Triangular::Upper) {
+                for (int j = n - 1; j >= 0; --j) {
+                    const T* aj = a + j * lda;
+                    scale(j, unitdiag ? alpha : alpha * aj[j]);
+                    for (int k = 0; k < j; ++k)
+                        update(j, k, alpha * aj[k]);
+                }
+            }
+            else {
+                for (int j = 0; j < n; ++j) {
+                    const T* aj = a + j * lda;
+                    scale(j, unitdiag ? alpha : alpha * aj[j]);
+                    for (int k = j + 1; k < n; ++k)
+                        update(j, k, alpha * aj[k]);
+                }
+            }
+        }
+        else {
+            // B = alpha * B * A'
+            if (uplo == Triangular::Upper) {
+                for (int k = 0; k < n; ++k) {
+                    const T* ak = a + k * lda;
+                    for (int j = 0; j < k; ++j)
+                        update(j, k, alpha * ak[j]);
+                    scale(k, unitdiag ? alpha : alpha * ak[k]);
+                }
+            }
+            else {
+                for (int k = n - 1; k >= 0; --k) {
+                    const T* ak = a + k * lda;
+                    for (int j = k + 1; j < n; ++j)
+                        update(j, k, alpha * ak[j]);
+                    scale(k, unitdiag ? alpha : alpha * ak[k]);
+                }
+            }
+        }
     }
 }
 
@@ -1,8 +1,10 @@
 #ifndef __lcpp_trsm_h
 #define __lcpp_trsm_h
 
+#include <stdexcept>
 #include "matrix.h"
 #include "matrix_0.h"
+#include "gemm.h"
 
 namespace LCPP {
 
@@ -23,29 +25,74 @@ namespace LCPP {
 
     private:
 
+        static constexpr int BLOCKSIZE = 64;
+
+        // Left side, by blocks of rows of B: the diagonal blocks are solved by the unblocked code
+        // and the remaining rows are updated by GEMM
+        void apply_left(Triangular uplo, bool tA, bool unitdiag, NUMCPP::FastMatrix<T> A, NUMCPP::FastMatrix<T> B);
+
+        void apply_unblocked(Side side, Triangular uplo, bool tA, bool unitdiag, NUMCPP::FastMatrix<T> A, T alpha, NUMCPP::FastMatrix<T> B);
+
     };
 
     template<typename T>
     void TRSM<T>::operator() (Side side, Triangular uplo, bool tA, bool unitdiag, NUMCPP::FastMatrix<T> A, T alpha, NUMCPP::FastMatrix<T> B) {
         if (B.isEmpty())
             return;
-        if (alpha == NUMCPP::CONSTANTS<T>::zero) {
-            B.set(NUMCPP::CONSTANTS<T>::zero);
-            return;
-        }
         int m = B.getNrows(), n = B.getNcols();
         // 
         if (!A.isSquare())
-            throw std::exception("Invalid matrix in trsm");
+            throw std::invalid_argument("Invalid matrix in trsm");
         if (side == Side::Right) {
             if (A.getNrows() != n)
-                throw std::exception("Invalid matrix in trsm");
+                throw std::invalid_argument("Invalid matrix in trsm");
         }
         else {
             if (A.getNrows() != m)
-                throw std::exception("Invalid matrix in trsm");
+                throw std::invalid_argument("Invalid matrix in trsm");
+        }
+        if (alpha == NUMCPP::CONSTANTS<T>::zero) {
+            B.set(NUMCPP::CONSTANTS<T>::zero);
+            return;
         }
+        if (side == Side::Left && m > BLOCKSIZE) {
+            B.mul(alpha);
+            apply_left(uplo, tA, unitdiag, A, B);
+        }
+        else
+            apply_unblocked(side, uplo, tA, unitdiag, A, alpha, B);
+    }
 
+    template<typename T>
+    void TRSM<T>::apply_left(Triangular uplo, bool tA, bool unitdiag, NUMCPP::FastMatrix<T> A, NUMCPP::FastMatrix<T> B) {
+        int m = B.getNrows(), n = B.getNcols();
+        int lda = A.getColumnIncrement(), ldb = B.getColumnIncrement();
+        const T* a = A.cptr();
+        T* b = B.ptr();
+        T one = NUMCPP::CONSTANTS<T>::one;
+        GEMM<T> gemm;
+        // forward: the blocks are solved from the top (L * X = B or U' * X = B)
+        bool forward = (uplo == Triangular::Lower) != tA;
+        int nblocks = (m + BLOCKSIZE - 1) / BLOCKSIZE;
+        for (int ib = 0; ib < nblocks; ++ib) {
+            int k = forward ? ib * BLOCKSIZE : (nblocks - 1 - ib) * BLOCKSIZE;
+            int kb = std::min(BLOCKSIZE, m - k);
+            // rows of B already solved (before the current block when forward, after it otherwise)
+            int s0 = forward ? 0 : k + kb, ns = forward ? k : m - k - kb;
+            if (ns > 0) {
+                // B(k:k+kb, :) -= op(A)(k:k+kb, s0:s0+ns) * X(s0:s0+ns, :)
+                if (tA)
+                    gemm(true, false, kb, n, ns, -one, a + s0 + k * lda, lda, b + s0, ldb, one, b + k, ldb);
+                else
+                    gemm(false, false, kb, n, ns, -one, a + k + s0 * lda, lda, b + s0, ldb, one, b + k, ldb);
+            }
+            apply_unblocked(Side::Left, uplo, tA, unitdiag, A.extract(k, kb, k, kb), one, B.extract(k, kb, 0, n));
+        }
+    }
+
+    template<typename T>
+    void TRSM<T>::apply_unblocked(Side side, Triangular uplo, bool tA, bool unitdiag, NUMCPP::FastMatrix<T> A, T alpha, NUMCPP::FastMatrix<T> B) {
+        int m = B.getNrows(), n = B.getNcols();
         int lda = A.getColumnIncrement();
         const T* a = A.cptr();
         if (side == Side::Left) {
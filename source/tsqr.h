@@ -0,0 +1,215 @@
+#ifndef __lcpp_tsqr_h
+#define __lcpp_tsqr_h
+
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include "matrix.h"
+#include "matrix_0.h"
+#include "parallel.h"
+#include "geqrf.h"
+#include "ormqr.h"
+#include "larfg.h"
+#include "dot.h"
+#include "axpy.h"
+
+namespace LCPP {
+	/// <summary>
+	/// Tall-skinny QR factorization of a real m by n matrix A (m >> n): A = Q * R.
+	/// The rows of A are split in blocks of (about) mb rows, which are factorized in parallel by GEQRF
+	/// (one pass over the data); the n x n R factors of the blocks are then merged two by two
+	/// along a binary reduction tree: each node computes the QR factorization of two stacked triangles.
+	/// The merge exploits the structure (as LAPACK TPQRT): the reflector j only involves the row j of the top
+	/// triangle and the rows 0..j of the bottom one (n^3 / 3 flops instead of about 3 n^3 for GEQRF on the 2n x n matrix).
+	/// Everything is stored in A: the R factor of A (up to the signs of its rows) in the first n rows, the Householder
+	/// vectors of the leaves below the diagonals of the blocks (as for GEQRF) and those of a tree node in the upper
+	/// triangle of its bottom block. The object only keeps the tau's: A must be kept alive (and not modified)
+	/// as long as R or Q is used.
+	/// The result doesn't depend on the number of threads.
+	/// </summary>
+	/// <typeparam name="T"></typeparam>
+	template<typename T>
+	class TSQR {
+	public:
+
+		/// <summary>
+		/// mb: number of rows of the blocks (0 = automatic choice). nthreads = 0 means default concurrency
+		/// </summary>
+		TSQR(int mb = 0, int nthreads = 0)
+			:m_mb(mb), m_nthreads(nthreads), m_n(0), m_A(NUMCPP::Matrix<T>().all()) {}
+
+		void operator()(NUMCPP::FastMatrix<T> A);
+
+		/// <summary>
+		/// The n x n upper triangular factor R
+		/// </summary>
+		NUMCPP::Matrix<T> r() const;
+
+		/// <summary>
+		/// C = Q * C or C = Q' * C, where C has m rows.
+		/// After Q' * C, the first n rows of C correspond to the columns of R
+		/// </summary>
+		void applyQ(bool trans, NUMCPP::FastMatrix<T> C) const;
+
+		/// <summary>
+		/// The m x n matrix Q with orthonormal columns (A = Q * R)
+		/// </summary>
+		void q(NUMCPP::FastMatrix<T> Q) const;
+
+		int getBlocksCount() const {
+			return (int)m_start.size() - 1;
+		}
+
+	private:
+
+		// QR factorization of two stacked R factors, which are stored in the first n rows
+		// of the blocks top and bottom. The new R replaces the top one, the reflectors the bottom one
+		struct Node {
+			int top, bottom;
+			std::vector<T> tau;
+		};
+
+		// structured QR factorization of [R1; R2] (upper triangular n x n)
+		static void merge(NUMCPP::FastMatrix<T> R1, NUMCPP::FastMatrix<T> R2, T* tau);
+
+		// C = H' * C (trans) or C = H * C, H being a merge, C = [C1; C2] (n rows each)
+		static void applyMerge(bool trans, NUMCPP::FastMatrix<T> V, const T* tau, NUMCPP::FastMatrix<T> C1, NUMCPP::FastMatrix<T> C2);
+
+		int m_mb, m_nthreads, m_n;
+		// factorized matrix (leaves)
+		NUMCPP::FastMatrix<T> m_A;
+		// first row of each block (and m)
+		std::vector<int> m_start;
+		std::vector<std::vector<T>> m_tau;
+		// nodes of the reduction tree, level by level
+		std::vector<std::vector<Node>> m_levels;
+	};
+
+	template<typename T>
+	void TSQR<T>::operator()(NUMCPP::FastMatrix<T> A) {
+		int m = A.getNrows(), n = A.getNcols();
+		if (m < n)
+			throw std::invalid_argument("TSQR needs more rows than columns");
+		m_A = A;
+		m_n = n;
+		m_levels.clear();
+		int mb = m_mb > 0 ? std::max(m_mb, n) : std::max(4 * n, 2048);
+		int nblocks = std::max(1, m / mb);
+		m_start.resize(nblocks + 1);
+		for (int i = 0; i <= nblocks; ++i)
+			m_start[i] = (int)(((long long)m * i) / nblocks);
+		m_tau.assign(nblocks, std::vector<T>(n));
+		// leaves
+		NUMCPP::Parallel::forEach(nblocks, [&](int i) {
+			GEQRF<T> geqrf;
+			geqrf(A.extract(m_start[i], m_start[i + 1] - m_start[i], 0, n), NUMCPP::Sequence<T>(m_tau[i].data(), n));
+			}, m_nthreads);
+		// reduction tree: the R factor of a block stays in its first n rows
+		for (int step = 1; step < nblocks; step *= 2) {
+			std::vector<Node> level;
+			for (int i = 0; i + step < nblocks; i += 2 * step)
+				level.push_back(Node{ i, i + step, std::vector<T>(n) });
+			NUMCPP::Parallel::forEach((int)level.size(), [&](int l) {
+				Node& node = level[l];
+				merge(A.extract(m_start[node.top], n, 0, n), A.extract(m_start[node.bottom], n, 0, n), node.tau.data());
+				}, m_nthreads);
+			m_levels.push_back(std::move(level));
+		}
+	}
+
+	template<typename T>
+	void TSQR<T>::merge(NUMCPP::FastMatrix<T> R1, NUMCPP::FastMatrix<T> R2, T* tau) {
+		int n = R1.getNcols();
+		LARFG<T> larfg;
+		DOT<T, T> dot;
+		AXPY<T> axpy;
+		for (int j = 0; j < n; ++j) {
+			// H(j) annihilates R2(0:j, j) against R1(j, j)
+			T* v = &R2(0, j);
+			T t = tau[j] = larfg(j + 2, R1(j, j), v, 1);
+			if (t == NUMCPP::CONSTANTS<T>::zero)
+				continue;
+			for (int c = j + 1; c < n; ++c) {
+				T* r2 = &R2(0, c);
+				T w = t * (R1(j, c) + dot(j + 1, v, r2));
+				R1(j, c) -= w;
+				axpy(j + 1, -w, v, r2);
+			}
+		}
+	}
+
+	template<typename T>
+	void TSQR<T>::applyMerge(bool trans, NUMCPP::FastMatrix<T> V, const T* tau, NUMCPP::FastMatrix<T> C1, NUMCPP::FastMatrix<T> C2) {
+		int n = V.getNcols(), k = C1.getNcols();
+		DOT<T, T> dot;
+		AXPY<T> axpy;
+		for (int c = 0; c < k; ++c) {
+			T* c1 = &C1(0, c);
+			T* c2 = &C2(0, c);
+			// Q' = H(n-1) ... H(0)
+			for (int i = 0; i < n; ++i) {
+				int j = trans ? i : n - 1 - i;
+				if (tau[j] == NUMCPP::CONSTANTS<T>::zero)
+					continue;
+				const T* v = &V(0, j);
+				T w = tau[j] * (c1[j] + dot(j + 1, v, c2));
+				c1[j] -= w;
+				axpy(j + 1, -w, v, c2);
+			}
+		}
+	}
+
+	template<typename T>
+	NUMCPP::Matrix<T> TSQR<T>::r() const {
+		NUMCPP::FastMatrix<T> R = m_A.extract(0, m_n, 0, m_n);
+		return NUMCPP::Matrix<T>(m_n, m_n, [&](int r, int c) {return r <= c ? R(r, c) : NUMCPP::CONSTANTS<T>::zero; });
+	}
+
+	template<typename T>
+	void TSQR<T>::applyQ(bool trans, NUMCPP::FastMatrix<T> C) const {
+		int m = m_A.getNrows(), n = m_n, k = C.getNcols();
+		if (C.getNrows() != m)
+			throw std::invalid_argument("Invalid dimensions in TSQR");
+		if (k == 0)
+			return;
+		int nblocks = getBlocksCount();
+		auto leaves = [&]() {
+			NUMCPP::Parallel::forEach(nblocks, [&](int i) {
+				int nr = m_start[i + 1] - m_start[i];
+				ORMQR<T> ormqr;
+				ormqr(Side::Left, trans, m_A.extract(m_start[i], nr, 0, n), NUMCPP::Sequence<T>(const_cast<T*>(m_tau[i].data()), n),
+					C.extract(m_start[i], nr, 0, k));
+				}, m_nthreads);
+		};
+		auto level = [&](const std::vector<Node>& nodes) {
+			NUMCPP::Parallel::forEach((int)nodes.size(), [&](int l) {
+				const Node& node = nodes[l];
+				applyMerge(trans, m_A.extract(m_start[node.bottom], n, 0, n), node.tau.data(),
+					C.extract(m_start[node.top], n, 0, k), C.extract(m_start[node.bottom], n, 0, k));
+				}, m_nthreads);
+		};
+		if (trans) {
+			// Q' = (leaves, then the tree from the bottom)
+			leaves();
+			for (const std::vector<Node>& nodes : m_levels)
+				level(nodes);
+		}
+		else {
+			for (auto it = m_levels.rbegin(); it != m_levels.rend(); ++it)
+				level(*it);
+			leaves();
+		}
+	}
+
+	template<typename T>
+	void TSQR<T>::q(NUMCPP::FastMatrix<T> Q) const {
+		if (Q.getNrows() != m_A.getNrows() || Q.getNcols() != m_n)
+			throw std::invalid_argument("Invalid dimensions in TSQR");
+		Q.set(NUMCPP::CONSTANTS<T>::zero);
+		for (int i = 0; i < m_n; ++i)
+			Q(i, i) = NUMCPP::CONSTANTS<T>::one;
+		applyQ(false, Q);
+	}
+}
+
+#endif
@@ -1,8 +1,59 @@
+#include <cmath>
+#include <algorithm>
 #include "laenv.h"
 
 using namespace LCPP;
 typedef LAENV::SPEC ispec;
 
 int LAENV::operator()(ispec spec, const std::string& name, const std::string& opts, int n1, int n2, int n3, int n4) {
-	return 1;
+	switch (spec) {
+	case ispec::Optimal:
+		// block size
+		if (name == "GEQRF" || name == "ORGQR")
+			// small blocks: the panel (GEQR2) and the triangular factors (LARFT, TRMM) are Level 2 work
+			return n2 >= 1000 ? 32 : 16;
+		if (name == "ORMQR" || name == "GEHRD")
+			return 16;
+		if (name == "SYTRD")
+			return 32;
+		return 64;
+	case ispec::Minimum:
+		return 2;
+	case ispec::CrossOver:
+		// order below which the unblocked code is used
+		if (name == "GEHRD")
+			return 64;
+		return 128;
+	case ispec::DCLeaf:
+		return 25;
+	case ispec::QRMinimum:
+		// smallest matrix for the multishift QR (LAHQR is used below). LAQR0 is faster from about n = 110
+		return 110;
+	case ispec::QRNibble:
+		// percentage of deflations in the AED window below which a QR sweep is skipped
+		return 14;
+	case ispec::QRWindow:
+	case ispec::QRShifts: {
+		// number of simultaneous shifts (and size of the deflation window)
+		int nh = n3 - n2 + 1, ns = 2;
+		if (nh >= 30)
+			ns = 4;
+		if (nh >= 60)
+			ns = 10;
+		if (nh >= 150)
+			ns = std::max(10, nh / (int)std::lround(std::log((double)nh) / std::log(2.0)));
+		if (nh >= 590)
+			ns = 64;
+		if (nh >= 3000)
+			ns = 128;
+		if (nh >= 6000)
+			ns = 256;
+		ns = std::max(2, ns - ns % 2);
+		if (spec == ispec::QRShifts)
+			return ns;
+		return nh <= 500 ? ns : 3 * ns / 2;
+	}
+	default:
+		return 1;
+	}
 }
@@ -0,0 +1,171 @@
+#ifndef __lcpp_windowedls_h
+#define __lcpp_windowedls_h
+
+#include <vector>
+#include <stdexcept>
+#include "matrix.h"
+#include "matrix_0.h"
+#include "syrk.h"
+#include "potrf2.h"
+#include "chud.h"
+#include "chdd.h"
+
+namespace LCPP {
+    /// <summary>
+    /// Least squares estimation on a rolling window of observations (rolling-window regression).
+    /// The Cholesky factor L of X'X is maintained by an update (CHUD) for each new observation
+    /// and a downdate (CHDD) for the observation that leaves the window, in O(k^2) operations
+    /// (k = number of regression variables) instead of O(k^3) for a new factorization.
+    /// When a downdate fails (loss of positive definiteness through rounding), the factor is
+    /// recomputed from the observations of the window.
+    /// </summary>
+    /// <typeparam name="T"></typeparam>
+    template <typename T>
+    class WindowedLeastSquares {
+    public:
+
+        WindowedLeastSquares(int nvars, int window);
+
+        /// <summary>
+        /// Adds the observation (x, y). When the window is full, the oldest observation is removed.
+        /// Returns true if the current X'X is positive definite
+        /// </summary>
+        bool add(NUMCPP::Sequence<T> x, T y);
+
+        /// <summary>
+        /// Computes the least squares coefficients of the current window (solution of X'X b = X'y).
+        /// Returns false if X'X is not positive definite (b is unchanged)
+        /// </summary>
+        bool coefficients(NUMCPP::Sequence<T> b) const;
+
+        int nobs() const {
+            return m_nobs;
+        }
+
+        bool isPositiveDefinite() const {
+            return m_pd;
+        }
+
+        /// <summary>
+        /// Lower Cholesky factor of X'X (only valid when isPositiveDefinite())
+        /// </summary>
+        NUMCPP::FastMatrix<T> factor() const {
+            return m_L.all();
+        }
+
+    private:
+
+        bool checkDiagonal() const;
+
+        void refactor();
+
+        int m_nvars, m_window, m_nobs, m_pos;
+        bool m_pd;
+        // observations of the window (by columns, circular buffer)
+        NUMCPP::Matrix<T> m_X;
+        std::vector<T> m_y, m_xy;
+        NUMCPP::Matrix<T> m_L;
+        CHUD<T> m_chud;
+        CHDD<T> m_chdd;
+    };
+
+    template <typename T>
+    WindowedLeastSquares<T>::WindowedLeastSquares(int nvars, int window)
+        : m_nvars(nvars), m_window(window), m_nobs(0), m_pos(0), m_pd(false),
+        m_X(nvars, window), m_y(window), m_xy(nvars), m_L(nvars, nvars) {
+        if (nvars <= 0 || window < nvars)
+            throw std::invalid_argument("invalid dimensions in WindowedLeastSquares");
+        m_L = NUMCPP::CONSTANTS<T>::zero;
+    }
+
+    template <typename T>
+    bool WindowedLeastSquares<T>::add(NUMCPP::Sequence<T> x, T y) {
+        if (x.length() != m_nvars)
+            throw std::invalid_argument("invalid dimensions in WindowedLeastSquares");
+        NUMCPP::Sequence<T> xcur = m_X.column(m_pos);
+        NUMCPP::Sequence<T> xy(m_xy.data(), m_nvars);
+        bool full = m_nobs == m_window;
+        if (full) {
+            xy.addAY(-m_y[m_pos], xcur);
+        }
+        xy.addAY(y, x);
+        if (full) {
+            // the new observation is added before the old one is removed, so that
+            // the intermediate matrix stays positive definite
+            m_chud(Triangular::Lower, m_L.all(), x);
+            if (m_pd) {
+                m_chdd(Triangular::Lower, m_L.all(), xcur);
+                m_pd = m_chdd.info() == 0;
+            }
+            xcur.copy(x);
+            m_y[m_pos] = y;
+            if (!m_pd)
+                refactor();
+        }
+        else {
+            xcur.copy(x);
+            m_y[m_pos] = y;
+            ++m_nobs;
+            m_chud(Triangular::Lower, m_L.all(), x);
+            m_pd = checkDiagonal();
+        }
+        if (++m_pos == m_window)
+            m_pos = 0;
+        return m_pd;
+    }
+
+    template <typename T>
+    bool WindowedLeastSquares<T>::checkDiagonal() const {
+        T zero = NUMCPP::CONSTANTS<T>::zero;
+        for (int i = 0; i < m_nvars; ++i) {
+            if (!(m_L(i, i) > zero))
+                return false;
+        }
+        return true;
+    }
+
+    template <typename T>
+    void WindowedLeastSquares<T>::refactor() {
+        T zero = NUMCPP::CONSTANTS<T>::zero, one = NUMCPP::CONSTANTS<T>::one;
+        // X'X (the observations are stored by columns) and X'y
+        SYRK<T> syrk;
+        syrk(Triangular::Lower, false, one, m_X.all(), zero, m_L.all());
+        NUMCPP::Sequence<T> xy(m_xy.data(), m_nvars);
+        xy.set(zero);
+        for (int i = 0; i < m_nobs; ++i)
+            xy.addAY(m_y[i], m_X.column(i));
+        POTRF2<T> potrf2;
+        potrf2(Triangular::Lower, m_L.all());
+        m_pd = potrf2.info() == 0;
+    }
+
+    template <typename T>
+    bool WindowedLeastSquares<T>::coefficients(NUMCPP::Sequence<T> b) const {
+        if (!m_pd)
+            return false;
+        if (b.length() != m_nvars)
+            throw std::invalid_argument("invalid dimensions in WindowedLeastSquares");
+        std::vector<T> z(m_xy);
+        int n = m_nvars;
+        // L * z = X'y
+        for (int k = 0; k < n; ++k) {
+            NUMCPP::Sequence<T> lk = m_L.column(k);
+            T zk = z[k] / lk(k);
+            z[k] = zk;
+            for (int i = k + 1; i < n; ++i)
+                z[i] -= zk * lk(i);
+        }
+        // L' * b = z
+        for (int k = n - 1; k >= 0; --k) {
+            NUMCPP::Sequence<T> lk = m_L.column(k);
+            T s = z[k];
+            for (int i = k + 1; i < n; ++i)
+                s -= lk(i) * z[i];
+            z[k] = s / lk(k);
+        }
+        b.copy(NUMCPP::Sequence<T>(z.data(), n));
+        return true;
+    }
+}
+
+#endif